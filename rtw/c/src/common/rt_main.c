@@ -104,6 +104,50 @@ extern "C" {
 
 #include "ext_work.h"
 
+#ifdef RT_MATRIXLIB_MT
+#include "rt_matrixlib.h"
+/*
+ * Number of threads used by the matrix library for large operands. The
+ * model may supply it through rtmGetMatrixLibNumThreads; otherwise 0 selects
+ * the RT_MATRIXLIB_NUM_THREADS environment variable.
+ */
+# ifdef rtmGetMatrixLibNumThreads
+#  define RT_MATRIXLIB_THREADS rtmGetMatrixLibNumThreads(RT_MDL)
+# else
+#  define RT_MATRIXLIB_THREADS 0
+# endif
+#endif
+
+#ifdef RT_SNAPSHOT
+#include "rt_snapshot.h"
+/*
+ * Model state snapshots, see rt_snapshot.h. The snapshot holds
+ *
+ *   - the task times and task counters of the real-time model, and the
+ *     counters of the rt_sim.c timing engine if the model uses it,
+ *   - the continuous states and the solver history (ode<N>.c), if
+ *     NCSTATES > 0,
+ *   - the write cursors and buffers of the MAT-file log variables,
+ *   - the model data listed by RT_SNAPSHOT_MODEL_DATA, e.g., block states,
+ *     previous zero-crossing signals and tick counters. Which data carries
+ *     state depends on the blocks of the model:
+ *
+ *       -D"RT_SNAPSHOT_MODEL_DATA(X)=X(foo_DW) X(foo_PrevZCX)"
+ *
+ *   -snapshot_load file  - resume from a snapshot after initialization
+ *   -snapshot_save file  - save a snapshot when the simulation stops
+ */
+# if defined(rtmGetTimingData) && defined(USE_RTMODEL)
+#  include "rt_sim.h"
+# endif
+# if defined(NCSTATES) && NCSTATES > 0 && defined(rtmGetRTWSolverInfo)
+#  include "odesup.h"
+# endif
+# ifndef RT_SNAPSHOT_MODEL_DATA
+#  define RT_SNAPSHOT_MODEL_DATA(X) /* no model data */
+# endif
+#endif
+
 #ifdef MODEL_STEP_FCN_CONTROL_USED
 #error The static version of rt_main.c does not support model step function prototype control.
 #endif
@@ -143,6 +187,12 @@ static boolean_T OverrunFlags[NUMST];
 static boolean_T eventFlags[NUMST]; 
 #endif
 
+#ifdef RT_SNAPSHOT
+static rtSnapshot   rtSnap;
+static const char_T *snapshotLoadFile = NULL;
+static const char_T *snapshotSaveFile = NULL;
+#endif
+
 /*===================*
  * Visible functions *
  *===================*/
@@ -329,8 +379,145 @@ static void rt_InitModel(void)
      * Initialize the model *
      ************************/
     MODEL_INITIALIZE();
+
+#ifdef RT_MATRIXLIB_MT
+    (void)rt_MatrixLibThreadPoolInit(RT_MATRIXLIB_THREADS);
+#endif
+}
+
+#ifdef RT_SNAPSHOT
+
+/* Function: rt_ParseArgsForSnapshot ==========================================
+ * 
+ * Abstract: 
+ *   Handle the snapshot options and remove them from argv, so that the
+ *   remaining options can be parsed by external mode.
+ *
+ */
+static int_T rt_ParseArgsForSnapshot(int_T *argc, const char *argv[])
+{
+    int_T i, j;
+
+    for (i = 1, j = 1; i < *argc; i++) {
+        if (strcmp(argv[i], "-snapshot_load") == 0 && i+1 < *argc) {
+            snapshotLoadFile = argv[++i];
+        } else if (strcmp(argv[i], "-snapshot_save") == 0 && i+1 < *argc) {
+            snapshotSaveFile = argv[++i];
+        } else if (strcmp(argv[i], "-snapshot_load") == 0 ||
+                   strcmp(argv[i], "-snapshot_save") == 0) {
+            (void)printf("%s requires a file name\n", argv[i]);
+            return(0);
+        } else {
+            argv[j++] = argv[i];
+        }
+    }
+    *argc = j;
+    return(1);
 }
 
+/* Function: rt_SnapshotAddRegions ============================================
+ * 
+ * Abstract: 
+ *   Collect the snapshot regions of the model, see the list at the top of
+ *   this file.
+ *
+ */
+static const char_T *rt_SnapshotAddRegions(void)
+{
+    const char_T *errStatus = NULL;
+
+    rt_SnapshotInit(&rtSnap);
+
+#ifdef rtmGetTPtr
+    errStatus = rt_SnapshotAddRegion(&rtSnap, "TaskTimes", rtmGetTPtr(RT_MDL),
+                                     NUMST*sizeof(time_T));
+#endif
+#ifdef rtmTaskCounter
+    if (errStatus == NULL) {
+        errStatus = rt_SnapshotAddRegion(&rtSnap, "TaskCounters",
+                                         &rtmTaskCounter(RT_MDL, 0), NUMST*
+                                         sizeof(rtmTaskCounter(RT_MDL, 0)));
+    }
+#endif
+#if defined(rtmGetTimingData) && defined(USE_RTMODEL)
+    if (errStatus == NULL) {
+        errStatus = rt_SimSnapshotTimingEngine(rtmGetNumSampleTimes(RT_MDL),
+                                               rtmGetTimingData(RT_MDL),
+                                               &rtSnap);
+    }
+#endif
+#if defined(NCSTATES) && NCSTATES > 0 && defined(rtmGetRTWSolverInfo)
+    if (errStatus == NULL) {
+        RTWSolverInfo *si = rtmGetRTWSolverInfo(RT_MDL);
+
+        errStatus = rt_SnapshotAddRegion(&rtSnap, "ContStates",
+                                         rtsiGetContStates(si),
+                                         NCSTATES*sizeof(real_T));
+        if (errStatus == NULL) {
+            errStatus = rt_ODESnapshotIntegrationData(si, &rtSnap);
+        }
+    }
+#endif
+#define RT_SNAPSHOT_ADD_MODEL_DATA(data)                                \
+    if (errStatus == NULL) {                                            \
+        errStatus = rt_SnapshotAddRegion(&rtSnap, #data, &(data),       \
+                                         sizeof(data));                 \
+    }
+    RT_SNAPSHOT_MODEL_DATA(RT_SNAPSHOT_ADD_MODEL_DATA)
+#undef RT_SNAPSHOT_ADD_MODEL_DATA
+    if (errStatus == NULL) {
+        errStatus = rt_SnapshotDataLogging(rtmGetRTWLogInfo(RT_MDL), &rtSnap);
+    }
+    return(errStatus);
+}
+
+/* Function: rt_InitSnapshot ==================================================
+ * 
+ * Abstract: 
+ *   Restore the model state if a snapshot is to be loaded.
+ *
+ */
+static void rt_InitSnapshot(void)
+{
+    const char_T *errStatus;
+
+    if (snapshotLoadFile == NULL) return;
+
+    errStatus = rt_SnapshotAddRegions();
+    if (errStatus == NULL) {
+        errStatus = rt_SnapshotLoad(&rtSnap, snapshotLoadFile);
+    }
+    if (errStatus != NULL) {
+        rtmSetErrorStatus(RT_MDL, errStatus);
+    }
+}
+
+/* Function: rt_SaveSnapshot ==================================================
+ * 
+ * Abstract: 
+ *   Save the model state if the simulation stopped without an error. The
+ *   regions are collected again since log buffers may have moved.
+ *
+ */
+static void rt_SaveSnapshot(void)
+{
+    const char_T *errStatus = (const char_T *) (rtmGetErrorStatus(RT_MDL));
+
+    if (snapshotSaveFile == NULL) return;
+
+    if (errStatus == NULL || !strcmp(errStatus, "Simulation finished")) {
+        errStatus = rt_SnapshotAddRegions();
+        if (errStatus == NULL) {
+            errStatus = rt_SnapshotSave(&rtSnap, snapshotSaveFile);
+        }
+        if (errStatus != NULL) {
+            rtmSetErrorStatus(RT_MDL, errStatus);
+        }
+    }
+}
+
+#endif /* RT_SNAPSHOT */
+
 /* Function: rt_TermModel ====================================================
  * 
  * Abstract:
@@ -375,6 +562,10 @@ int_T main(int_T argc, const char *argv[])
 {
     int_T ret;
 
+#ifdef RT_SNAPSHOT
+    if (!rt_ParseArgsForSnapshot(&argc, argv)) return(1);
+#endif
+
     /* External mode */
     rtParseArgsForExtMode(argc, argv);
  
@@ -396,6 +587,10 @@ int_T main(int_T argc, const char *argv[])
      ************************/
     rt_InitModel();
 
+#ifdef RT_SNAPSHOT
+    rt_InitSnapshot();
+#endif
+
     /* External mode */
     rtSetTFinalForExtMode(&rtmGetTFinal(RT_MDL));
     rtExtModeCheckInit(NUMST);
@@ -432,6 +627,10 @@ int_T main(int_T argc, const char *argv[])
      * Cleanup and exit (optional) *
      *******************************/
 
+#ifdef RT_SNAPSHOT
+    rt_SaveSnapshot();
+#endif
+
 #ifdef UseMMIDataLogging
     rt_CleanUpForStateLogWithMMI(rtmGetRTWLogInfo(RT_MDL));
 #endif
@@ -439,6 +638,10 @@ int_T main(int_T argc, const char *argv[])
 
     ret = rt_TermModel();
 
+#ifdef RT_MATRIXLIB_MT
+    rt_MatrixLibThreadPoolTerminate();
+#endif
+
     rtExtModeShutdown(NUMST);
 
     return ret;
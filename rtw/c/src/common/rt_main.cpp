@@ -104,6 +104,20 @@ extern "C" {
 
 #include "ext_work.h"
 
+#ifdef RT_MATRIXLIB_MT
+#include "rt_matrixlib.h"
+/*
+ * Number of threads used by the matrix library for large operands. The
+ * model may supply it through rtmGetMatrixLibNumThreads; otherwise 0 selects
+ * the RT_MATRIXLIB_NUM_THREADS environment variable.
+ */
+# ifdef rtmGetMatrixLibNumThreads
+#  define RT_MATRIXLIB_THREADS rtmGetMatrixLibNumThreads(RT_MDL)
+# else
+#  define RT_MATRIXLIB_THREADS 0
+# endif
+#endif
+
 #ifdef MODEL_STEP_FCN_CONTROL_USED
 #error The static version of rt_main.c does not support model step function prototype control.
 #endif
@@ -329,6 +343,10 @@ static void rt_InitModel(void)
      * Initialize the model *
      ************************/
     MODEL_INITIALIZE();
+
+#ifdef RT_MATRIXLIB_MT
+    (void)rt_MatrixLibThreadPoolInit(RT_MATRIXLIB_THREADS);
+#endif
 }
 
 /* Function: rt_TermModel ====================================================
@@ -439,6 +457,10 @@ int_T main(int_T argc, const char *argv[])
 
     ret = rt_TermModel();
 
+#ifdef RT_MATRIXLIB_MT
+    rt_MatrixLibThreadPoolTerminate();
+#endif
+
     rtExtModeShutdown(NUMST);
 
     return ret;
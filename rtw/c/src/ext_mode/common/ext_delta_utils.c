@@ -0,0 +1,127 @@
+/*
+ * Copyright 2019 The MathWorks, Inc.
+ *
+ * File: ext_delta_utils.c
+ *
+ * Abstract:
+ *  Delta and run-length encoding of external mode upload data
+ *  (EXT_UPLOAD_ENCODING_DELTA_RLE).  The target encodes with ExtDeltaEncode
+ *  (updown.c includes this file); a host, or a program standing in for one,
+ *  defines EXT_DELTA_DECODER to also get ExtDeltaDecode.
+ *
+ *  The data of one system for one task (an UploadMap, nBytes) is treated as
+ *  nWords = EXT_DELTA_NUM_WORDS(nBytes) 32 bit words, the last one padded
+ *  with zeros.  Each word is XORed with the same word of the previous time
+ *  point that was uploaded for the system and task (the reference, all zeros
+ *  after the trigger is armed), and the result is coded as a sequence of
+ *  tokens, each starting with a control byte c:
+ *
+ *      c = 0x00..0x7F  c+1 words are unchanged (no data follows)
+ *      c = 0x80..0xFF  c-0x7F words changed; their 4 byte XOR values follow
+ *
+ *  Slowly changing signals thus cost one byte per 128 unchanged words, and
+ *  the encoded data is never longer than EXT_DELTA_MAX_ENCODED_SIZE(nWords).
+ *
+ *  XOR works byte by byte, so the decoder undoes it on the data as it is
+ *  laid out in target memory, regardless of the host's byte order; the
+ *  decoded bytes are then converted like EXT_UPLOAD_LOGGING_DATA.
+ */
+
+#include <string.h>
+
+#define EXT_DELTA_MAX_RUN              (128)
+#define EXT_DELTA_LITERAL_FLAG         (0x80)
+
+#define EXT_DELTA_NUM_WORDS(nBytes)    (((nBytes) + 3) / 4)
+#define EXT_DELTA_MAX_ENCODED_SIZE(nWords) \
+    (4*(nWords) + ((nWords) + EXT_DELTA_MAX_RUN-1) / EXT_DELTA_MAX_RUN)
+
+
+/* Function: ExtDeltaEncode ====================================================
+ * Abstract:
+ *  Encode nWords words of cur against the reference ref into dst, which must
+ *  hold EXT_DELTA_MAX_ENCODED_SIZE(nWords) bytes.  Return the number of bytes
+ *  written.  dst need not be aligned.
+ */
+PRIVATE int_T ExtDeltaEncode(const uint32_T *cur,
+                             const uint32_T *ref,
+                             int_T          nWords,
+                             char_T         *dst)
+{
+    char_T *out = dst;
+    int_T  i    = 0;
+
+    while (i < nWords) {
+        int_T n = 0;
+
+        if (cur[i] == ref[i]) {
+            /* run of unchanged words */
+            while ((i+n < nWords) && (n < EXT_DELTA_MAX_RUN) &&
+                   (cur[i+n] == ref[i+n])) {
+                n++;
+            }
+            *out++ = (char_T)(n-1);
+        } else {
+            /* changed words */
+            char_T *ctrl = out++;
+
+            while ((i+n < nWords) && (n < EXT_DELTA_MAX_RUN) &&
+                   (cur[i+n] != ref[i+n])) {
+                uint32_T delta = cur[i+n] ^ ref[i+n];
+
+                (void)memcpy(out, &delta, sizeof(uint32_T));
+                out += sizeof(uint32_T);
+                n++;
+            }
+            *ctrl = (char_T)(EXT_DELTA_LITERAL_FLAG | (n-1));
+        }
+        i += n;
+    }
+    return((int_T)(out - dst));
+} /* end ExtDeltaEncode */
+
+
+#ifdef EXT_DELTA_DECODER
+/* Function: ExtDeltaDecode ====================================================
+ * Abstract:
+ *  Decode the encoded data of one system at src (at most nSrcBytes bytes)
+ *  into ref, the 4*nWords bytes of the previous time point, which then hold
+ *  the new time point.  Return the number of bytes of src used, so that the
+ *  caller can move on to the next system index, or -1 if the data is
+ *  malformed.
+ */
+PRIVATE int_T ExtDeltaDecode(const char_T *src,
+                             int_T        nSrcBytes,
+                             uint8_T      *ref,
+                             int_T        nWords)
+{
+    const uint8_T *in    = (const uint8_T *)src;
+    const uint8_T *inEnd = in + nSrcBytes;
+    uint8_T       *end   = ref + 4*nWords;
+
+    while (ref < end) {
+        int_T c;
+        int_T nBytes;
+
+        if (in == inEnd) return(-1);
+        c = *in++;
+
+        nBytes = 4*((c & (EXT_DELTA_LITERAL_FLAG-1)) + 1);
+        if (nBytes > (int_T)(end - ref)) return(-1);
+
+        if (c & EXT_DELTA_LITERAL_FLAG) {
+            int_T j;
+
+            if (nBytes > (int_T)(inEnd - in)) return(-1);
+            for (j=0; j<nBytes; j++) {
+                ref[j] ^= in[j];
+            }
+            in += nBytes;
+        }
+        ref += nBytes;
+    }
+    return((int_T)(in - (const uint8_T *)src));
+} /* end ExtDeltaDecode */
+#endif /* ifdef EXT_DELTA_DECODER */
+
+/* [EOF] ext_delta_utils.c */
@@ -85,6 +85,25 @@ typedef enum {
      */
     EXT_DAEMON_ACK,
 
+    /*
+     * Upload encoding negotiation.  The host may send EXT_SET_UPLOAD_ENCODING
+     * (payload: int32 upInfoIdx, int32 ExtUploadEncoding) before
+     * EXT_SELECT_SIGNALS; the target answers with
+     * EXT_SET_UPLOAD_ENCODING_RESPONSE [encoding upInfoIdx] carrying the
+     * encoding it will use, which is EXT_UPLOAD_ENCODING_RAW if it does not
+     * support the one requested, or EXT_UPLOAD_ENCODING_ERROR if the packet
+     * could not be processed.  Targets that predate these packets never
+     * send EXT_UPLOAD_LOGGING_DATA_DELTA.
+     */
+    EXT_SET_UPLOAD_ENCODING,
+    EXT_SET_UPLOAD_ENCODING_RESPONSE,
+
+    /*
+     * Logging data encoded against the previous time point of the same
+     * task (see ext_delta_utils.c).
+     */
+    EXT_UPLOAD_LOGGING_DATA_DELTA,
+
     EXTENDED = 255          /* reserved for extending beyond 254 ID's */
 } ExtModeAction;
 
@@ -94,6 +113,12 @@ typedef enum {
   NOT_ENOUGH_MEMORY
 } ResponseStatus;
 
+typedef enum {
+  EXT_UPLOAD_ENCODING_ERROR = -1, /* response only: request rejected */
+  EXT_UPLOAD_ENCODING_RAW,
+  EXT_UPLOAD_ENCODING_DELTA_RLE
+} ExtUploadEncoding;
+
 typedef enum {
   LittleEndian,
   BigEndian
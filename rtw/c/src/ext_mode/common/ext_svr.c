@@ -70,6 +70,14 @@
 #  endif
 #endif
 
+/*
+ * Maximum number of upload buffers (sample times) whose sections are sent with
+ * one transport call by UploadServerWork.
+ */
+#ifndef UPLOAD_SENDV_MAX_BUFS
+#define UPLOAD_SENDV_MAX_BUFS          (8)
+#endif
+
 /**********************
  * External Variables *
  **********************/
@@ -667,6 +675,47 @@ EXIT_POINT:
 } /* end SendPktDataToHost */
 
 
+/* Function: SendPktDataVToHost ================================================
+ * Abstract:
+ *  Send the iovCnt pieces of packet data in iov to the host.  The pieces may
+ *  include the packet header.  With EXTMODE_HAS_SETHOSTPKTV they are sent
+ *  with a single transport call (ExtSetHostPktV), otherwise with one
+ *  ExtSetHostPkt call per piece.
+ */
+PRIVATE boolean_T SendPktDataVToHost(const ExtIOVec *iov, const int iovCnt)
+{
+    int_T     i;
+    boolean_T error = EXT_NO_ERROR;
+#ifdef EXTMODE_HAS_SETHOSTPKTV
+    int_T     nSet;
+    int_T     size  = 0;
+
+    for (i=0; i<iovCnt; i++) {
+        size += iov[i].nBytes;
+    }
+
+    error = ExtSetHostPktV(extUD,iov,iovCnt,&nSet);
+    if (error || (nSet != size)) {
+        error = EXT_ERROR;
+#ifndef EXTMODE_DISABLEPRINTF            
+        fprintf(stderr,"ExtSetHostPktV() failed.\n");
+#endif
+        goto EXIT_POINT;
+    }
+#else
+    for (i=0; i<iovCnt; i++) {
+        if (iov[i].nBytes == 0) continue;
+
+        error = SendPktDataToHost(iov[i].base, iov[i].nBytes);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+    }
+#endif
+
+EXIT_POINT:
+    return(error);
+} /* end SendPktDataVToHost */
+
+
 /* Function: SendPktToHost =====================================================
  * Abstract:
  *  Send a packet to the host.  Packets can be of two forms:
@@ -674,26 +723,38 @@ EXIT_POINT:
  *          the type is used as a flag to notify Simulink of an event
  *          that has taken place on the target (event == action == type)
  *      o pkt header, followed by data
+ *
+ *  The header and data are sent with one transport call.
  */
 PUBLIC boolean_T SendPktToHost(
     const ExtModeAction action,
     const int           size,  /* # of bytes to follow pkt header */
     const char          *data)
 {
+    PktHeader pktHdr;
+    ExtIOVec  iov[2];
     boolean_T error = EXT_NO_ERROR;
     
 #ifdef VXWORKS
     semTake(pktSem, WAIT_FOREVER);
 #endif
 
-    error = SendPktHdrToHost(action,size);
-    if (error != EXT_NO_ERROR) goto EXIT_POINT;
-
     if (data != NULL) {
-        error = SendPktDataToHost(data, size);
+        pktHdr.type = (uint32_T)action;
+        pktHdr.size = size;
+
+        iov[0].base   = (const char *)&pktHdr;
+        iov[0].nBytes = (int)sizeof(pktHdr);
+        iov[1].base   = data;
+        iov[1].nBytes = size;
+
+        error = SendPktDataVToHost(iov, 2);
         if (error != EXT_NO_ERROR) goto EXIT_POINT;
     } else {
         assert(size == 0);
+
+        error = SendPktHdrToHost(action,size);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
     }
 
 EXIT_POINT:
@@ -725,7 +786,18 @@ PRIVATE boolean_T SendResponseStatus(const ExtModeAction  response,
 
 #ifndef EXTMODE_DISABLEPARAMETERTUNING
 /* Function: ProcessSetParamPkt ================================================
- * Receive and process the EXT_SETPARAM packet.
+ * Receive and process the EXT_SETPARAM packet.  With
+ * EXTMODE_STEP_ATOMIC_PARAMS the parameters are only staged here; the model
+ * installs them before its next step (rt_CommitStagedParams).
+ *
+ * The STATUS_OK response then means that the packet was queued, not that
+ * the new values are in use: they take effect at the end of the current base
+ * rate step, or at the next poll while the model waits to start or is
+ * paused.  Until then EXT_GETPARAMS still returns the old values.  A full
+ * queue is reported as NOT_ENOUGH_MEMORY.  The response is not deferred
+ * until the commit: with EXTMODE_SERVER_THREAD the commit runs in the model
+ * thread, which never blocks on the host (see ext_work.c), and the packet
+ * server must not wait for a model that may be paused.
  */
 PRIVATE boolean_T ProcessSetParamPkt(RTWExtModeInfo *ei,
                                      const int pktSize)
@@ -750,7 +822,16 @@ PRIVATE boolean_T ProcessSetParamPkt(RTWExtModeInfo *ei,
         error = EXT_ERROR; 
         goto EXIT_POINT;
     }
+#ifdef EXTMODE_STEP_ATOMIC_PARAMS
+    if (StageSetParam(ei, pkt, pktSize) != EXT_NO_ERROR) {
+        msg = (int32_T)NOT_ENOUGH_MEMORY;
+        SendPktToHost(EXT_SETPARAM_RESPONSE,sizeof(int32_T),(char_T *)&msg);
+        error = EXT_ERROR; 
+        goto EXIT_POINT;
+    }
+#else
     SetParam(ei, pkt);
+#endif
 
     msg = (int32_T)STATUS_OK;
     error = SendPktToHost(EXT_SETPARAM_RESPONSE,sizeof(int32_T),(char_T *)&msg);
@@ -944,6 +1025,66 @@ PRIVATE boolean_T ProcessCancelLoggingArmTriggerPkt(const ExtModeAction ACTION_I
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 
+/* Function: ProcessSetUploadEncodingPkt =======================================
+ * Receive and process the EXT_SET_UPLOAD_ENCODING packet [upInfoIdx encoding]
+ * and reply with [encoding upInfoIdx], the encoding that the target will use.
+ * Targets without signal monitoring always reply EXT_UPLOAD_ENCODING_RAW.  A
+ * packet that cannot be read, is too short or names an upInfoIdx out of
+ * range gets EXT_UPLOAD_ENCODING_ERROR.
+ */
+PRIVATE boolean_T ProcessSetUploadEncodingPkt(const int pktSize)
+{
+    const char *pkt;
+    int32_T    msg[2];
+    int32_T    upInfoIdx = -1;
+    int32_T    encoding  = (int32_T)EXT_UPLOAD_ENCODING_ERROR;
+    boolean_T  error     = EXT_NO_ERROR;
+
+#ifdef DAEMON_MODE
+    pkt = GetPktUsingAck(pktSize);
+#else
+    pkt = GetPkt(pktSize);
+#endif
+
+    if (pkt == NULL) {
+        error = EXT_ERROR;
+        goto EXIT_POINT;
+    }
+
+    /* A malformed request is refused, but the connection is kept. */
+    if (pktSize < (int)(2*sizeof(int32_T))) goto EXIT_POINT;
+
+    (void)memcpy(&upInfoIdx, pkt, sizeof(int32_T));
+    (void)memcpy(&encoding, pkt+sizeof(int32_T), sizeof(int32_T));
+
+    if ((upInfoIdx < 0) || (upInfoIdx >= NUM_UPINFOS)) {
+        encoding = (int32_T)EXT_UPLOAD_ENCODING_ERROR;
+        goto EXIT_POINT;
+    }
+
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+    encoding = UploadSetEncoding(upInfoIdx, encoding);
+#else
+    encoding = (int32_T)EXT_UPLOAD_ENCODING_RAW;
+#endif
+
+#ifndef EXTMODE_DISABLEPRINTF
+    PRINT_VERBOSE(
+            ("got EXT_SET_UPLOAD_ENCODING packet for upInfoIdx : %d, using encoding %d\n",
+             upInfoIdx, encoding));
+#endif
+
+EXIT_POINT:
+    msg[0] = encoding;
+    msg[1] = upInfoIdx;
+    if (SendPktToHost(EXT_SET_UPLOAD_ENCODING_RESPONSE,
+                      2*sizeof(int32_T), (char_T *)msg) != EXT_NO_ERROR) {
+        error = EXT_ERROR;
+    }
+    return(error);
+} /* end ProcessSetUploadEncodingPkt */
+
+
 #ifdef EXTMODE_DISABLEPARAMETERTUNING
 PRIVATE boolean_T AcknowledgeSetParamPkt(const int pktSize)
 {
@@ -1041,6 +1182,8 @@ PUBLIC boolean_T ExtWaitForStartPkt(void)
 void UploadServerWork(int32_T upInfoIdx, int_T numSampTimes)
 {
     int_T         i;
+    int_T         first;
+    int_T         nBufs;
     ExtBufMemList upList;
     boolean_T     error = EXT_NO_ERROR;
 
@@ -1059,39 +1202,44 @@ taskSafe();
     
     UploadBufGetData(&upList, upInfoIdx, numSampTimes);
     while(upList.nActiveBufs > 0) {
-        for (i=0; i<upList.nActiveBufs; i++) {
-            const BufMem *bufMem = &upList.bufs[i];
+        for (first=0; first<upList.nActiveBufs; first+=nBufs) {
+            ExtIOVec iov[2*UPLOAD_SENDV_MAX_BUFS];
+            int_T    iovCnt = 0;
+
+            nBufs = upList.nActiveBufs - first;
+            if (nBufs > UPLOAD_SENDV_MAX_BUFS) nBufs = UPLOAD_SENDV_MAX_BUFS;
 
             /*
-             * We call SendPktDataToHost() instead of SendPktToHost() because
-             * the packet header is combined with packet payload.  We do this
-             * to avoid the overhead of making two calls for each upload
-             * packet - one for the head and one for the payload.
+             * The packet headers are combined with the packet payload in the
+             * upload buffers, so both sections of each buffer are sent as
+             * packet data, and all of them with one transport call.
              */
-            error = SendPktDataToHost(
-                bufMem->section1,
-                bufMem->nBytes1);
+            for (i=first; i<first+nBufs; i++) {
+                const BufMem *bufMem = &upList.bufs[i];
+
+                iov[iovCnt].base   = bufMem->section1;
+                iov[iovCnt].nBytes = bufMem->nBytes1;
+                iovCnt++;
+
+                if (bufMem->nBytes2 > 0) {
+                    iov[iovCnt].base   = bufMem->section2;
+                    iov[iovCnt].nBytes = bufMem->nBytes2;
+                    iovCnt++;
+                }
+            }
+
+            error = SendPktDataVToHost(iov, iovCnt);
             if (error != EXT_NO_ERROR) {
 #ifndef EXTMODE_DISABLEPRINTF                    
-                fprintf(stderr,"SendPktDataToHost() failed on data upload.\n");
+                fprintf(stderr,"SendPktDataVToHost() failed on data upload.\n");
 #endif
                 goto EXIT_POINT;
             }
-            
-            if (bufMem->nBytes2 > 0) {
 
-                error = SendPktDataToHost(
-                    bufMem->section2,
-                    bufMem->nBytes2);
-                if (error != EXT_NO_ERROR) {
-#ifndef EXTMODE_DISABLEPRINTF                        
-                    fprintf(stderr,"SendPktDataToHost() failed on data upload.\n");
-#endif
-                    goto EXIT_POINT;
-                }
-            }
             /* confirm that the data was sent */
-            UploadBufDataSent(upList.tids[i], upInfoIdx);
+            for (i=first; i<first+nBufs; i++) {
+                UploadBufDataSent(upList.tids[i], upInfoIdx);
+            }
         }
         UploadBufGetData(&upList, upInfoIdx, numSampTimes);
     }
@@ -1423,6 +1571,13 @@ PUBLIC void rt_PktServerWork(RTWExtModeInfo *ei,
         break;
     }
 
+    case EXT_SET_UPLOAD_ENCODING:
+    {
+        error = ProcessSetUploadEncodingPkt(pktHdr.size);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+        break;
+    }
+
     default:
 #ifndef EXTMODE_DISABLEPRINTF            
         fprintf(stderr,"received invalid packet.\n");
@@ -1538,6 +1693,10 @@ PUBLIC boolean_T rt_ExtModeShutdown(int_T numSampTimes)
         ExtModeShutdown(i, numSampTimes);
     }
 
+#if !defined(EXTMODE_DISABLEPARAMETERTUNING) && defined(EXTMODE_STEP_ATOMIC_PARAMS)
+    FreeStagedParams();
+#endif
+
     if (commInitialized) {
         error = SendPktToHost(EXT_MODEL_SHUTDOWN, 0, NULL);
         if (error != EXT_NO_ERROR) {
@@ -1569,9 +1728,16 @@ PUBLIC boolean_T rt_ExtModeShutdown(int_T numSampTimes)
 PUBLIC void rt_UploadCheckTrigger(int_T numSampTimes)
 {
     int i;
+
+#ifdef EXTMODE_SERVER_THREAD
+    UploadModelCallBegin();
+#endif
     for (i=0; i<NUM_UPINFOS; i++) {
         UploadCheckTrigger(i, numSampTimes);
     }
+#ifdef EXTMODE_SERVER_THREAD
+    UploadModelCallEnd();
+#endif
 } /* end rt_UploadCheckTrigger */
 
 /* Function: rt_UploadCheckEndTrigger ==========================================
@@ -1582,9 +1748,15 @@ PUBLIC void rt_UploadCheckEndTrigger(void)
 {
     int i;
     
+#ifdef EXTMODE_SERVER_THREAD
+    UploadModelCallBegin();
+#endif
     for (i=0; i<NUM_UPINFOS; i++) {
         UploadCheckEndTrigger(i);
     }
+#ifdef EXTMODE_SERVER_THREAD
+    UploadModelCallEnd();
+#endif
 } /* end rt_UploadCheckEndTrigger */
 
 /* Function: rt_UploadBufAddTimePoint ==========================================
@@ -1595,10 +1767,44 @@ PUBLIC void rt_UploadBufAddTimePoint(int_T tid, real_T taskTime)
 {
     int i;
     
+#ifdef EXTMODE_SERVER_THREAD
+    UploadModelCallBegin();
+#endif
     for (i=0; i<NUM_UPINFOS; i++) {
         UploadBufAddTimePoint(tid, taskTime, i);
     }
+#ifdef EXTMODE_SERVER_THREAD
+    UploadModelCallEnd();
+#endif
 } /* end rt_UploadBufAddTimePoint */
+
+/* Function: rt_UploadGetNumDropped ============================================
+ * Abstract:
+ *  Return the number of time points, over all upInfos, that did not fit in
+ *  the upload buffers.
+ */
+PUBLIC uint32_T rt_UploadGetNumDropped(int_T numSampTimes)
+{
+    int      i;
+    uint32_T nDropped = 0;
+
+    for (i=0; i<NUM_UPINFOS; i++) {
+        nDropped += UploadGetNumDropped(i, numSampTimes);
+    }
+    return(nDropped);
+} /* end rt_UploadGetNumDropped */
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
+#if !defined(EXTMODE_DISABLEPARAMETERTUNING) && defined(EXTMODE_STEP_ATOMIC_PARAMS)
+/* Function: rt_CommitStagedParams =============================================
+ * Abstract:
+ *  Install the parameters staged by EXT_SETPARAM packets.  Called by the
+ *  model thread while no step is in progress.
+ */
+PUBLIC void rt_CommitStagedParams(void)
+{
+    CommitStagedParams();
+} /* end rt_CommitStagedParams */
+#endif
+
 /* [EOF] ext_svr.c */
@@ -40,6 +40,12 @@ extern void      rt_UploadCheckEndTrigger(void);
 extern void      rt_UploadBufAddTimePoint(int_T tid,
                                           real_T taskTime);
 
+extern uint32_T  rt_UploadGetNumDropped(int_T numSampTimes);
+
+#if !defined(EXTMODE_DISABLEPARAMETERTUNING) && defined(EXTMODE_STEP_ATOMIC_PARAMS)
+extern void      rt_CommitStagedParams(void);
+#endif
+
 #ifndef VXWORKS
 extern void      rt_ExtModeSleep(long sec,   /* number of seconds to wait      */
                                  long usec); /* number of micro seconds to wait*/
@@ -65,6 +65,18 @@ extern boolean_T ExtSetHostPkt(
     const char        *src,
     int               *nBytesSet);
 
+/*
+ * Optional. Transports that implement ExtSetHostPktV, such as the ones in
+ * this directory tree, are used with one call per packet when the build
+ * defines EXTMODE_HAS_SETHOSTPKTV. Otherwise ext_svr sends each piece with
+ * ExtSetHostPkt, and a transport need not provide ExtSetHostPktV.
+ */
+extern boolean_T ExtSetHostPktV(
+    const ExtUserData *UD,
+    const ExtIOVec    *iov,
+    const int         iovCnt,
+    int               *nBytesSet);
+
 extern void ExtModeSleep(
     const ExtUserData *UD,
     const long        sec,  
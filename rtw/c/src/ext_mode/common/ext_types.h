@@ -27,6 +27,38 @@
 #  define free   ExtModeFree
 #endif
 
+/****************************************
+ * Vectored sends                       *
+ ****************************************/
+/*
+ * One piece of a vectored send (ExtSetHostPktV). The pieces of a send are
+ * set on the comm line back to back, as if they were one buffer. ExtSetHostPktV
+ * is only called when EXTMODE_HAS_SETHOSTPKTV is defined, see
+ * ext_svr_transport.h.
+ */
+typedef struct ExtIOVec_tag {
+    const char *base;   /* start of the piece  */
+    int        nBytes;  /* nbytes in the piece */
+} ExtIOVec;
+
+/****************************************
+ * Step-atomic parameter updates        *
+ ****************************************/
+/*
+ * With EXTMODE_STEP_ATOMIC_PARAMS, the packet server stages EXT_SETPARAM
+ * packets (StageSetParam) and the model thread installs them between base
+ * rate steps (rt_CommitStagedParams), so that a step never sees part of an
+ * update.  This is needed whenever the packet server and the model do not
+ * run in the same thread, and is the default with EXTMODE_SERVER_THREAD.
+ * EXTMODE_PARAM_QUEUE_LENGTH updates can wait for a step at a time.
+ */
+#if defined(EXTMODE_SERVER_THREAD) && !defined(EXTMODE_STEP_ATOMIC_PARAMS)
+#  define EXTMODE_STEP_ATOMIC_PARAMS
+#endif
+#ifndef EXTMODE_PARAM_QUEUE_LENGTH
+#  define EXTMODE_PARAM_QUEUE_LENGTH 4
+#endif
+
 /****************************************
  * Integer only code                    *
  ****************************************/
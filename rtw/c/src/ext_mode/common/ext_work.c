@@ -5,6 +5,18 @@
  *
  * Abstract:
  *   
+ *   Define EXTMODE_SERVER_THREAD (POSIX targets) to move all transport I/O
+ *   off the model thread: rt_PktServerWork and rt_UploadServerWork then run
+ *   in a low-priority thread, fed by the upload circular buffers (single
+ *   producer, single consumer rings, see updown.c).  The model thread never
+ *   blocks on the host; a time point that does not fit in an upload buffer
+ *   is dropped and counted (reported by rtExtModeShutdown).
+ *   EXTMODE_SERVER_THREAD_PERIOD_USEC sets how long the thread sleeps between
+ *   polls of the connection.
+ *
+ *   With EXTMODE_STEP_ATOMIC_PARAMS (see ext_types.h) parameter updates are
+ *   installed by the model thread: at the end of each base rate step
+ *   (rtExtModeCheckEndTrigger) and while it waits to start or is paused.
  */
 
 #if !defined(EXTMODE_DISABLEPRINTF) || !defined(EXTMODE_DISABLE_ARGS_PROCESSING)
@@ -24,6 +36,24 @@
 #include "ext_svr_transport.h"
 #include "ext_work.h" /* includes all VxWorks headers */
 
+#ifdef EXTMODE_SERVER_THREAD
+#  if defined(VXWORKS) || defined(C6000_EXT_MODE)
+#    error EXTMODE_SERVER_THREAD is not supported on this target
+#  endif
+#  include <pthread.h>
+#  include <sched.h>
+#  include <time.h>
+#  ifndef EXTMODE_SERVER_THREAD_PERIOD_USEC
+#    define EXTMODE_SERVER_THREAD_PERIOD_USEC 1000L
+#  endif
+#endif
+
+#if !defined(EXTMODE_DISABLEPARAMETERTUNING) && defined(EXTMODE_STEP_ATOMIC_PARAMS)
+#  define rtExtModeCommitParams() rt_CommitStagedParams()
+#else
+#  define rtExtModeCommitParams() /* do nothing */
+#endif
+
 /* Logical definitions */
 #if (!defined(__cplusplus))
 #  ifndef false
@@ -114,6 +144,97 @@ void rtExtModeTornadoSetPortInExtUD(const int_T port)
 
 #else /* VXWORKS == 0 */
 
+#ifdef EXTMODE_SERVER_THREAD
+typedef struct ExtModeServerThread_tag {
+    pthread_t      thread;
+    boolean_T      running;    /* thread owns the transport I/O  */
+    boolean_T      failed;     /* could not create the thread    */
+    int_T volatile stop;
+
+    RTWExtModeInfo *ei;
+    int_T          numSampTimes;
+    boolean_T      *stopReqPtr;
+} ExtModeServerThread;
+
+static ExtModeServerThread serverThread;
+
+static void rtExtModeServerThreadSleep(void)
+{
+    struct timespec period;
+
+    period.tv_sec  = EXTMODE_SERVER_THREAD_PERIOD_USEC / 1000000L;
+    period.tv_nsec = (EXTMODE_SERVER_THREAD_PERIOD_USEC % 1000000L) * 1000L;
+    (void)nanosleep(&period, NULL);
+}
+
+/* Function ====================================================================
+ * Serve packets and uploads until rtExtModeShutdown stops the thread.
+ */
+static void *rtExtModeServerThreadMain(void *arg)
+{
+    ExtModeServerThread *st = (ExtModeServerThread *)arg;
+
+    while (!st->stop) {
+        rt_PktServerWork(st->ei, st->numSampTimes, st->stopReqPtr);
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+        rt_UploadServerWork(st->numSampTimes);
+#endif
+        rtExtModeServerThreadSleep();
+    }
+    return NULL;
+}
+
+/* Function ====================================================================
+ * Start the server thread, once.  It runs with the default (non real-time)
+ * policy, below a model thread that runs with a real-time policy.  If the
+ * thread cannot be created, the model thread keeps serving the host.
+ */
+static void rtExtModeStartServerThread(RTWExtModeInfo *ei,
+                                       int_T          numSampTimes,
+                                       boolean_T      *stopReqPtr)
+{
+    pthread_attr_t     attr;
+    struct sched_param param;
+
+    if (serverThread.running || serverThread.failed) return;
+
+    serverThread.ei           = ei;
+    serverThread.numSampTimes = numSampTimes;
+    serverThread.stopReqPtr   = stopReqPtr;
+    serverThread.stop         = false;
+
+    param.sched_priority = 0;
+    (void)pthread_attr_init(&attr);
+    (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    (void)pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    (void)pthread_attr_setschedparam(&attr, &param);
+
+    if (pthread_create(&serverThread.thread, &attr,
+                       rtExtModeServerThreadMain, &serverThread) == 0) {
+        serverThread.running = true;
+    } else {
+        serverThread.failed = true;
+#ifndef EXTMODE_DISABLEPRINTF
+        printf("Could not create the external mode server thread, "
+               "serving the host from the model thread.\n");
+#endif
+    }
+    (void)pthread_attr_destroy(&attr);
+}
+
+/* Function ====================================================================
+ * Stop the server thread and wait for it to finish.
+ */
+static void rtExtModeStopServerThread(void)
+{
+    if (!serverThread.running) return;
+
+    serverThread.stop = true;
+    (void)pthread_join(serverThread.thread, NULL);
+    serverThread.running = false;
+}
+#endif /* EXTMODE_SERVER_THREAD */
+
 /* Function ====================================================================
  * Pause the process (w/o hogging the cpu) until receive step packet (which
  * means the startModel flag moves to true) or until we are no longer
@@ -124,14 +245,25 @@ void rtExtModePauseIfNeeded(RTWExtModeInfo *ei,
                             int_T          numSampTimes,
                             boolean_T      *stopReqPtr)
 {
+#ifdef EXTMODE_SERVER_THREAD
+    rtExtModeStartServerThread(ei, numSampTimes, stopReqPtr);
+#endif
     while((modelStatus == TARGET_STATUS_PAUSED) && 
           !startModel && !(*stopReqPtr)) {
+        rtExtModeCommitParams();
+#ifdef EXTMODE_SERVER_THREAD
+        if (serverThread.running) {
+            rtExtModeServerThreadSleep();
+            continue;
+        }
+#endif
         rt_ExtModeSleep(0L, 375000L);
         rt_PktServerWork(ei,numSampTimes,stopReqPtr);
 #ifndef EXTMODE_DISABLESIGNALMONITORING
         rt_UploadServerWork(numSampTimes);
 #endif
     }
+    rtExtModeCommitParams();
     startModel = false; /* reset to false - if we were stepped we want to
                          *                  stop again next time we get
                          *                  back here.
@@ -147,11 +279,22 @@ void rtExtModeWaitForStartPkt(RTWExtModeInfo *ei,
                               int_T          numSampTimes,
                               boolean_T      *stopReqPtr)
 {
+#ifdef EXTMODE_SERVER_THREAD
+    rtExtModeStartServerThread(ei, numSampTimes, stopReqPtr);
+#endif
+
     /*
      * Pause until receive model start packet.
      */
     if (ExtWaitForStartPkt()) {
         while(!startModel && !(*stopReqPtr)) {
+            rtExtModeCommitParams();
+#ifdef EXTMODE_SERVER_THREAD
+            if (serverThread.running) {
+                rtExtModeServerThreadSleep();
+                continue;
+            }
+#endif
             rt_ExtModeSleep(0L, 375000L);
             rt_PktServerWork(ei,numSampTimes,stopReqPtr);
 #ifndef EXTMODE_DISABLESIGNALMONITORING
@@ -159,6 +302,7 @@ void rtExtModeWaitForStartPkt(RTWExtModeInfo *ei,
 #endif
         }
     }
+    rtExtModeCommitParams();
     if (modelStatus != TARGET_STATUS_PAUSED) {
         modelStatus = TARGET_STATUS_RUNNING;
     } else {
@@ -175,6 +319,10 @@ void rtExtModeOneStep(RTWExtModeInfo *ei,
      * In a multi-tasking environment, this would be removed from the base rate
      * and called as a "background" task.
      */
+#ifdef EXTMODE_SERVER_THREAD
+    rtExtModeStartServerThread(ei, numSampTimes, stopReqPtr);
+    if (serverThread.running) return;
+#endif
     if (modelStatus != TARGET_STATUS_PAUSED) {
         rt_PktServerWork(ei,numSampTimes,stopReqPtr);
 #ifndef EXTMODE_DISABLESIGNALMONITORING
@@ -195,6 +343,7 @@ void rtExtModeCheckEndTrigger(void)
 #ifndef EXTMODE_DISABLESIGNALMONITORING
     rt_UploadCheckEndTrigger();
 #endif
+    rtExtModeCommitParams();
 }
 
 void rtExtModeUploadCheckTrigger(int_T numSampTimes)
@@ -217,7 +366,21 @@ void rtExtModeCheckInit(int_T numSampTimes)
 
 void rtExtModeShutdown(int_T numSampTimes)
 {
+#ifdef EXTMODE_SERVER_THREAD
+    rtExtModeStopServerThread();
+#endif
     rt_ExtModeShutdown(numSampTimes);
+
+#if defined(EXTMODE_SERVER_THREAD) && \
+    !defined(EXTMODE_DISABLESIGNALMONITORING) && !defined(EXTMODE_DISABLEPRINTF)
+    {
+        uint32_T nDropped = rt_UploadGetNumDropped(numSampTimes);
+        if (nDropped > 0) {
+            printf("External mode: %lu time points did not fit in the upload "
+                   "buffers and were dropped.\n", (unsigned long)nDropped);
+        }
+    }
+#endif
 }
 
 void rtExtModeParseArgs(int_T        argc, 
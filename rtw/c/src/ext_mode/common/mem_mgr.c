@@ -4,6 +4,17 @@
  * File: mem_mgr.c     $Revision.2 $
  *
  * Abstract:
+ *  Segregated-fit allocator for the static external mode memory buffer.
+ *
+ *  The buffer is divided into contiguous blocks, each starting with a
+ *  MemBufHdr that holds the size of the block and of the block before it,
+ *  so that both physical neighbors are found in constant time. Free blocks
+ *  are kept in one list per power-of-two size class and a bitmap records
+ *  which lists are non-empty. Allocating takes a block from the smallest
+ *  class that is guaranteed to fit and splits off the unused end; freeing
+ *  checks the ownership tag in the header and merges the block with free
+ *  neighbors. Neither searches a list, and free blocks are always merged,
+ *  so no garbage collection is needed.
  */
 
 #include <stddef.h>
@@ -22,322 +33,191 @@
 
 #include "mem_mgr.h"
 
-/* Logical definitions */
-#if (!defined(__cplusplus))
-#  ifndef false
-#   define false                       (0U)
-#  endif
-#  ifndef true
-#   define true                        (1U)
-#  endif
-#endif
-
-PRIVATE char MemoryBuffer[EXTMODE_STATIC_SIZE];
-
-PRIVATE MemBufHdr *FreeQueue = NULL;
-PRIVATE MemBufHdr InUseQueue = {NULL, NULL, NULL, 0};
+/* Alignment of the blocks and of the memory returned by ExtModeMalloc. */
+#define MEM_BUF_ALIGN        (8U)
+#define MEM_BUF_ALIGN_UP(n)  (((n) + (MEM_BUF_ALIGN-1U)) & ~(MEM_BUF_ALIGN-1U))
 
-#ifdef VERBOSE
-uint32_T numBytesAllocated = 0;
-#endif
+#define MEM_BUF_HDR_SIZE     ((uint32_T)MEM_BUF_ALIGN_UP(sizeof(MemBufHdr)))
 
-PRIVATE void insertMemBufRight(MemBufHdr *buf, MemBufHdr *queue)
-{
-    assert(queue != NULL);
-    assert(buf != NULL);
+/* Splitting off less than this would leave a free block with no room. */
+#define MEM_BUF_MIN_SIZE     (MEM_BUF_HDR_SIZE + MEM_BUF_ALIGN)
 
-    buf->memBufPrev = queue;
-    buf->memBufNext = queue->memBufNext;
+/* Ownership tags, to catch frees of memory that is not allocated here. */
+#define MEM_BUF_TAG_FREE     (0x46524545U)
+#define MEM_BUF_TAG_IN_USE   (0x55534544U)
 
-    if (buf->memBufNext != NULL) {
-	buf->memBufNext->memBufPrev = buf;
-    }
+/* Size class k holds free blocks of 2^k to 2^(k+1)-1 bytes. */
+#define NUM_SIZE_CLASSES     (32)
 
-    queue->memBufNext = buf;
-}
-
-PRIVATE void removeMemBuf(MemBufHdr *buf)
-{
-    MemBufHdr *rightMemBuf;
-    MemBufHdr *leftMemBuf;
-
-    assert(buf != NULL);
+PRIVATE char MemoryBuffer[EXTMODE_STATIC_SIZE];
 
-    rightMemBuf = buf->memBufNext;
-    leftMemBuf  = buf->memBufPrev;
+PRIVATE char      *ArenaStart = NULL;
+PRIVATE char      *ArenaEnd   = NULL;
+PRIVATE MemBufHdr *FreeLists[NUM_SIZE_CLASSES];
+PRIVATE uint32_T  FreeListMap = 0U; /* bit k set if FreeLists[k] is non-empty */
 
-    if (rightMemBuf != NULL) {
-	rightMemBuf->memBufPrev = leftMemBuf;
-    }
-    if (leftMemBuf != NULL) {
-	leftMemBuf->memBufNext = rightMemBuf;
-    }
+PRIVATE uint32_T  BytesInUse     = 0U;
+PRIVATE uint32_T  HighWaterBytes = 0U;
+PRIVATE uint32_T  NumInUse       = 0U;
+PRIVATE uint32_T  NumFailed      = 0U;
 
-    buf->memBufNext = NULL;
-    buf->memBufPrev = NULL;
-}
+#ifdef VERBOSE
+uint32_T numBytesAllocated = 0;
+#endif
 
-PRIVATE boolean_T moveRight(MemBufHdr *buf)
+/* Index of the highest set bit of a non-zero value. */
+PRIVATE int sizeClass(uint32_T size)
 {
-    MemBufHdr *buf2;
-
-    assert(buf != NULL);
-
-    if (buf->memBufNext == NULL) {
-	return false;
-    } else {
-	buf2 = buf->memBufNext;
-	removeMemBuf(buf);
-	insertMemBufRight(buf,buf2);
-    }
-    return true;    
-}
+    int k = 0;
 
-PRIVATE boolean_T sortRight(MemBufHdr *buf)
-{
-    assert(buf != NULL);
+    assert(size != 0U);
 
-    if ((buf->memBufNext != NULL) && (buf > buf->memBufNext)) {
-	return moveRight(buf);
-    }
-    return false;
+    if (size >= 0x10000U) { size >>= 16; k += 16; }
+    if (size >= 0x100U)   { size >>= 8;  k += 8;  }
+    if (size >= 0x10U)    { size >>= 4;  k += 4;  }
+    if (size >= 0x4U)     { size >>= 2;  k += 2;  }
+    if (size >= 0x2U)     {              k += 1;  }
+    return k;
 }
 
-PRIVATE boolean_T sortLeft(MemBufHdr *buf)
+/* Index of the lowest set bit of a non-zero value. */
+PRIVATE int lowestClass(uint32_T map)
 {
-    assert(buf != NULL);
+    assert(map != 0U);
 
-    if ((buf->memBufPrev != NULL) && (buf < buf->memBufPrev)) {
-	return moveRight(buf->memBufPrev);
-    }
-    return false;
+    /* Isolate the lowest set bit, so the highest set bit is the same. */
+    return sizeClass(map & (~map + 1U));
 }
 
-PRIVATE boolean_T mergeWithMemBufOnRight(MemBufHdr *buf)
+PRIVATE void freeListInsert(MemBufHdr *buf)
 {
-    assert(buf != NULL);
+    int k = sizeClass(buf->size);
 
-    /*
-     * If this memory buffer is adjacent to a free memory buffer to its right,
-     * merge the two memory buffers into one contiguous free memory buffer.
-     */
+    buf->tag        = MEM_BUF_TAG_FREE;
+    buf->memBufPrev = NULL;
+    buf->memBufNext = FreeLists[k];
     if (buf->memBufNext != NULL) {
-	MemBufHdr *leftMemBuf   = buf;
-	MemBufHdr *rightMemBuf  = buf->memBufNext;
-	
-	/* Assumes data portion of mem buf is contiguous with mem buf header. */
-	char *pointer1 = ((char *)leftMemBuf + sizeof(MemBufHdr) + leftMemBuf->size);
-	char *pointer2 = (char *)leftMemBuf->memBufNext;
-
-	if (pointer1 == pointer2)
-        {
-            removeMemBuf(rightMemBuf);
-            leftMemBuf->size += rightMemBuf->size + sizeof(MemBufHdr);
-            return true;
-        }
+        buf->memBufNext->memBufPrev = buf;
     }
-    return false;
+    FreeLists[k] = buf;
+    FreeListMap |= (1U << k);
 }
 
-PRIVATE boolean_T mergeMemBuf(MemBufHdr *buf)
+PRIVATE void freeListRemove(MemBufHdr *buf)
 {
-    boolean_T statusRight = false;
-    boolean_T statusLeft  = false;
-
-    assert(buf != NULL);
+    int k = sizeClass(buf->size);
 
-    statusRight = mergeWithMemBufOnRight(buf);
+    assert(buf->tag == MEM_BUF_TAG_FREE);
 
     if (buf->memBufPrev != NULL) {
-        statusLeft = mergeWithMemBufOnRight(buf->memBufPrev);
+        buf->memBufPrev->memBufNext = buf->memBufNext;
+    } else {
+        FreeLists[k] = buf->memBufNext;
+        if (FreeLists[k] == NULL) FreeListMap &= ~(1U << k);
     }
-
-    return (statusRight | statusLeft);
-}
-
-PRIVATE MemBufHdr *inUseQueueFindMemBufHdr(void *mem)
-{
-    MemBufHdr *LocalBuf;
-
-    assert(mem != NULL);
-
-    LocalBuf = &InUseQueue;
-
-    if (LocalBuf->MemBuf == mem) return LocalBuf;
-
-    while (LocalBuf->memBufNext != NULL) {
-	LocalBuf = LocalBuf->memBufNext;
-        if (LocalBuf->MemBuf == mem) return LocalBuf;
+    if (buf->memBufNext != NULL) {
+        buf->memBufNext->memBufPrev = buf->memBufPrev;
     }
-
-    return NULL;
+    buf->memBufNext = NULL;
+    buf->memBufPrev = NULL;
 }
 
-PRIVATE void inUseQueueInsert(MemBufHdr *buf)
+/* Block that follows buf in the memory buffer, or NULL for the last block. */
+PRIVATE MemBufHdr *nextMemBuf(MemBufHdr *buf)
 {
-    MemBufHdr *LocalBuf;
-
-    assert(buf != NULL);
+    char *next = (char *)buf + buf->size;
 
-    LocalBuf = &InUseQueue;
-    while (LocalBuf->memBufNext != NULL) {
-	LocalBuf = LocalBuf->memBufNext;
-	continue;
-    }
-    insertMemBufRight(buf, LocalBuf);
+    return (next < ArenaEnd) ? (MemBufHdr *)next : NULL;
 }
 
-PRIVATE void sortQueue(MemBufHdr *buf)
+/* Block that precedes buf in the memory buffer, or NULL for the first block. */
+PRIVATE MemBufHdr *prevMemBuf(MemBufHdr *buf)
 {
-    int count = 1;
-
-    assert(buf != NULL);
-
-    /* Bi-directional bubble sort...
-     *
-     * Whatever packet given, move it left until the packet to the
-     * left belongs there, or there is no packet to the left.
-     *
-     * If there is a packet to the left, move it to the left as
-     * above. 
-     *
-     * If there is no packet to the left, reverse direction moving
-     * packets to the right.
-     *
-     * Repeat this until no packets are moved.
-     */
-
-    /* While something moves... */
-    while (count > 0) {
-	count = 0;
-
-	/* Bubble left. */
-	while (1) {
-	    /* Move the current packet as far left as it will go. */
-	    if (sortLeft(buf)) {
-		count++;
-		continue;
-	    } else {
-		/* Try to merge the packet with its neighbor to the right. */
-		mergeMemBuf(buf);
-
-		/* Move the MemBufHdr to the left, if possible, and
-		 * continue bubbling left.
-		 */ 
-		if (buf->memBufPrev != NULL) {
-		    buf = buf->memBufPrev;
-		    continue;
-		} else {
-		    break;
-		}
-	    }
-	}
-
-	/* All done bubbling to the left. Now bubble to the right. */
-
-	/* Bubble right. */
-	while (1) {
-	    /* Move the current packet as far right as it will go. */
-	    if (sortRight(buf)) {
-		count++;
-		continue;
-	    } else {
-		/* Try to merge the packet with its neighbor to the right. */
-		mergeMemBuf(buf);
-
-		/* Move the MemBufHdr to the right, if possible, and
-		 * continue bubbling right.
-		 */ 
-		if (buf->memBufNext != NULL) {
-		    buf = buf->memBufNext;
-		    continue;
-		} else {
-		    break;
-		}
-	    }
-	}
-    }
+    return (buf->prevSize != 0U) ? (MemBufHdr *)((char *)buf - buf->prevSize) : NULL;
 }
 
-PRIVATE void initFreeQueue(void)
+PRIVATE void initFreeLists(void)
 {
-    MemBufHdr *initialFreeMemBuf = NULL;
+    MemBufHdr *initialFreeMemBuf;
+    int       k;
 
-#ifdef VERBOSE
-    /* There is always at least one header allocated from the buffer. */
-    numBytesAllocated = sizeof(MemBufHdr);
-#endif
-
-    /* The FreeQueue is a pointer to a "free" buffer. */
-    FreeQueue = (MemBufHdr *)MemoryBuffer;
-
-    /*
-     * The first free packet describes blocks of free space in the free queue
-     * buffer (initially the whole buffer) and, as space becomes fragmented, is
-     * linked to other "free" buffers.
-     */
-    initialFreeMemBuf = FreeQueue;
-
-    /*
-     * The location and size of the initial free buffer describes the whole
-     * memory buffer.
-     */
-    initialFreeMemBuf->MemBuf = (char *)initialFreeMemBuf + sizeof(MemBufHdr);
-    initialFreeMemBuf->size   = sizeof(MemoryBuffer) - sizeof(MemBufHdr);
-
-    /*
-     * When there is only one, contiguous memory buffer, the initial free
-     * buffer is linked to no other free buffers. When there are more than
-     * one, or discontiguous free buffers, these links tie together all free
-     * buffers.
-     */
-    initialFreeMemBuf->memBufPrev = NULL;
-    initialFreeMemBuf->memBufNext = NULL;
+    for (k = 0; k < NUM_SIZE_CLASSES; k++) {
+        FreeLists[k] = NULL;
+    }
+    FreeListMap = 0U;
+
+    /* The whole (aligned) memory buffer is one free block. */
+    ArenaStart = MemoryBuffer +
+        ((MEM_BUF_ALIGN - (size_t)MemoryBuffer % MEM_BUF_ALIGN) % MEM_BUF_ALIGN);
+    ArenaEnd   = ArenaStart +
+        (((MemoryBuffer + sizeof(MemoryBuffer)) - ArenaStart) & ~(ptrdiff_t)(MEM_BUF_ALIGN-1U));
+
+    initialFreeMemBuf           = (MemBufHdr *)ArenaStart;
+    initialFreeMemBuf->size     = (uint32_T)(ArenaEnd - ArenaStart);
+    initialFreeMemBuf->prevSize = 0U;
+    freeListInsert(initialFreeMemBuf);
 }
 
-PRIVATE MemBufHdr *findFirstFreeMemBuf(const int bufSize)
+/*
+ * Find a free block of at least bufSize bytes. The blocks of the size class
+ * of bufSize may be smaller than bufSize, so that list is searched for the
+ * first block that fits; otherwise any block of a larger class fits, and the
+ * smallest non-empty one is used.
+ */
+PRIVATE MemBufHdr *findFreeMemBuf(const uint32_T bufSize)
 {
-    /* Get the first free packet. */
-    MemBufHdr *buf = FreeQueue;
+    int       k = sizeClass(bufSize);
+    uint32_T  largerClasses;
+    MemBufHdr *buf;
 
-    /*
-     * Loop until we find a free packet big enough for our request or we
-     * run out of free packets.
-     */
-    while (buf != NULL) {
-        /* Take the first free packet that fits. */
-        if (buf->size >= bufSize) {
-            /* Got it. Break out to continue. */
-            break;
-        }
-        /* Get the next free packet. */
-        buf = buf->memBufNext;
+    for (buf = FreeLists[k]; buf != NULL; buf = buf->memBufNext) {
+        if (buf->size >= bufSize) return buf;
     }
 
-    return buf;
+    largerClasses = (k < NUM_SIZE_CLASSES-1) ? (FreeListMap & ~((2U << k) - 1U)) : 0U;
+    if (largerClasses == 0U) return NULL;
+
+    return FreeLists[lowestClass(largerClasses)];
 }
 
 PUBLIC void ExtModeFree(void *mem)
 {
-    MemBufHdr *buf = NULL;
+    MemBufHdr *buf;
+    MemBufHdr *neighbor;
 
     if (mem == NULL) return;
 
-    /* Find the header associated with the memory pointer. */
-    buf = inUseQueueFindMemBufHdr(mem);
-    assert(buf != NULL);
+    /* The header is right before the memory pointer. */
+    buf = (MemBufHdr *)((char *)mem - MEM_BUF_HDR_SIZE);
+    assert(buf->tag == MEM_BUF_TAG_IN_USE);
+    if (buf->tag != MEM_BUF_TAG_IN_USE) return;
+
+    BytesInUse -= buf->size;
+    NumInUse--;
 
 #ifdef VERBOSE
-    numBytesAllocated -= (buf->size + sizeof(MemBufHdr));
+    numBytesAllocated -= buf->size;
     printf("\nBytes allocated: %d out of %d.\n", numBytesAllocated, EXTMODE_STATIC_SIZE);
 #endif
 
-    /* Remove the buffer from the linked list. */
-    removeMemBuf(buf);
+    /* Merge with the free blocks on either side. */
+    neighbor = nextMemBuf(buf);
+    if ((neighbor != NULL) && (neighbor->tag == MEM_BUF_TAG_FREE)) {
+        freeListRemove(neighbor);
+        buf->size += neighbor->size;
+    }
+    neighbor = prevMemBuf(buf);
+    if ((neighbor != NULL) && (neighbor->tag == MEM_BUF_TAG_FREE)) {
+        freeListRemove(neighbor);
+        neighbor->size += buf->size;
+        buf = neighbor;
+    }
+    neighbor = nextMemBuf(buf);
+    if (neighbor != NULL) {
+        neighbor->prevSize = buf->size;
+    }
 
-    /* Put the buffer back in the free queue. */
-    insertMemBufRight(buf, FreeQueue);
-    mergeMemBuf(buf);
+    freeListInsert(buf);
 }
 
 PUBLIC void *ExtModeCalloc(uint32_T number, uint32_T size)
@@ -355,85 +235,86 @@ PUBLIC void *ExtModeCalloc(uint32_T number, uint32_T size)
 
 PUBLIC void *ExtModeMalloc(uint32_T size)
 {
-    boolean_T keepTrying = false;
-
     MemBufHdr *LocalMemBuf = NULL; /* Requested buffer (NULL if none available). */
-    MemBufHdr *FreeMemBuf = NULL;  /* First free buffer big enough for request. */
+    uint32_T  sizeToAlloc  = 0U;
+
+    /* Initialize the free lists. */
+    if (ArenaStart == NULL) initFreeLists();
 
     /*
      * Must allocate enough space for the requested number of bytes plus the
      * size of the memory buffer header.
      */
-    int sizeToAlloc = size + sizeof(MemBufHdr);
-
-    while (!keepTrying) {
-        keepTrying = true;
-
-        LocalMemBuf = NULL;
-        FreeMemBuf  = NULL;
+    if (size > (uint32_T)(ArenaEnd - ArenaStart)) goto EXIT_POINT;
+    sizeToAlloc = MEM_BUF_HDR_SIZE + (uint32_T)MEM_BUF_ALIGN_UP(size);
 
-        /* Initialize the free queue. */
-        if (FreeQueue == NULL) initFreeQueue();
+    LocalMemBuf = findFreeMemBuf(sizeToAlloc);
+    if (LocalMemBuf == NULL) goto EXIT_POINT;
 
-        /* Find first free packet big enough for our request. */
-        FreeMemBuf = findFirstFreeMemBuf(sizeToAlloc);
+    freeListRemove(LocalMemBuf);
 
-        if (FreeMemBuf == NULL) {
-            /* We couldn't find a free buffer.  Run garbage collection to merge
-               free buffers together and try again. */
-            sortQueue(FreeQueue);
+    /* Return the unused end of the block to the free lists. */
+    if (LocalMemBuf->size - sizeToAlloc >= MEM_BUF_MIN_SIZE) {
+        MemBufHdr *rest = (MemBufHdr *)((char *)LocalMemBuf + sizeToAlloc);
+        MemBufHdr *next;
 
-            FreeMemBuf = findFirstFreeMemBuf(sizeToAlloc);
-        }
+        rest->size        = LocalMemBuf->size - sizeToAlloc;
+        rest->prevSize    = sizeToAlloc;
+        LocalMemBuf->size = sizeToAlloc;
 
-        /* No free buffers are available which satisfy the request. */
-        if (FreeMemBuf == NULL) goto EXIT_POINT;
-
-        /*
-         * Found a free buffer with enough space.  Carve out the exact buffer size
-         * needed from the end of the free buffer.
-         */
-        LocalMemBuf = (MemBufHdr *)(FreeMemBuf->MemBuf +
-                                    FreeMemBuf->size -
-                                    sizeToAlloc);
-
-        /*
-         * The pointer to the free memory must be longword aligned.  If it
-         * is not, adjust the size to allocate and try again.
-         */
-        {
-            int alignBytes = (int)((ptrdiff_t)LocalMemBuf % 4);
-            if (alignBytes) {
-                sizeToAlloc += (4-alignBytes);
-                keepTrying = false;
-            }
+        next = nextMemBuf(rest);
+        if (next != NULL) {
+            next->prevSize = rest->size;
         }
+        freeListInsert(rest);
     }
 
-    /* Set up the new packet's info. */
-    LocalMemBuf->memBufPrev = NULL;
-    LocalMemBuf->memBufNext = NULL;
-    LocalMemBuf->MemBuf     = (char *)LocalMemBuf + sizeof(MemBufHdr);
-    LocalMemBuf->size       = size;
-
-    /* Insert the newly created buffer into the InUseQueue. */
-    inUseQueueInsert(LocalMemBuf);
+    LocalMemBuf->tag = MEM_BUF_TAG_IN_USE;
 
-    /* Update the free packet's size to reflect giving up a piece. */
-    FreeMemBuf->size -= sizeToAlloc;
+    BytesInUse += LocalMemBuf->size;
+    NumInUse++;
+    if (BytesInUse > HighWaterBytes) HighWaterBytes = BytesInUse;
 
   EXIT_POINT:
     if (LocalMemBuf) {
 #ifdef VERBOSE
-        numBytesAllocated += sizeToAlloc;
+        numBytesAllocated += LocalMemBuf->size;
         printf("\nBytes allocated: %d out of %d.\n", numBytesAllocated, EXTMODE_STATIC_SIZE);
 #endif
-        return LocalMemBuf->MemBuf;
+        return (char *)LocalMemBuf + MEM_BUF_HDR_SIZE;
     }
 
+    NumFailed++;
+
 #ifdef VERBOSE
     printf("\nBytes allocated: %d out of %d.", numBytesAllocated+sizeToAlloc, EXTMODE_STATIC_SIZE);
     printf("\nMust increase size of static allocation!\n");
 #endif
     return NULL;
 }
+
+PUBLIC void ExtModeMemGetStats(ExtModeMemStats *stats)
+{
+    int k;
+
+    if (ArenaStart == NULL) initFreeLists();
+
+    stats->arenaSize      = (uint32_T)(ArenaEnd - ArenaStart);
+    stats->bytesInUse     = BytesInUse;
+    stats->highWaterBytes = HighWaterBytes;
+    stats->numInUse       = NumInUse;
+    stats->numFailed      = NumFailed;
+    stats->freeBytes      = 0U;
+    stats->largestFree    = 0U;
+    stats->numFree        = 0U;
+
+    /* Walk the free lists; this is the only operation that does. */
+    for (k = 0; k < NUM_SIZE_CLASSES; k++) {
+        MemBufHdr *buf;
+        for (buf = FreeLists[k]; buf != NULL; buf = buf->memBufNext) {
+            stats->freeBytes += buf->size;
+            stats->numFree++;
+            if (buf->size > stats->largestFree) stats->largestFree = buf->size;
+        }
+    }
+}
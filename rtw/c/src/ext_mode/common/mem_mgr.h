@@ -4,26 +4,51 @@
  * File: mem_mgr.h     
  *
  * Abstract:
+ *  Allocation from a static memory buffer, used for external mode when
+ *  EXTMODE_STATIC is defined (see ext_types.h).
  */
 
 #ifndef __MEM_MGR__
 #define __MEM_MGR__
 
+/*
+ * Header of each block of the static memory buffer. The free list links are
+ * only used while the block is free.
+ */
 struct MemBufHdr {
-    struct MemBufHdr *memBufNext;
-    struct MemBufHdr *memBufPrev;
-    char   *MemBuf;
-    int    size;
+    struct MemBufHdr *memBufNext; /* next free block of the same size class */
+    struct MemBufHdr *memBufPrev; /* previous free block of the size class  */
+    uint32_T         size;        /* block size, including the header       */
+    uint32_T         prevSize;    /* size of the block before, 0 if first   */
+    uint32_T         tag;         /* MEM_BUF_TAG_FREE or MEM_BUF_TAG_IN_USE */
 };
 
 typedef struct MemBufHdr MemBufHdr;
 
+/*
+ * Usage of the static memory buffer. Allocations larger than
+ * largestFree minus the block header fail even if freeBytes is larger; the
+ * fragmentation of the free space is 1 - largestFree/freeBytes.
+ */
+typedef struct ExtModeMemStats_tag {
+    uint32_T arenaSize;      /* bytes managed, including block headers    */
+    uint32_T bytesInUse;     /* bytes in allocated blocks                 */
+    uint32_T highWaterBytes; /* maximum bytesInUse since start            */
+    uint32_T numInUse;       /* number of allocated blocks                */
+    uint32_T freeBytes;      /* bytes in free blocks                      */
+    uint32_T largestFree;    /* size of the largest free block            */
+    uint32_T numFree;        /* number of free blocks                     */
+    uint32_T numFailed;      /* allocations that could not be satisfied   */
+} ExtModeMemStats;
+
 extern void ExtModeFree(void *mem);
 
 extern void *ExtModeMalloc(uint32_T size);
 
 extern void *ExtModeCalloc(uint32_T number, uint32_T size);
 
+extern void ExtModeMemGetStats(ExtModeMemStats *stats);
+
 #endif /* __MEM_MGR__ */
 
 /* [EOF] mem_mgr.h */
@@ -69,6 +69,27 @@ extern SEM_ID commSem;
 extern volatile boolean_T receivedSyncByteE;
 #endif
 
+/*
+ * ExtSetHostPktV() copies the pieces of a send into this buffer, so that they
+ * leave in one rtIOStreamBlockingSend() call instead of one call each. Pieces
+ * that do not fit are sent directly. Define EXTMODE_SENDV_BUFFER_SIZE as 0 to
+ * send every piece on its own, e.g., on targets with little RAM. There is no
+ * buffer unless EXTMODE_HAS_SETHOSTPKTV is defined, since ext_svr only calls
+ * ExtSetHostPktV() then.
+ */
+#ifndef EXTMODE_SENDV_BUFFER_SIZE
+#  if !defined(EXTMODE_HAS_SETHOSTPKTV) || \
+      defined(ARDUINO_ARCH_AVR) || defined(ARDUINO_SAM_DUE) || defined(LEGO)
+#   define EXTMODE_SENDV_BUFFER_SIZE   (0)
+#  else
+#   define EXTMODE_SENDV_BUFFER_SIZE   (4096)
+#  endif
+#endif
+
+#if EXTMODE_SENDV_BUFFER_SIZE > 0
+PRIVATE char sendVBuffer[EXTMODE_SENDV_BUFFER_SIZE];
+#endif
+
 typedef struct ExtUserData_tag {
     boolean_T waitForStartPkt;
     int streamID;
@@ -237,6 +258,90 @@ PUBLIC boolean_T ExtSetHostPkt(
 
 } /* end ExtSetHostPkt */
 
+/* Function: ExtSetHostPktV ====================================================
+ * Abstract:
+ *  Sets (sends) the iovCnt pieces in iov on the comm line, back to back.  The
+ *  total number of bytes set is returned via the 'nBytesSet' parameter.
+ *  EXT_NO_ERROR is returned on success, EXT_ERROR is returned on failure.
+ *
+ *  Pieces that fit are gathered in sendVBuffer, so that a packet header and
+ *  the sections of an upload buffer take a single rtIOStreamBlockingSend()
+ *  call (a single system call for a socket based rtIOStream).
+ *
+ * NOTES:
+ *  o it is always o.k. for this function to block if no room is available
+ */
+PUBLIC boolean_T ExtSetHostPktV(
+    const ExtUserData *UD,
+    const ExtIOVec    *iov,
+    const int         iovCnt,
+    int               *nBytesSet)
+{
+    boolean_T errorCode = EXT_NO_ERROR;
+    int_T     rtIOStreamErrorStatus = RTIOSTREAM_NO_ERROR;
+    int_T     i;
+#if EXTMODE_SENDV_BUFFER_SIZE > 0
+    uint32_T  nBuffered = 0;
+#endif
+    *nBytesSet = 0; /* assume */
+
+    #ifdef VXWORKS
+        semTake(commSem, WAIT_FOREVER);
+    #endif
+
+    for (i = 0; i < iovCnt; i++) {
+        const uint32_T nBytes = (uint32_T) iov[i].nBytes;
+
+#if EXTMODE_SENDV_BUFFER_SIZE > 0
+        /* Send the gathered pieces once the next one does not fit. */
+        if ((nBuffered > 0) && (nBuffered + nBytes > EXTMODE_SENDV_BUFFER_SIZE)) {
+            rtIOStreamErrorStatus = rtIOStreamBlockingSend(UD->streamID,
+                                                           (const void *) sendVBuffer,
+                                                           nBuffered);
+            if (rtIOStreamErrorStatus == RTIOSTREAM_ERROR) goto EXIT_POINT;
+            nBuffered = 0;
+        }
+
+        if (nBytes < EXTMODE_SENDV_BUFFER_SIZE) {
+            (void) memcpy(&sendVBuffer[nBuffered], iov[i].base, nBytes);
+            nBuffered += nBytes;
+            continue;
+        }
+#endif
+        if (nBytes > 0) {
+            rtIOStreamErrorStatus = rtIOStreamBlockingSend(UD->streamID,
+                                                           (const void *) iov[i].base,
+                                                           nBytes);
+            if (rtIOStreamErrorStatus == RTIOSTREAM_ERROR) goto EXIT_POINT;
+        }
+    }
+
+#if EXTMODE_SENDV_BUFFER_SIZE > 0
+    if (nBuffered > 0) {
+        rtIOStreamErrorStatus = rtIOStreamBlockingSend(UD->streamID,
+                                                       (const void *) sendVBuffer,
+                                                       nBuffered);
+        if (rtIOStreamErrorStatus == RTIOSTREAM_ERROR) goto EXIT_POINT;
+    }
+#endif
+
+    for (i = 0; i < iovCnt; i++) {
+        *nBytesSet += iov[i].nBytes;
+    }
+
+  EXIT_POINT:
+    if (rtIOStreamErrorStatus == RTIOSTREAM_ERROR) {
+        errorCode = EXT_ERROR;
+    }
+
+    #ifdef VXWORKS
+        semGive(commSem);
+    #endif
+
+    return errorCode;
+
+} /* end ExtSetHostPktV */
+
 /* Function: ExtGetHostPkt =====================================================
  * Abstract:
  *  Attempts to get the specified number of bytes from the comm line.  The
@@ -0,0 +1,276 @@
+/* Copyright 2019 The MathWorks, Inc. */
+
+/*
+ * File: tExtDeltaRoundTrip.c
+ *
+ * Abstract:
+ *  Round trip test of the external mode delta encoding (ext_delta_utils.c).
+ *  Time points are encoded on the target side with UploadDeltaEncodeTimePoint
+ *  and decoded on the host side with ExtDeltaDecode, and the decoded data
+ *  must equal the uploaded signals byte for byte.  The cases are
+ *
+ *   - a key frame (the first time point, encoded against zeros),
+ *   - a zero delta (the same time point again),
+ *   - a full change (every word changes),
+ *   - unchanged and changed runs longer than EXT_DELTA_MAX_RUN words,
+ *   - systems whose size is not a multiple of the word size, gathered from
+ *     sections that are not word aligned; bytes next to the sections must
+ *     not reach the zero padding,
+ *   - a disabled system, which is not encoded,
+ *   - the data of each system without its last byte, which ExtDeltaDecode
+ *     must reject.
+ *
+ *  The test includes updown.c to reach its PRIVATE functions.  Build and run
+ *  from the ext_mode/common directory with a generated rtwtypes.h, e.g.:
+ *
+ *   cc -I. -I.. -I../.. -I<builddir> -I<matlabroot>/extern/include
+ *      -I<matlabroot>/simulink/include -DEXT_MODE test/tExtDeltaRoundTrip.c
+ *      && ./a.out
+ *
+ *  Returns 0 if all cases pass.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXT_DELTA_DECODER
+#include "updown.c"
+
+/* The upload server of ext_svr.c is not part of the test */
+boolean_T SendPktToHost(const ExtModeAction action,
+                        const int           size,
+                        const char          *data)
+{
+    (void)action;
+    (void)size;
+    (void)data;
+    return(false);
+}
+
+#define T_NUM_SYS       (3)
+#define T_SYS_DISABLED  (2)
+#define T_NUM_STEPS     (6)
+
+/* Bytes of each system; none is a multiple of 4 except the disabled one */
+static const int_T tSectionBytes[T_NUM_SYS][2] = {
+    { 5, 1198 },     /* 1203 bytes: 301 words, longer than EXT_DELTA_MAX_RUN */
+    { 3, 0 },        /* 3 bytes: less than one word                         */
+    { 8, 0 }
+};
+
+static uint8_T        tSignals[T_NUM_SYS][1300];
+static UploadSection  tSections[T_NUM_SYS][2];
+static UploadMap      tMaps[T_NUM_SYS];
+static UploadMap      *tMapTables[T_NUM_SYS][1];
+static int8_T         tEnableStates[T_NUM_SYS];
+static SysUploadTable tSysTables[T_NUM_SYS];
+static uint8_T        tHostRefs[T_NUM_SYS][4*EXT_DELTA_NUM_WORDS(1300)];
+
+/* Set up one system with one or two sections of tSignals[i] for tid 0 */
+static void tInitSystem(int_T i)
+{
+    UploadMap *map    = &tMaps[i];
+    int_T     nSect   = (tSectionBytes[i][1] > 0) ? 2 : 1;
+    int_T     nWords;
+
+    /* The sections are one byte apart, so they are not merged and the
+     * second one starts at an odd address */
+    tSections[i][0].start  = &tSignals[i][0];
+    tSections[i][0].nBytes = tSectionBytes[i][0];
+    tSections[i][1].start  = &tSignals[i][tSectionBytes[i][0] + 1];
+    tSections[i][1].nBytes = tSectionBytes[i][1];
+
+    map->nSections     = nSect;
+    map->sections      = tSections[i];
+    map->nCopySections = nSect;
+    map->copySections  = tSections[i];
+    map->nBytes        = tSectionBytes[i][0] + tSectionBytes[i][1];
+
+    nWords        = EXT_DELTA_NUM_WORDS(map->nBytes);
+    map->deltaCur = (uint32_T *)calloc(nWords, sizeof(uint32_T));
+    map->deltaRef = (uint32_T *)calloc(nWords, sizeof(uint32_T));
+
+    tMapTables[i][0]          = map;
+    tEnableStates[i]          = (i == T_SYS_DISABLED) ? SUBSYS_RAN_BC_DISABLE :
+                                                        SUBSYS_RAN_BC_ENABLE;
+    tSysTables[i].enableState = &tEnableStates[i];
+    tSysTables[i].uploadMap   = tMapTables[i];
+}
+
+/* Change the signals for step */
+static void tUpdateSignals(int_T step)
+{
+    int_T i, j;
+
+    for (i = 0; i < T_NUM_SYS; i++) {
+        uint8_T *s = tSignals[i];
+        int_T   n  = (int_T)sizeof(tSignals[i]);
+
+        switch (step) {
+          case 0:                                  /* key frame */
+            for (j = 0; j < n; j++) s[j] = (uint8_T)(7*j + i + 1);
+            break;
+          case 1:                                  /* zero delta */
+            break;
+          case 2:                                  /* full change */
+            for (j = 0; j < n; j++) s[j] = (uint8_T)~s[j];
+            break;
+          case 3:                                  /* long runs: 200 bytes */
+            for (j = 600; j < 800; j++) s[j]++;    /* change, rest unchanged */
+            break;
+          case 4:                                  /* only bytes that are */
+            s[tSectionBytes[i][0]]++;              /* not uploaded: the gap */
+            s[tSectionBytes[i][0] + tSectionBytes[i][1] + 1]++; /* and end */
+            break;
+          default:                                 /* every other word */
+            for (j = 0; j < n; j += 8) s[j] ^= 0x5A;
+            break;
+        }
+    }
+}
+
+/* The host side: decode encBuf into tHostRefs and compare with the signals */
+static int tDecodeAndCheck(const BdUploadInfo *info, const char_T *encBuf,
+                           int_T encSize, int_T step)
+{
+    const char_T *src  = encBuf;
+    int_T        nSeen = 0;
+
+    while (src < encBuf + encSize) {
+        int32_T         sysIdx;
+        const UploadMap *map;
+        int_T           nWords, used;
+        const uint8_T   *host;
+        uint8_T         scratch[sizeof(tHostRefs[0])];
+        int_T           k, off = 0;
+
+        (void)memcpy(&sysIdx, src, sizeof(int32_T));
+        src += sizeof(int32_T);
+        if (sysIdx < 0 || sysIdx >= info->nSys || sysIdx == T_SYS_DISABLED) {
+            printf("step %d: bad system index %d\n", (int)step, (int)sysIdx);
+            return 1;
+        }
+        map    = tMaps + sysIdx;
+        nWords = EXT_DELTA_NUM_WORDS(map->nBytes);
+
+        (void)memcpy(scratch, tHostRefs[sysIdx], 4*nWords);
+        used = ExtDeltaDecode(src, (int_T)(encBuf + encSize - src),
+                              tHostRefs[sysIdx], nWords);
+        if (used < 0) {
+            printf("step %d: system %d does not decode\n", (int)step,
+                   (int)sysIdx);
+            return 1;
+        }
+
+        /* The data of the system without its last byte must be rejected */
+        if (ExtDeltaDecode(src, used-1, scratch, nWords) != -1) {
+            printf("step %d: system %d truncated data was accepted\n",
+                   (int)step, (int)sysIdx);
+            return 1;
+        }
+        src += used;
+        nSeen++;
+
+        host = tHostRefs[sysIdx];
+        for (k = 0; k < map->nCopySections; k++) {
+            const UploadSection *sect = &map->copySections[k];
+
+            if (memcmp(host + off, sect->start, sect->nBytes) != 0) {
+                printf("step %d: system %d section %d differs\n", (int)step,
+                       (int)sysIdx, (int)k);
+                return 1;
+            }
+            off += sect->nBytes;
+        }
+        for (; off < 4*nWords; off++) {
+            if (host[off] != 0) {
+                printf("step %d: system %d padding is not zero\n", (int)step,
+                       (int)sysIdx);
+                return 1;
+            }
+        }
+    }
+    if (src != encBuf + encSize || nSeen != T_NUM_SYS-1) {
+        printf("step %d: %d systems decoded\n", (int)step, (int)nSeen);
+        return 1;
+    }
+    return 0;
+}
+
+/* Expected encoded size for the cases with a known size */
+static int tCheckSize(int_T step, int_T encSize)
+{
+    int_T nWords0  = EXT_DELTA_NUM_WORDS(tMaps[0].nBytes);
+    int_T nWords1  = EXT_DELTA_NUM_WORDS(tMaps[1].nBytes);
+    int_T expected = -1;
+
+    switch (step) {
+      case 1:  /* unchanged runs of at most EXT_DELTA_MAX_RUN words */
+      case 4:
+        expected = 2*(int_T)sizeof(int32_T) +
+                   (nWords0 + EXT_DELTA_MAX_RUN-1) / EXT_DELTA_MAX_RUN +
+                   (nWords1 + EXT_DELTA_MAX_RUN-1) / EXT_DELTA_MAX_RUN;
+        break;
+      case 2:  /* the worst case */
+        expected = 2*(int_T)sizeof(int32_T) +
+                   EXT_DELTA_MAX_ENCODED_SIZE(nWords0) +
+                   EXT_DELTA_MAX_ENCODED_SIZE(nWords1);
+        break;
+      default:
+        break;
+    }
+    if (expected >= 0 && encSize != expected) {
+        printf("step %d: %d bytes encoded, expected %d\n", (int)step,
+               (int)encSize, (int)expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    BdUploadInfo info;
+    char_T       *encBuf;
+    int_T        encBufSize = 0;
+    int_T        i, step;
+    int          nFailed = 0;
+
+    (void)memset(&info, 0, sizeof(info));
+    info.nSys      = T_NUM_SYS;
+    info.sysTables = tSysTables;
+
+    for (i = 0; i < T_NUM_SYS; i++) {
+        tInitSystem(i);
+        encBufSize += (int_T)sizeof(int32_T) +
+            EXT_DELTA_MAX_ENCODED_SIZE(EXT_DELTA_NUM_WORDS(tMaps[i].nBytes));
+    }
+    encBuf = (char_T *)malloc(encBufSize);
+    (void)memset(tHostRefs, 0, sizeof(tHostRefs));
+
+    for (step = 0; step < T_NUM_STEPS; step++) {
+        int_T encSize;
+
+        tUpdateSignals(step);
+        encSize = UploadDeltaEncodeTimePoint(&info, 0, encBuf);
+        if (encSize > encBufSize) {
+            printf("step %d: encoded data overflows its buffer\n", (int)step);
+            return 1;
+        }
+        nFailed += tCheckSize(step, encSize);
+        nFailed += tDecodeAndCheck(&info, encBuf, encSize, step);
+        UploadDeltaUpdateRefs(&info, 0, true);
+        printf("step %d: %d bytes\n", (int)step, (int)encSize);
+    }
+
+    for (i = 0; i < T_NUM_SYS; i++) {
+        free(tMaps[i].deltaCur);
+        free(tMaps[i].deltaRef);
+    }
+    free(encBuf);
+
+    printf("%s\n", nFailed ? "FAILED" : "PASSED");
+    return nFailed ? 1 : 0;
+}
+
+/* [EOF] tExtDeltaRoundTrip.c */
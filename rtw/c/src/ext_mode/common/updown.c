@@ -39,7 +39,36 @@
  *
  * If you define EXTMODE_PROTECT_CRITICAL_REGIONS, you need to define the 
  * other above preprocessor defines, otherwise they are not required.
+ *
+ * Each circular buffer is a single producer, single consumer ring.  The
+ * model (UploadBufAddTimePoint) moves the head; who moves the tail follows
+ * the trigger state:
+ *  o TRIGGER_ARMED with a pre-trigger: the model drops the oldest time point
+ *    itself (MOVE_TAIL_ONESTEP).  The upload server does not read the ring.
+ *  o TRIGGER_FIRED and TRIGGER_TERMINATING: only the upload server moves the
+ *    tail (UploadBufDataSent), after the data has been sent.
+ *  o TRIGGER_UNARMED and TRIGGER_HOLDING_OFF: nobody writes the ring, and
+ *    UploadArmTrigger resets the head and tail before arming.
+ * The thread that changes the trigger state hands over the ring, and the
+ * trigger count, with the new state, so the state is written last, after a
+ * barrier, and read first, before one.  Within a state, the data of a time
+ * point must be in memory before the head that covers it, and the host must
+ * be done with sent data before the tail moves past it:
+ * EXTMODE_MEMORY_BARRIER: orders the memory accesses on either side of it.
+ *      It defaults to a full fence when the upload server runs in its own
+ *      thread (EXTMODE_SERVER_THREAD, see ext_work.c) and to a compiler
+ *      barrier otherwise.
  */
+#ifndef EXTMODE_MEMORY_BARRIER
+    #if defined(EXTMODE_SERVER_THREAD)
+        #define EXTMODE_MEMORY_BARRIER() __sync_synchronize()
+    #elif defined(__GNUC__)
+        #define EXTMODE_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+    #else
+        #define EXTMODE_MEMORY_BARRIER() /* do nothing */
+    #endif
+#endif
+
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
     #if !defined (EXTMODE_INTERRUPT_INC_HDR) || \
         !defined (EXTMODE_ENABLE_INTERRUPTS) || \
@@ -249,12 +278,113 @@ PUBLIC void SetParam(RTWExtModeInfo  *ei, const char *pbuf)
 #endif /* ifndef EXTMODE_DISABLEPARAMETERTUNING */
 
 
+#if !defined(EXTMODE_DISABLEPARAMETERTUNING) && defined(EXTMODE_STEP_ATOMIC_PARAMS)
+/*
+ * EXT_SETPARAM packets waiting to be installed.  This is a single producer,
+ * single consumer queue: the packet server (StageSetParam) only moves the
+ * head and the model (CommitStagedParams) only moves the tail.  Only the
+ * packet server allocates the packet copies; it reuses a slot once the
+ * model has moved the tail past it.
+ */
+typedef struct StagedParams_tag {
+    char_T *pkt;
+    int_T  bufSize;
+} StagedParams;
+
+PRIVATE StagedParams      stagedParams[EXTMODE_PARAM_QUEUE_LENGTH];
+PRIVATE RTWExtModeInfo    *stagedParamsEi  = NULL;
+PRIVATE volatile uint32_T stagedParamsHead = 0U;
+PRIVATE volatile uint32_T stagedParamsTail = 0U;
+
+
+/* Function: StageSetParam =====================================================
+ * Queue the EXT_SETPARAM packet pbuf (see SetParam) of nBytes bytes, to be
+ * installed as a whole by the next call to CommitStagedParams.  Return
+ * EXT_ERROR if EXTMODE_PARAM_QUEUE_LENGTH packets are already waiting or
+ * there is no memory for the copy.
+ */
+PUBLIC boolean_T StageSetParam(RTWExtModeInfo *ei,
+                               const char     *pbuf,
+                               int_T          nBytes)
+{
+    uint32_T     head = stagedParamsHead;
+    StagedParams *slot;
+
+    if ((head - stagedParamsTail) >= EXTMODE_PARAM_QUEUE_LENGTH) {
+        return(EXT_ERROR);
+    }
+    EXTMODE_MEMORY_BARRIER();
+
+    slot = &stagedParams[head % EXTMODE_PARAM_QUEUE_LENGTH];
+    if (slot->bufSize < nBytes) {
+        free(slot->pkt);
+        slot->bufSize = 0;
+        slot->pkt     = (char_T *)malloc(nBytes);
+        if (slot->pkt == NULL) return(EXT_ERROR);
+        slot->bufSize = nBytes;
+    }
+    (void)memcpy(slot->pkt, pbuf, nBytes);
+    stagedParamsEi = ei;
+
+    /* Publish the packet only once it is copied. */
+    EXTMODE_MEMORY_BARRIER();
+    stagedParamsHead = head + 1U;
+    return(EXT_NO_ERROR);
+} /* end StageSetParam */
+
+
+/* Function: CommitStagedParams ================================================
+ * Install the staged EXT_SETPARAM packets, oldest first.  Called by the model
+ * between base rate steps; there are at most EXTMODE_PARAM_QUEUE_LENGTH.
+ */
+PUBLIC void CommitStagedParams(void)
+{
+    uint32_T head = stagedParamsHead;
+    uint32_T tail = stagedParamsTail;
+
+    if (head == tail) return;
+    EXTMODE_MEMORY_BARRIER();
+
+    for (; tail != head; tail++) {
+        SetParam(stagedParamsEi,
+                 stagedParams[tail % EXTMODE_PARAM_QUEUE_LENGTH].pkt);
+    }
+
+    /* The packet server may reuse the slots once they are installed. */
+    EXTMODE_MEMORY_BARRIER();
+    stagedParamsTail = tail;
+} /* end CommitStagedParams */
+
+
+/* Function: FreeStagedParams ==================================================
+ * Drop the staged packets that were not installed and free the queue memory.
+ * Neither the packet server nor the model may be running.
+ */
+PUBLIC void FreeStagedParams(void)
+{
+    int_T i;
+
+    for (i=0; i<EXTMODE_PARAM_QUEUE_LENGTH; i++) {
+        free(stagedParams[i].pkt);
+        stagedParams[i].pkt     = NULL;
+        stagedParams[i].bufSize = 0;
+    }
+    stagedParamsHead = 0U;
+    stagedParamsTail = 0U;
+} /* end FreeStagedParams */
+#endif /* !EXTMODE_DISABLEPARAMETERTUNING && EXTMODE_STEP_ATOMIC_PARAMS */
+
+
 /******************************************************************************
  * Parameter Upload                                                           *
  ******************************************************************************/
 #include "upsup_public.h"
 #define DUMP_PKT (0)
 
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+#include "ext_delta_utils.c"
+#endif
+
 
 /*=============================================================================
  * Circular buffer stuff.
@@ -270,9 +400,12 @@ typedef struct BufMemList_tag {
 } BufMemList;
 
 
+/*
+ * head == tail means the buffer is empty.  UploadBufAssignMem always leaves
+ * one byte free, so that a full buffer never looks empty, and UploadBufInit
+ * allocates that byte on top of the size requested by the host.
+ */
 typedef struct CircularBuf_tag {
-    volatile int_T    empty;
-
     int_T    bufSize;
     char_T   *buf;
     
@@ -284,6 +417,10 @@ typedef struct CircularBuf_tag {
     struct {
         int_T count;
     } preTrig;
+
+    uint32_T nDropped; /* time points that did not fit, written by the model */
+
+    char_T   *encBuf;  /* delta encoded time point, NULL if not encoding    */
 } CircularBuf;
 
 
@@ -325,6 +462,20 @@ typedef struct UploadMap_tag {
     UploadSection *sections;
 
     int_T nBytes;  /* total number of bytes in this map */
+
+    /*
+     * The sections merged where they are adjacent in memory, in the same
+     * order. A time point is gathered from these.
+     */
+    int32_T    nCopySections;
+    UploadSection *copySections;
+
+    /*
+     * Delta encoding only: the time point being encoded and the one last
+     * uploaded, gathered as EXT_DELTA_NUM_WORDS(nBytes) words.
+     */
+    uint32_T   *deltaCur;
+    uint32_T   *deltaRef;
 } UploadMap;
 
 
@@ -386,6 +537,10 @@ struct BdUploadInfo_tag {
     BufMemList     bufMemList; /* list of buffer memory holding data to upload */
 
     TriggerInfo  trigInfo;
+
+    uint32_T     nDropped;     /* time points dropped by terminated sessions  */
+
+    ExtUploadEncoding encoding; /* used from the next EXT_SELECT_SIGNALS on  */
 };
 
 
@@ -409,6 +564,45 @@ struct BdUploadInfo_tag {
 #define NUM_UPINFOS   2
 static  BdUploadInfo  uploadInfoArray[NUM_UPINFOS];
 
+#ifdef EXTMODE_SERVER_THREAD
+/*
+ * Number of model calls into the upload code in progress (see
+ * UploadModelCallBegin), so that the server thread does not free the upload
+ * data while the model is using it.
+ */
+PRIVATE volatile int_T nModelCalls = 0;
+
+
+/* Function ====================================================================
+ * Called by the model around its calls into the upload code (see ext_svr.c)
+ * when the server runs in its own thread.  Neither call waits.
+ */
+PUBLIC void UploadModelCallBegin(void)
+{
+    (void)__sync_fetch_and_add(&nModelCalls, 1);
+} /* end UploadModelCallBegin */
+
+PUBLIC void UploadModelCallEnd(void)
+{
+    (void)__sync_fetch_and_sub(&nModelCalls, 1);
+} /* end UploadModelCallEnd */
+
+
+/* Function ====================================================================
+ * Wait until no model call into the upload code is in progress.  The caller
+ * must first move the trigger state to one in which the model does not touch
+ * the data to be freed; the model calls are short, so this does not spin for
+ * long.
+ */
+PUBLIC void UploadWaitForModelCalls(void)
+{
+    __sync_synchronize();
+    while (nModelCalls != 0) {
+        /* spin */
+    }
+} /* end UploadWaitForModelCalls */
+#endif
+
 
 /* Function ====================================================================
  * Dump the signal selection packet (EXT_SELECT_SIGNALS).  The packet looks
@@ -714,6 +908,41 @@ PRIVATE void InitUploadSection(
 } /* end InitUploadSection */
 
 
+/* Function ====================================================================
+ * Precompute the layout of an UploadMap in a time point: merge the sections
+ * that are adjacent in memory (consecutive signals of the block I/O or dwork
+ * structure usually are), so that UploadBufAddTimePoint copies each run of
+ * contiguous signals with one memcpy.
+ */
+PRIVATE boolean_T InitUploadMapCopySections(UploadMap *map)
+{
+    int32_T section;
+
+    assert(map->copySections == NULL);
+
+    map->nCopySections = 0;
+    if (map->nSections == 0) return(EXT_NO_ERROR);
+
+    map->copySections = (UploadSection *)calloc(map->nSections, sizeof(UploadSection));
+    if (map->copySections == NULL) return(EXT_ERROR);
+
+    for (section=0; section<map->nSections; section++) {
+        const UploadSection *sect = &map->sections[section];
+        UploadSection       *last = &map->copySections[map->nCopySections-1];
+
+        if (sect->nBytes == 0) continue;
+
+        if ((map->nCopySections > 0) &&
+            (((char_T *)last->start + last->nBytes) == (char_T *)sect->start)) {
+            last->nBytes += sect->nBytes;
+        } else {
+            map->copySections[map->nCopySections++] = *sect;
+        }
+    }
+    return(EXT_NO_ERROR);
+} /* end InitUploadMapCopySections */
+
+
 /* Function ====================================================================
  * Initialize a SysUploadTable.  The callerBufPtr points to the current place in
  * the EXT_SELECT_SIGNALS pkt which should be the enableIdx field.  This
@@ -803,6 +1032,9 @@ PRIVATE boolean_T InitSysUploadTable(
             /* keep track of total number of bytes in this map */
             map->nBytes += uploadSection->nBytes;
         }
+
+        error = InitUploadMapCopySections(map);
+        if (error) goto EXIT_POINT;
     }
     
 EXIT_POINT:
@@ -827,9 +1059,9 @@ PRIVATE boolean_T UploadBufInit(CircularBuf *circBuf, int32_T size)
         error = EXT_ERROR; goto EXIT_POINT;
     }
 
-    circBuf->empty = true;
     if (size > 0) {
         assert(circBuf->buf == NULL);
+        size++; /* the byte that is always left free */
         circBuf->buf = (char_T *)malloc(size);
         if (circBuf->buf == NULL) {
             error = EXT_ERROR; goto EXIT_POINT;
@@ -847,6 +1079,46 @@ PRIVATE boolean_T UploadBufInit(CircularBuf *circBuf, int32_T size)
 EXIT_POINT:
     return(error);
 } /* end UploadBufInit */
+
+
+/* Function ====================================================================
+ * Allocate what delta encoding needs: the words of the current and previous
+ * time point of each UploadMap, and for each tid a buffer for an encoded time
+ * point.  The references start as zeros, like after UploadArmTrigger.
+ */
+PRIVATE boolean_T UploadDeltaInit(BdUploadInfo *uploadInfo, int_T numSampTimes)
+{
+    int_T tid;
+
+    for (tid=0; tid<numSampTimes; tid++) {
+        int_T       i;
+        int_T       encBufSize = 0;
+        CircularBuf *circBuf   = &uploadInfo->circBufs[tid];
+
+        for (i=0; i<uploadInfo->nSys; i++) {
+            UploadMap *map = uploadInfo->sysTables[i].uploadMap[tid];
+            int_T     nWords;
+
+            if (map == NULL) continue;
+
+            nWords      = EXT_DELTA_NUM_WORDS(map->nBytes);
+            encBufSize += sizeof(int32_T) + EXT_DELTA_MAX_ENCODED_SIZE(nWords);
+            if (nWords == 0) continue;
+
+            map->deltaCur = (uint32_T *)calloc(nWords, sizeof(uint32_T));
+            map->deltaRef = (uint32_T *)calloc(nWords, sizeof(uint32_T));
+            if ((map->deltaCur == NULL) || (map->deltaRef == NULL)) {
+                return(EXT_ERROR);
+            }
+        }
+
+        if ((circBuf->bufSize > 0) && (encBufSize > 0)) {
+            circBuf->encBuf = (char_T *)malloc(encBufSize);
+            if (circBuf->encBuf == NULL) return(EXT_ERROR);
+        }
+    }
+    return(EXT_NO_ERROR);
+} /* end UploadDeltaInit */
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 
@@ -942,6 +1214,18 @@ PUBLIC void UploadLogInfoTerm(int32_T upInfoIdx, int_T numSampTimes)
 
     if (uploadInfo->nSys == 0) return; /* Nothing to terminate */
 
+#ifdef EXTMODE_SERVER_THREAD
+    /*
+     * Keep new model calls out of this upInfo and wait for those in progress
+     * to leave.  A call in progress may still re-arm the trigger, so repeat
+     * until the state stays unarmed.
+     */
+    do {
+        uploadInfo->trigInfo.state = TRIGGER_UNARMED;
+        UploadWaitForModelCalls();
+    } while (uploadInfo->trigInfo.state != TRIGGER_UNARMED);
+#endif
+
     /*
      * Free fields of the sysUpload tables and then the table itself.
      */
@@ -953,6 +1237,9 @@ PUBLIC void UploadLogInfoTerm(int32_T upInfoIdx, int_T numSampTimes)
             if (uploadMap[tid] != NULL) {
                 /* Free fields of uploadMap. */
                 free(uploadMap[tid]->sections);
+                free(uploadMap[tid]->copySections);
+                free(uploadMap[tid]->deltaCur);
+                free(uploadMap[tid]->deltaRef);
 
                 /* Free the uploadMap. */
                 free(uploadMap[tid]);
@@ -967,7 +1254,9 @@ PUBLIC void UploadLogInfoTerm(int32_T upInfoIdx, int_T numSampTimes)
     /* Free circular buf fields and bufMemLists. */
     if (uploadInfo->circBufs) {
         for (i=0; i<numSampTimes; i++) {
+            uploadInfo->nDropped += uploadInfo->circBufs[i].nDropped;
             free(uploadInfo->circBufs[i].buf);
+            free(uploadInfo->circBufs[i].encBuf);
         }
         free(uploadInfo->circBufs);
     }
@@ -987,6 +1276,55 @@ PUBLIC void UploadLogInfoTerm(int32_T upInfoIdx, int_T numSampTimes)
 } /* end UploadLogInfoTerm */
 
 
+/* Function ====================================================================
+ * Return the number of time points that did not fit in the upload buffers of
+ * this upInfo since the program started.  An overflow during a trigger event
+ * drops one time point and terminates the event; during pre-triggering the
+ * time point is dropped silently.
+ */
+PUBLIC uint32_T UploadGetNumDropped(int32_T upInfoIdx, int_T numSampTimes)
+{
+    int_T        tid;
+    BdUploadInfo *uploadInfo = &uploadInfoArray[upInfoIdx];
+    uint32_T     nDropped    = uploadInfo->nDropped;
+
+    if (uploadInfo->circBufs != NULL) {
+        for (tid=0; tid<numSampTimes; tid++) {
+            nDropped += uploadInfo->circBufs[tid].nDropped;
+        }
+    }
+    return(nDropped);
+} /* end UploadGetNumDropped */
+
+
+/* Function ====================================================================
+ * Select the encoding of the upload data of this upInfo, as requested by the
+ * EXT_SET_UPLOAD_ENCODING packet.  It applies from the next EXT_SELECT_SIGNALS
+ * packet on, which allocates what it needs.  Return the encoding that will
+ * be used: EXT_UPLOAD_ENCODING_RAW if the one requested is not supported, or
+ * EXT_UPLOAD_ENCODING_ERROR if upInfoIdx is out of range.
+ */
+PUBLIC int32_T UploadSetEncoding(int32_T upInfoIdx, int32_T encoding)
+{
+    BdUploadInfo *uploadInfo;
+
+    if ((upInfoIdx < 0) || (upInfoIdx >= NUM_UPINFOS)) {
+        return((int32_T)EXT_UPLOAD_ENCODING_ERROR);
+    }
+    uploadInfo = &uploadInfoArray[upInfoIdx];
+
+    switch(encoding) {
+    case EXT_UPLOAD_ENCODING_DELTA_RLE:
+        uploadInfo->encoding = EXT_UPLOAD_ENCODING_DELTA_RLE;
+        break;
+    default:
+        uploadInfo->encoding = EXT_UPLOAD_ENCODING_RAW;
+        break;
+    }
+    return((int32_T)uploadInfo->encoding);
+} /* end UploadSetEncoding */
+
+
 /* Function ====================================================================
  * Prepare for final flush of buffers.  This involves setting the trigger
  * state to appropriate values.
@@ -1092,6 +1430,11 @@ PUBLIC boolean_T UploadLogInfoInit(RTWExtModeInfo *ei,
         nActiveTids += (size != 0);
     }
 
+    if (uploadInfo->encoding == EXT_UPLOAD_ENCODING_DELTA_RLE) {
+        error = UploadDeltaInit(uploadInfo, numSampTimes);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+    }
+
     /*
      * Initialize/Allocate the bufMemLists - these are used by
      * ext_svr to pull the appropriate data out of the buffers and send it
@@ -1242,6 +1585,7 @@ EXIT_POINT:
  */
 PUBLIC void UploadArmTrigger(int32_T upInfoIdx, int_T numSampTimes)
 {
+    int_T   i;
     int_T   tid;
     BdUploadInfo *uploadInfo = &uploadInfoArray[upInfoIdx];
 
@@ -1261,7 +1605,23 @@ PUBLIC void UploadArmTrigger(int32_T upInfoIdx, int_T numSampTimes)
             circBuf->tail = circBuf->buf;
 
             circBuf->newTail = NULL;
-            circBuf->empty   = true;
+        }
+    }
+
+    /*
+     * Delta encoding starts over from zeros, as does the host on arming or at
+     * the end of an event.
+     */
+    for (i=0; i<uploadInfo->nSys; i++) {
+        UploadMap **uploadMap = uploadInfo->sysTables[i].uploadMap;
+
+        for (tid=0; tid<numSampTimes; tid++) {
+            const UploadMap *map = uploadMap[tid];
+
+            if ((map != NULL) && (map->deltaRef != NULL)) {
+                (void)memset(map->deltaRef, 0,
+                        EXT_DELTA_NUM_WORDS(map->nBytes)*sizeof(uint32_T));
+            }
         }
     }
 
@@ -1278,8 +1638,10 @@ PUBLIC void UploadArmTrigger(int32_T upInfoIdx, int_T numSampTimes)
 
     /* 
      * Re-arm after all initialization.  Make sure that trigInfo.state is
-     * set last since this routine may be interrupted.
+     * set last since this routine may be interrupted, or run by the upload
+     * server while the model steps.
      */
+    EXTMODE_MEMORY_BARRIER();
     uploadInfo->trigInfo.state = TRIGGER_ARMED;
 
 } /* end UploadArmTrigger */
@@ -1363,24 +1725,23 @@ PUBLIC void UploadBufDataSent(const int_T tid, int32_T upInfoIdx)
 
     host_upstatus_is_uploading = true;
     
-    /* Move the tail forward. */
-    circBuf->tail = circBuf->newTail;
-        
+    /*
+     * Move the tail forward.  The data has been sent, so the model may now
+     * reuse the space.
+     */
+    EXTMODE_MEMORY_BARRIER();
+
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
     /* 
      * disable interrupts around this critical region. We need to 
-     * guarantee that reading the head pointer is an atomic 
+     * guarantee that writing the tail pointer is an atomic 
      * operation.
      */
     EXTMODE_DISABLE_INTERRUPTS;
 #endif
-    
-    /* 
-     * Since we are moving the tail forward, we know that head == tail
-     * represents an empty buffer and not a full buffer.
-     */
-    circBuf->empty = (circBuf->tail == circBuf->head);
-    
+
+    circBuf->tail = circBuf->newTail;
+
 #ifdef EXTMODE_PROTECT_CRITICAL_REGIONS
     /* re-enable interrupts */
     EXTMODE_ENABLE_INTERRUPTS;
@@ -1412,17 +1773,41 @@ PUBLIC void UploadBufDataSent(const int_T tid, int32_T upInfoIdx)
 
 
 /*
- * Macro =======================================================================
- * Copy data into the circular buffer.
+ * Write position in the space assigned to a time point by UploadBufAssignMem.
+ * The space is one section, or two if it wraps around the end of the buffer.
+ */
+typedef struct BufWriter_tag {
+    char_T *dst;      /* next byte to write                        */
+    int_T  nLeft;     /* bytes left in the current section         */
+    char_T *section2; /* section after the wrap, or NULL           */
+    int_T  nBytes2;
+} BufWriter;
+
+
+/* Function ====================================================================
+ * Copy data to a BufWriter, moving on to the second section at the wrap.
  */
-#define CIRCBUF_COPY_DATA(bufMem, data)                         \
-{                                                               \
-    (void)memcpy((bufMem).section1, (data), (bufMem).nBytes1);  \
-    if ((bufMem).section2 != NULL) {                            \
-        char *tmp = ((char *)(data)) + (bufMem).nBytes1;        \
-        (void)memcpy((bufMem).section2, tmp, (bufMem).nBytes2); \
-    }                                                           \
-} /* end CIRCBUF_COPY_DATA */
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+PRIVATE void UploadBufWrite(BufWriter *writer, const void *data, int_T nBytes)
+{
+    if (nBytes > writer->nLeft) {
+        int_T nBytes1 = writer->nLeft;
+
+        assert(writer->section2 != NULL);
+        (void)memcpy(writer->dst, data, nBytes1);
+        data   = (const char_T *)data + nBytes1;
+        nBytes -= nBytes1;
+
+        writer->dst      = writer->section2;
+        writer->nLeft    = writer->nBytes2;
+        writer->section2 = NULL;
+        writer->nBytes2  = 0;
+    }
+    (void)memcpy(writer->dst, data, nBytes);
+    writer->dst   += nBytes;
+    writer->nLeft -= nBytes;
+} /* end UploadBufWrite */
+#endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 
 /* Function ====================================================================
@@ -1437,15 +1822,16 @@ PUBLIC void UploadBufDataSent(const int_T tid, int32_T upInfoIdx)
  *       This function modifies tmpHead to point at the next available 
  *       location.
  *
- *       It is possible for tmpHead to equal the tail upon entry to this
- *       function.  This does not necessarily mean that the buffer is
- *       empty (unwrapped).  It could also mean that the buffer is exactly
- *       full (this is considered as wrapped).
+ *       tail is the tail as read once by the caller; the upload server may
+ *       move the real tail forward meanwhile, which only frees more space.
+ *       One byte is always left free, so tmpHead == tail means that the
+ *       buffer is empty (unwrapped).
  */
 #ifndef EXTMODE_DISABLESIGNALMONITORING
 PRIVATE boolean_T UploadBufAssignMem(
     CircularBuf  *circBuf,
     int_T        nBytesToAdd,
+    const char   *tail,
     char         **tmpHead,   /* in-out */
     BufMem       *bufMem)     /* out */
 {
@@ -1453,9 +1839,9 @@ PRIVATE boolean_T UploadBufAssignMem(
     boolean_T   overFlow  = false;
     char        *end      = circBuf->buf + circBuf->bufSize; /* 1 passed end */
 
-    if ((*tmpHead > circBuf->tail) || circBuf->empty) {
+    if (*tmpHead >= tail) {
         /* buffer not wrapped */
-        nBytesLeft = (int_T)((end - *tmpHead) + (circBuf->tail - circBuf->buf));
+        nBytesLeft = (int_T)((end - *tmpHead) + (tail - circBuf->buf)) - 1;
 
         if (nBytesLeft < nBytesToAdd) {
             overFlow = true;
@@ -1483,7 +1869,7 @@ PRIVATE boolean_T UploadBufAssignMem(
         }  
     } else {
         /* wrapped */
-        nBytesLeft = (int_T)(circBuf->tail - *tmpHead);
+        nBytesLeft = (int_T)(tail - *tmpHead) - 1;
         if (nBytesLeft < nBytesToAdd) {
             overFlow = true;
             goto EXIT_POINT;
@@ -1556,6 +1942,92 @@ PRIVATE boolean_T UploadCheckTriggerSignals(int32_T upInfoIdx)
 #endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
 
 
+/* Function ====================================================================
+ * Delta encode the data of each active system with an UploadMap for tid into
+ * the encBuf of the tid, each preceded by its system index, and return the
+ * number of bytes.  The references are not updated; see UploadDeltaUpdateRefs.
+ */
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+PRIVATE int_T UploadDeltaEncodeTimePoint(const BdUploadInfo *uploadInfo,
+                                         int_T              tid,
+                                         char_T             *encBuf)
+{
+    int32_T i;
+    char_T  *dst = encBuf;
+
+    for (i=0; i<uploadInfo->nSys; i++) {
+        const SysUploadTable *sysTable =
+            (const SysUploadTable *)&uploadInfo->sysTables[i];
+
+        if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
+             (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) ) {
+            const UploadMap *map = sysTable->uploadMap[tid];
+
+            if (map != NULL) {
+                const UploadSection *sect    = map->copySections;
+                const UploadSection *sectEnd = sect + map->nCopySections;
+                char_T              *cur     = (char_T *)map->deltaCur;
+
+                for (; sect < sectEnd; sect++) {
+                    (void)memcpy(cur, sect->start, sect->nBytes);
+                    cur += sect->nBytes;
+                }
+
+                (void)memcpy(dst, &i, sizeof(int32_T));
+                dst += sizeof(int32_T);
+                dst += ExtDeltaEncode(map->deltaCur, map->deltaRef,
+                                      EXT_DELTA_NUM_WORDS(map->nBytes), dst);
+            }
+        }
+    }
+    return((int_T)(dst - encBuf));
+} /* end UploadDeltaEncodeTimePoint */
+#endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
+
+
+/* Function ====================================================================
+ * Make the time point just added to the buffer of tid the reference of the
+ * next one.  If it was delta encoded the gathered data is already in
+ * deltaCur; otherwise (pre-trigger time points are not encoded, since the
+ * oldest ones may be dropped unsent) it is gathered again.
+ */
+#ifndef EXTMODE_DISABLESIGNALMONITORING
+PRIVATE void UploadDeltaUpdateRefs(const BdUploadInfo *uploadInfo,
+                                   int_T              tid,
+                                   boolean_T          encoded)
+{
+    int32_T i;
+
+    for (i=0; i<uploadInfo->nSys; i++) {
+        const SysUploadTable *sysTable =
+            (const SysUploadTable *)&uploadInfo->sysTables[i];
+
+        if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
+             (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) ) {
+            UploadMap *map = sysTable->uploadMap[tid];
+
+            if (map != NULL) {
+                if (encoded) {
+                    uint32_T *tmp = map->deltaRef;
+                    map->deltaRef = map->deltaCur;
+                    map->deltaCur = tmp;
+                } else {
+                    const UploadSection *sect    = map->copySections;
+                    const UploadSection *sectEnd = sect + map->nCopySections;
+                    char_T              *ref     = (char_T *)map->deltaRef;
+
+                    for (; sect < sectEnd; sect++) {
+                        (void)memcpy(ref, sect->start, sect->nBytes);
+                        ref += sect->nBytes;
+                    }
+                }
+            }
+        }
+    }
+} /* end UploadDeltaUpdateRefs */
+#endif /* ifndef EXTMODE_DISABLESIGNALMONITORING */
+
+
 /* Function ====================================================================
  * If the trigger is in the TRIGGER_FIRED state or we are collecting data for
  * pre-triggering, add data, for each tid with a hit, to the upload buffers.  
@@ -1595,6 +2067,11 @@ PRIVATE boolean_T UploadCheckTriggerSignals(int32_T upInfoIdx)
  *          pkt header          sys data     sys data
  *
  * Ints are int32_T.
+ *
+ * With delta encoding (see ext_delta_utils.c) the time points of a trigger
+ * event are EXT_UPLOAD_LOGGING_DATA_DELTA packets, in which each [data] is
+ * encoded against the previous time point of the system and tid.  Pre-trigger
+ * time points stay EXT_UPLOAD_LOGGING_DATA.
  */
 #ifndef EXTMODE_DISABLESIGNALMONITORING
 PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
@@ -1602,6 +2079,7 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
 {
     int_T        preTrig;
     int_T        overFlow;
+    boolean_T    encode;
     TriggerInfo  *trigInfo;
     CircularBuf  *circBuf;
     BdUploadInfo *uploadInfo = &uploadInfoArray[upInfoIdx];
@@ -1618,6 +2096,9 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
      * move from TRIGGER_ARMED_STATE to TRIGGER_DELAYED or TRIGGER_FIRED.
      */
     if (trigInfo->state == TRIGGER_ARMED) {
+        /* The ring was reset by UploadArmTrigger before it set the state. */
+        EXTMODE_MEMORY_BARRIER();
+
         if (trigInfo->trigSignals.nSections == 0) {
             /* short-circuit for manual trigger */
             trigInfo->state = TRIGGER_FIRED;
@@ -1626,9 +2107,11 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
                 (UploadCheckTriggerSignals(upInfoIdx))) {
                 /* trig signal crossing */
                 if (trigInfo->delay == 0) {
-                    trigInfo->state = TRIGGER_FIRED;
                     /* 0 unless pre-trig */
                     trigInfo->count = trigInfo->preTrig.count;
+                    /* Hand the tail over to the upload server. */
+                    EXTMODE_MEMORY_BARRIER();
+                    trigInfo->state = TRIGGER_FIRED;
                 } else {
                     trigInfo->state = TRIGGER_DELAYED;
                     assert(trigInfo->count == 0);
@@ -1650,9 +2133,11 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
         circBuf->bufSize != 0) {
         
         int32_T     i;
-        BufMem      bufMem;
-        BufMem      pktStart;
+        BufMem      pktMem;
+        BufWriter   writer;
         int_T       size;
+        int_T       encSize    = 0;
+        const char_T *tail;
         char_T *tmpHead    = circBuf->head;
         const int_T PKT_TYPE_IDX = 0;
         const int_T NBYTES_IDX   = 1;
@@ -1671,13 +2156,44 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
         }
         
         /*
-         * Save some space for the 5 integer values that make up the packet
-         * header: [pktType nBytes nSys tid upInfoIdx].
-         * The values are filled in later.
+         * Size the packet: the 5 integer values of the packet header
+         * [pktType nBytes nSys tid upInfoIdx], the time, and the system
+         * index and data of each active system with an UploadMap for tid.
          */
-        size = 5*sizeof(int32_T);
-        overFlow = UploadBufAssignMem(circBuf, size, &tmpHead, &pktStart);
-        if (overFlow) goto EXIT_POINT;
+        size = 5*sizeof(int32_T) + sizeof(real_T);
+        for (i=0; i<uploadInfo->nSys; i++) {
+            const SysUploadTable *sysTable =
+                (const SysUploadTable *)&uploadInfo->sysTables[i];
+
+            if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
+                 (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) &&
+                 (sysTable->uploadMap[tid] != NULL) ) {
+                intHdr[NSYS_IDX]++;
+                size += sizeof(int32_T) + sysTable->uploadMap[tid]->nBytes;
+            }
+        }
+
+        /* If no systems were active then, do nothing. */
+        if (intHdr[NSYS_IDX] == 0) goto EXIT_POINT;
+
+        /* Encode first, so that the time point is reserved at its real size. */
+        encode = (circBuf->encBuf != NULL) && !preTrig;
+        if (encode) {
+            encSize = UploadDeltaEncodeTimePoint(uploadInfo, tid, circBuf->encBuf);
+            size    = 5*sizeof(int32_T) + sizeof(real_T) + encSize;
+        }
+
+        /*
+         * Reserve the whole time point at once.  The tail is read once; the
+         * upload server only moves it forward.
+         */
+        tail = circBuf->tail;
+        EXTMODE_MEMORY_BARRIER();
+        overFlow = UploadBufAssignMem(circBuf, size, tail, &tmpHead, &pktMem);
+        if (overFlow) {
+            circBuf->nDropped++;
+            goto EXIT_POINT;
+        }
 
         /*
          * We do not want to include the packet type and number of bytes
@@ -1685,75 +2201,71 @@ PUBLIC void UploadBufAddTimePoint(int_T tid, real_T taskTime,
          * this packet.  The packet type and number of bytes represent the
          * packet header and are not included in the payload size.
          */
-        size -= 2*sizeof(int32_T);
-        intHdr[NBYTES_IDX] += size;
-        
-        /* time */
-        overFlow =
-            UploadBufAssignMem(circBuf, sizeof(real_T), &tmpHead, &bufMem);
-        if (overFlow) goto EXIT_POINT;
-        intHdr[NBYTES_IDX] += sizeof(real_T);
-        
-        CIRCBUF_COPY_DATA(bufMem, &taskTime);
+        intHdr[PKT_TYPE_IDX] = encode ? EXT_UPLOAD_LOGGING_DATA_DELTA :
+                                        EXT_UPLOAD_LOGGING_DATA;
+        intHdr[NBYTES_IDX]   = size - 2*sizeof(int32_T);
+        intHdr[TID_IDX]      = tid;
+
+        writer.dst      = pktMem.section1;
+        writer.nLeft    = pktMem.nBytes1;
+        writer.section2 = pktMem.section2;
+        writer.nBytes2  = pktMem.nBytes2;
+
+        UploadBufWrite(&writer, intHdr, sizeof(intHdr));
+        UploadBufWrite(&writer, &taskTime, sizeof(real_T));
 
         /*
-         * Check each system for an UploadMap. 
+         * Gather the data of each active system.
          */
-        for (i=0; i<uploadInfo->nSys; i++) {
-            const SysUploadTable *sysTable =
-                (const SysUploadTable *)&uploadInfo->sysTables[i];
+        if (encode) {
+            UploadBufWrite(&writer, circBuf->encBuf, encSize);
+        } else {
+            for (i=0; i<uploadInfo->nSys; i++) {
+                const SysUploadTable *sysTable =
+                    (const SysUploadTable *)&uploadInfo->sysTables[i];
             
-            if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
-                 (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) ) {
-                UploadMap *map = sysTable->uploadMap[tid];
-
-                if (map != NULL) {
-                    int_T section;
-                    intHdr[NSYS_IDX]++;
-                    
-                    /* Add system index */
-                    size = sizeof(int32_T);
-                    overFlow =
-                        UploadBufAssignMem(circBuf, size, &tmpHead, &bufMem);
-                    if (overFlow) goto EXIT_POINT;
-                    intHdr[NBYTES_IDX] += size;
-                    
-                    CIRCBUF_COPY_DATA(bufMem, &i);
-                    
-                    /* Add data values */
-                    for (section=0; section<map->nSections; section++) {
-                        UploadSection *sect = &map->sections[section];
-
-                        overFlow = UploadBufAssignMem(
-                            circBuf, sect->nBytes, &tmpHead, &bufMem);
-                        if (overFlow) goto EXIT_POINT;
-                        intHdr[NBYTES_IDX] += sect->nBytes;
-                        
-                        CIRCBUF_COPY_DATA(bufMem, sect->start);
+                if ( (*sysTable->enableState != SUBSYS_RAN_BC_DISABLE) && 
+                     (*sysTable->enableState != SUBSYS_RAN_BC_ENABLE_TO_DISABLE) ) {
+                    const UploadMap *map = sysTable->uploadMap[tid];
+
+                    if (map != NULL) {
+                        const UploadSection *sect    = map->copySections;
+                        const UploadSection *sectEnd = sect + map->nCopySections;
+
+                        /* Add system index */
+                        UploadBufWrite(&writer, &i, sizeof(int32_T));
+
+                        /* Add data values */
+                        if (map->nBytes <= writer.nLeft) {
+                            /* The map fits before the end of the buffer. */
+                            char_T *dst = writer.dst;
+                            for (; sect < sectEnd; sect++) {
+                                (void)memcpy(dst, sect->start, sect->nBytes);
+                                dst += sect->nBytes;
+                            }
+                            writer.dst    = dst;
+                            writer.nLeft -= map->nBytes;
+                        } else {
+                            for (; sect < sectEnd; sect++) {
+                                UploadBufWrite(&writer, sect->start, sect->nBytes);
+                            }
+                        }
                     }
                 }
             }
         }
+        assert(writer.nLeft == 0 && writer.section2 == NULL);
 
-        /* If no systems were active then, do nothing. */
-        if (intHdr[NSYS_IDX] == 0) goto EXIT_POINT;
-        
         /*
-         * Go back and finish the header: [nBytes pktType nSys tid]
+         * Time point successfully added to queue.  Publish the head only
+         * once all of its data is in the buffer.
          */
-        
-        /* ...pktType */
-        intHdr[PKT_TYPE_IDX] = EXT_UPLOAD_LOGGING_DATA;
-
-        /* ...tid */
-        intHdr[TID_IDX] = tid;
-        CIRCBUF_COPY_DATA(pktStart, intHdr);
+        EXTMODE_MEMORY_BARRIER();
+        circBuf->head = tmpHead;
 
-        /*
-         * Time point successfully added to queue.
-         */
-        circBuf->head  = tmpHead;
-        circBuf->empty = false;
+        if (circBuf->encBuf != NULL) {
+            UploadDeltaUpdateRefs(uploadInfo, tid, encode);
+        }
         
         if (preTrig) {
             trigInfo->preTrig.count++;
@@ -1764,6 +2276,7 @@ EXIT_POINT:
     if (!preTrig) {
         if (overFlow) {
             trigInfo->overFlow = true;
+            EXTMODE_MEMORY_BARRIER();
             trigInfo->state    = TRIGGER_TERMINATING;
         }
 #ifdef VXWORKS
@@ -1795,6 +2308,9 @@ PUBLIC void UploadCheckTrigger(int32_T upInfoIdx, int_T numSampTimes)
     if (trigInfo->state == TRIGGER_UNARMED) return;
 
     if (trigInfo->state == TRIGGER_HOLDING_OFF) {
+        /* The count was reset by UploadBufGetData before it set the state. */
+        EXTMODE_MEMORY_BARRIER();
+
         if (trigInfo->count++ == trigInfo->holdOff) {
             UploadArmTrigger(upInfoIdx, numSampTimes);
         } else {
@@ -1819,10 +2335,12 @@ PUBLIC void UploadCheckTrigger(int32_T upInfoIdx, int_T numSampTimes)
     if (trigInfo->state == TRIGGER_DELAYED) {
         if (trigInfo->count++ >= trigInfo->delay) {
             trigInfo->count = trigInfo->preTrig.count; /* 0 unless pre-trig */
-            trigInfo->state = TRIGGER_FIRED;
             if (trigInfo->preTrig.duration > 0) {
                 trigInfo->preTrig.checkUnderFlow = true;
             }
+            /* Hand the tail over to the upload server. */
+            EXTMODE_MEMORY_BARRIER();
+            trigInfo->state = TRIGGER_FIRED;
 #ifdef VERBOSE
             printf("\nTrigger fired!\n");
 #endif
@@ -1854,6 +2372,7 @@ PUBLIC void UploadCheckEndTrigger(int32_T upInfoIdx)
     if (trigInfo->state == TRIGGER_FIRED) {
         trigInfo->count++;
         if (trigInfo->count == trigInfo->duration) {
+            EXTMODE_MEMORY_BARRIER();
             trigInfo->state = TRIGGER_TERMINATING;
         }
     }
@@ -1887,7 +2406,7 @@ PRIVATE void SetExtBufListFields(ExtBufMemList *extBufList,
     for (tid=0; tid<numSampTimes; tid++) {
         CircularBuf *circBuf = &uploadInfo->circBufs[tid];
 
-        if (!circBuf->empty) {
+        if (circBuf->bufSize > 0) {
             BufMem  *bufMem;
             char_T  *head;
             char_T  *tail   = circBuf->tail;
@@ -1911,6 +2430,12 @@ PRIVATE void SetExtBufListFields(ExtBufMemList *extBufList,
             EXTMODE_ENABLE_INTERRUPTS;
 #endif
 
+            /* head == tail means the buffer is empty. */
+            if (head == tail) continue;
+
+            /* Read the data only after the head that covers it. */
+            EXTMODE_MEMORY_BARRIER();
+
             /* Validate that head/tail ptrs are within allocated range. */
             assert((head >= circBuf->buf) && (tail >= circBuf->buf));
             assert((head < circBuf->buf + circBuf->bufSize) &&
@@ -1982,6 +2507,9 @@ PUBLIC void UploadBufGetData(ExtBufMemList *extBufList,
     if ((trigState == TRIGGER_FIRED) ||
         (trigState == TRIGGER_TERMINATING)) {
 
+        /* Read the ring only after the state that hands it over. */
+        EXTMODE_MEMORY_BARRIER();
+
         /* Make sure we start with an empty list */
         SetExtBufListFieldsForEmptyList(extBufList, upInfoIdx);
         SetExtBufListFields(extBufList, upInfoIdx, numSampTimes);
@@ -2002,6 +2530,8 @@ PUBLIC void UploadBufGetData(ExtBufMemList *extBufList,
                 SendPktToHost(EXT_TERMINATE_LOG_EVENT, sizeof(int32_T),
                               (char *)&upInfoIdx);
                 trigInfo->count = 0;
+                /* Publish the count before the model can see the state. */
+                EXTMODE_MEMORY_BARRIER();
                 trigInfo->state = TRIGGER_HOLDING_OFF;
             }
         }
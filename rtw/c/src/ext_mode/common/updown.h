@@ -17,6 +17,16 @@ extern "C" {
 extern void      SetParam(RTWExtModeInfo  *ei,
                           const char      *pbuf);
 
+#if !defined(EXTMODE_DISABLEPARAMETERTUNING) && defined(EXTMODE_STEP_ATOMIC_PARAMS)
+extern boolean_T StageSetParam(RTWExtModeInfo *ei,
+                               const char     *pbuf,
+                               int_T          nBytes);
+
+extern void      CommitStagedParams(void);
+
+extern void      FreeStagedParams(void);
+#endif
+
 extern void      UploadLogInfoReset(int32_T upInfoIdx);
 
 extern void      UploadPrepareForFinalFlush(int32_T upInfoIdx);
@@ -59,6 +69,20 @@ extern void      UploadBufGetData(ExtBufMemList *extBufList,
 
 extern boolean_T IsAnyDataReadyForUpload(int32_T upInfoIdx);
 
+extern uint32_T  UploadGetNumDropped(int32_T upInfoIdx,
+                                     int_T   numSampTimes);
+
+extern int32_T   UploadSetEncoding(int32_T upInfoIdx,
+                                   int32_T encoding);
+
+#ifdef EXTMODE_SERVER_THREAD
+extern void      UploadModelCallBegin(void);
+
+extern void      UploadModelCallEnd(void);
+
+extern void      UploadWaitForModelCalls(void);
+#endif
+
 #ifdef __cplusplus
 
 }
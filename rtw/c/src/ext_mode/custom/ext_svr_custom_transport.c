@@ -355,6 +355,48 @@ PUBLIC boolean_T ExtSetHostPkt(
 } /* end ExtSetHostPkt */
 
 
+/* Function: ExtSetHostPktV ====================================================
+ * Abstract:
+ *  Sets (sends) the iovCnt pieces in iov on the comm line, back to back, as
+ *  if they were one buffer.  As long as an error does not occur, this function
+ *  is guaranteed to set all the pieces.  The total number of bytes set is
+ *  returned via the 'nBytesSet' parameter.  EXT_NO_ERROR is returned on
+ *  success, EXT_ERROR is returned on failure.
+ *
+ * NOTES:
+ *  o it is always o.k. for this function to block if no room is available
+ *  o only used when EXTMODE_HAS_SETHOSTPKTV is defined
+ *  o where the comm line supports it, send all the pieces with one call
+ *    (e.g., writev or sendmsg on a socket); the version below calls
+ *    ExtSetHostPkt for each piece
+ */
+PUBLIC boolean_T ExtSetHostPktV(
+    const ExtUserData *UD,
+    const ExtIOVec    *iov,
+    const int         iovCnt,
+    int               *nBytesSet) /* out */
+{
+    boolean_T error = EXT_NO_ERROR;
+    int       i;
+
+    *nBytesSet = 0;
+
+    for (i = 0; i < iovCnt; i++) {
+        int nSet;
+
+        if (iov[i].nBytes == 0) continue;
+
+        error = ExtSetHostPkt(UD, iov[i].nBytes, iov[i].base, &nSet);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+
+        *nBytesSet += nSet;
+    }
+
+  EXIT_POINT:
+    return(error);
+} /* end ExtSetHostPktV */
+
+
 /* Function: ExtModeSleep ======================================================
  * Abstract:
  *  Called by grt_main, ert_main, and grt_malloc_main to "pause" (hopefully in
@@ -360,6 +360,44 @@ boolean_T ExtSetHostPkt(
 } /* end ExtSetHostPkt */
 
 
+/* Function: ExtSetHostPktV ====================================================
+ * Abstract:
+ *  Sets (sends) the iovCnt pieces in iov on the comm line, back to back.  The
+ *  total number of bytes set is returned via the 'nBytesSet' parameter.
+ *  EXT_NO_ERROR is returned on success, EXT_ERROR is returned on failure.
+ *
+ * NOTES:
+ *  o each piece is sent as its own serial packet, since every packet is
+ *    acknowledged by the host anyway
+ */
+boolean_T ExtSetHostPktV(
+    const ExtUserData *UD,
+    const ExtIOVec    *iov,
+    const int         iovCnt,
+    int               *nBytesSet) /* out */
+{
+    boolean_T error = EXT_NO_ERROR;
+    int       i;
+
+    *nBytesSet = 0;
+
+    for (i = 0; i < iovCnt; i++) {
+        if (iov[i].nBytes == 0) continue;
+
+        error = ExtSetPktWithACK(UD->portDev,
+                                 iov[i].base,
+                                 iov[i].nBytes,
+                                 EXTMODE_PACKET);
+        if (error != EXT_NO_ERROR) goto EXIT_POINT;
+
+        *nBytesSet += iov[i].nBytes;
+    }
+
+  EXIT_POINT:
+    return(error);
+} /* end ExtSetHostPktV */
+
+
 /* Function: ExtModeSleep ======================================================
  * Abstract:
  *  Called by grt_main, ert_main, and grt_malloc_main to "pause" (hopefully in
@@ -0,0 +1,38 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+#ifndef _MFL_INTERP_AKIMABINSEARCH_H_
+#define _MFL_INTERP_AKIMABINSEARCH_H_
+
+/**
+ * \file
+ * Bin search strategies for Akima grid vectors.
+ *
+ * akimaFixedGrid_precomputeBinSearch_double() (and the float and 1-D variants) choose a strategy
+ * once per grid vector and store it in a separate buffer as AKIMA_BIN_SEARCH_NUMEL entries
+ * <tt>[method, x(1), 1/h]</tt>, where \p h is the grid spacing of evenly spaced grid vectors.
+ * Only the ...WithBinSearch interpolation entry points use them; the Akima coefficients and the
+ * workspaces of the other entry points are unchanged. All strategies return the same bins as
+ * akimaFindGridInterval1D_double().
+ */
+
+/** Number of floating-point entries describing the bin search of one grid vector. */
+#define AKIMA_BIN_SEARCH_NUMEL 3
+
+/** Linear search, used for grid vectors with few nodes. */
+#define AKIMA_BIN_SEARCH_LINEAR  0
+/** O(1) index computation for evenly spaced grid vectors. */
+#define AKIMA_BIN_SEARCH_UNIFORM 1
+/** Try the bin of the previous query point and its successor, then branchless binary search. */
+#define AKIMA_BIN_SEARCH_CACHED  2
+
+/** Grid vectors with at most this many nodes use linear search. */
+#define AKIMA_BIN_SEARCH_LINEAR_MAX 8
+
+/**
+ * Grid vectors are treated as evenly spaced if every node lies within
+ * <tt>h/AKIMA_BIN_SEARCH_UNIFORM_TOL</tt> of <tt>x(1) + (i-1)*h</tt>. The computed bin is
+ * corrected against the actual nodes, so this only bounds the number of correction steps.
+ */
+#define AKIMA_BIN_SEARCH_UNIFORM_TOL 64
+
+#endif /* _MFL_INTERP_AKIMABINSEARCH_H_ */
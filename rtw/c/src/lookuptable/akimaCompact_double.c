@@ -0,0 +1,136 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+#include <string.h> /* memcpy, memset */
+
+#include "akimaCompact_double.h"
+#include "akimaHermiteBasis_double.h"
+#include "akimaStrides.h"
+
+/**
+ * \file
+ * Single-precision storage of Akima coefficients for double-precision grids.
+ * See akimaCompact_double.h for the accuracy of the results.
+ */
+
+void akimaFixedGrid_compact_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double*  coefficients,
+    /* OUTPUTS: */
+    float*         compactCoefficients
+)
+{
+    MFL_INTERP_UINT numelCoefficients, pp;
+
+    numelCoefficients = akimaProd(gridSize,N)*(((MFL_INTERP_UINT)1) << N);
+
+    for (pp = 0; pp < numelCoefficients; ++pp) {
+        compactCoefficients[pp] = (float)coefficients[pp];
+    }
+}
+
+void akimaFixedGrid_interpolateCompact_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    const float*   compactCoefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    MFL_INTERP_UINT pow2toN, gridNumel, ii, ii2, jj, jjh, hh, cc, kk, qq;
+    MFL_INTERP_UINT* gridSizeCumprod;
+    MFL_INTERP_UINT* strides;
+    MFL_INTERP_UINT* lastBins;
+    double* ndcube;
+    double* H;
+    double* dH;
+    double vq;
+
+    pow2toN = ((MFL_INTERP_UINT)1) << N;
+    gridNumel = akimaProd(gridSize,N);
+
+    /*
+     * Indices workspace usage:
+     *  workspaceIndices[0,N)             - for A = [1 cumprod(A(1:N-1))] (in MATLAB)
+     *  workspaceIndices[N,N+2^N)         - 2^N-vector for strides
+     *  workspaceIndices[N+2^N,2*N+2^N)   - bins of the previous query point
+     */
+    gridSizeCumprod = workspaceIndices;
+    memcpy(gridSizeCumprod,gridSize,N*sizeof(MFL_INTERP_UINT));
+    akimaCumprod(gridSizeCumprod,N);
+    strides = gridSizeCumprod + N;
+    lastBins = strides + pow2toN;
+    memset(lastBins,0,N*sizeof(MFL_INTERP_UINT));
+
+    /*
+     * Evaluation workspace usage:
+     *  workspaceEvaluation[0,2^N)             - for contiguous N-D cube
+     *  workspaceEvaluation[2^N,2*N+2^N)       - for H coefficients
+     *  workspaceEvaluation[2*N+2^N,4*N+2^N)   - for dH coefficients
+     */
+    ndcube = workspaceEvaluation;
+    H = ndcube + pow2toN;
+    dH = H + 2*N;
+
+    /* Offsets of the N-D cube corners, in the same order as akimaFixedGrid_interpolate_double: */
+    strides[0] = 0;
+    for (ii = 0; ii < N; ++ii) {
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) {
+            strides[jj] = strides[jj-ii2] + gridSizeCumprod[ii];
+        }
+    }
+
+    for (kk = 0; kk < numQ; ++kk) {
+
+        qq = akimaHermiteBasisND_double(
+                                    kk,
+                                    gridVectors,
+                                    gridSize,
+                                    gridSizeCumprod,
+                                    N,
+                                    extrapMethod,
+                                    noDerivatives,
+                                    numQ,
+                                    Xq,
+                                    binsXq,
+                                    (void *)0,
+                                    lastBins,
+                                    (void *)0,
+                                    H,
+                                    dH);
+
+        vq = 0;
+        for (jj = 0; jj < pow2toN; ++jj) {
+
+            /* Widen the coefficients at corner qq+strides[jj] to a contiguous N-D cube: */
+            for (cc = 0; cc < pow2toN; ++cc) {
+                ndcube[cc] = (double)compactCoefficients[cc*gridNumel + qq + strides[jj]];
+            }
+
+            /* Collapse the cube one dimension at a time (see akimaHermitePolynomialND_double): */
+            for (ii = N; ii > 0; --ii) {
+                jjh = 2*(N-ii) + ((jj >> (N-ii)) & 1);
+                ii2 = ((MFL_INTERP_UINT)1) << (ii-1);
+                for (hh = 0; hh < ii2; ++hh) {
+                    ndcube[hh] = ndcube[2*hh] * H[jjh] + ndcube[2*hh+1] * dH[jjh];
+                }
+            }
+
+            vq = (jj == 0) ? ndcube[0] : vq + ndcube[0];
+        }
+        Vq[kk] = vq;
+    }
+}
@@ -0,0 +1,96 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+#ifndef _MFL_INTERP_AKIMACOMPACT_double_H_
+#define _MFL_INTERP_AKIMACOMPACT_double_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mfl_interp_util.h" /* MFL_INTERP_UINT */
+
+/**
+ * \file
+ * Single-precision storage of Akima coefficients for double-precision grids.
+ *
+ * The 2^N coefficient arrays computed by akimaFixedGrid_precompute_double() take 2^N times the
+ * memory of the grid values. Storing them as float halves that footprint. Whether this also
+ * speeds up interpolation depends on the grid size, the query locality and the cache of the
+ * target; measure with test/tAkimaBench.c. Grid vectors, query points, the Hermite basis and
+ * all arithmetic remain double precision; only the coefficients are rounded to float.
+ *
+ * Accuracy: each coefficient <tt>c(j)</tt> is rounded with a relative error of at most
+ * <tt>2^-24</tt>, so a result computed from compact coefficients satisfies
+ * <tt>abs(VqCompact - Vq) <= 2^-24 * sum(abs(c(j)*B(j)))</tt>, where
+ * <tt>Vq = sum(c(j)*B(j))</tt> is the result of akimaFixedGrid_interpolate_double() and
+ * <tt>B(j)</tt> are the <tt>4^N</tt> Hermite basis terms of the cell containing the query point.
+ * The bound is only close to <tt>2^-24*abs(Vq)</tt> when the terms do not cancel. The value and
+ * derivative terms of a cell cancel when the grid values are large compared with their
+ * variation, and the derivative basis functions scale with the reciprocal of the grid spacing,
+ * so the error grows with \p N and is largest for derivatives (\p noDerivatives = 0). Relative
+ * to <tt>max(abs(Vq))</tt>, errors of about 1e-6 (values) and 1e-5 (derivatives) are typical for
+ * smooth data at \p N = 1, rising to 1e-4 (values) and a few 1e-3 (derivatives) at \p N = 3
+ * and 4. For data with a large offset, and when extrapolating with cubic polynomials, they
+ * reach about 1e-3 (values) and 1e-2 (derivatives).
+ * Use akimaFixedGrid_interpolate_double() where this is not acceptable.
+ */
+
+/**
+ * Convert pre-computed Akima cubic polynomial coefficients to single-precision storage.
+ *
+ * \param[in]  N             Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize      Size of the underlying N-D grid. In MATLAB notation:
+ *                           <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                           where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  coefficients  Akima cubic polynomial coefficients pre-computed by
+ *                           akimaFixedGrid_precompute_double().
+ *
+ * \param[out] compactCoefficients  Single-precision Akima coefficients. Must be \b pre-allocated
+ *                                  with akimaFixedGrid_compactWS() elements.
+ */
+void akimaFixedGrid_compact_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double*  coefficients,
+    /* OUTPUTS: */
+    float*         compactCoefficients
+);
+
+/**
+ * Interpolate using single-precision Akima cubic polynomial coefficients for fixed grid vectors
+ * and grid values, but different query points.
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace for floating-point quantities
+ *                                  (see akimaFixedGrid_interpolateCompactWS()).
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace for MFL_INTERP_UINT.
+ * \param[in]  compactCoefficients  Coefficients converted by akimaFixedGrid_compact_double().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters. The results differ from
+ * those of akimaFixedGrid_interpolate_double() by at most the bound given in the file
+ * description.
+ */
+void akimaFixedGrid_interpolateCompact_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    const float*   compactCoefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MFL_INTERP_AKIMACOMPACT_double_H_ */
@@ -1,10 +1,14 @@
 /* Copyright 2019 The MathWorks, Inc.*/
 
+#include <string.h> /* memcpy */
+
 #include "akimaCoefficients_double.h"
 #include "akimaEvaluation_double.h"
 #include "akimaHermiteBasis_double.h"
 #include "akimaUtils_double.h"
 #include "akimaStrides.h"
+#include "akimaThreadPool.h"
+#include "akimaWorkspace.h"
 
 /**
  * \file
@@ -48,6 +52,168 @@ void akimaFixedGrid_precompute_double
                                             N, work1, work2, coefficients);
 }
 
+/**
+ * Update pre-computed Akima cubic polynomial coefficients after some grid values changed.
+ *
+ * Only the coefficients within AKIMA_UPDATE_RADIUS nodes of a changed grid value depend on it.
+ * For each changed grid value, they are recomputed on a sub-grid of at most
+ * AKIMA_UPDATE_BOX_SIZE nodes along each dimension, and are identical to the coefficients
+ * computed by akimaFixedGrid_precompute_double().
+ *
+ * <b>NOTE: Each changed grid value costs a sub-grid computation. If most of the grid values
+ *          changed, akimaFixedGrid_precompute_double() is faster.</b>
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *                          In MATLAB notation, the underlying N-D grid is given by:
+ *                          <tt>[XX1,...,XXN] = ndgrid(x1,...,xN)</tt>.
+ * \param[in]  gridValues   Values at each grid node, including the changed values.
+ * \param[in]  numChanged   Number of changed grid values.
+ * \param[in]  changedIndices  0-based linear indices of the changed grid values. Indices
+ *                             outside the grid are ignored.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities
+ *                          (see akimaFixedGrid_updateWS()).
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ *
+ * \param[in,out]  coefficients  Akima cubic polynomial coefficients pre-computed by
+ *                               akimaFixedGrid_precompute_double().
+ */
+
+void akimaFixedGrid_update_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const double*  gridValues,
+    const MFL_INTERP_UINT         numChanged,
+    const MFL_INTERP_UINT*        changedIndices,
+    double*        work1,
+    MFL_INTERP_UINT*              work2,
+    /* OUTPUTS: */
+    double*        coefficients
+)
+{
+    const double* boxVectors[AKIMA_UPDATE_MAX_DIMS];
+    MFL_INTERP_UINT gridNumel, pow2toN, boxNumelMax, boxNumel, updateNumel,
+        ii, jj, kk, pp, qq, qqBox, rr, sub, lo, hi;
+    MFL_INTERP_UINT* gridSizeCumprod;
+    MFL_INTERP_UINT* boxStart;
+    MFL_INTERP_UINT* boxSize;
+    MFL_INTERP_UINT* boxSizeCumprod;
+    MFL_INTERP_UINT* updateStart;
+    MFL_INTERP_UINT* updateSize;
+    MFL_INTERP_UINT* boxWorkspaceIndices;
+    double* boxValues;
+    double* boxCoefficients;
+    double* boxWorkspace;
+
+    gridNumel = akimaProd(gridSize,N);
+    pow2toN = ((MFL_INTERP_UINT)1) << N;
+
+    /*
+     * Workspace usage:
+     *  work2[0,N)       - gridSize cumprod
+     *  work2[N,2*N)     - sub-grid start, as grid subscripts
+     *  work2[2*N,3*N)   - sub-grid size
+     *  work2[3*N,4*N)   - sub-grid size cumprod
+     *  work2[4*N,5*N)   - start of the updated nodes, as sub-grid subscripts
+     *  work2[5*N,6*N)   - size of the updated nodes
+     *  work2[6*N,...)   - akimaCoefficients_double() indices workspace
+     *  work1[0,B)       - sub-grid values, where B is the largest sub-grid numel
+     *  work1[B,B+B*2^N) - sub-grid coefficients
+     *  work1[B+B*2^N,...) - akimaCoefficients_double() floating-point workspace
+     */
+    gridSizeCumprod = work2;
+    boxStart = gridSizeCumprod + N;
+    boxSize = boxStart + N;
+    boxSizeCumprod = boxSize + N;
+    updateStart = boxSizeCumprod + N;
+    updateSize = updateStart + N;
+    boxWorkspaceIndices = work2 + 6*N;
+
+    for (ii = 0; ii < N; ++ii) {
+        boxSize[ii] = (gridSize[ii] < AKIMA_UPDATE_BOX_SIZE) ? gridSize[ii] : AKIMA_UPDATE_BOX_SIZE;
+    }
+    boxNumelMax = akimaProd(boxSize,N);
+    boxValues = work1;
+    boxCoefficients = boxValues + boxNumelMax;
+    boxWorkspace = boxCoefficients + boxNumelMax*pow2toN;
+
+    memcpy(gridSizeCumprod,gridSize,N*sizeof(MFL_INTERP_UINT));
+    akimaCumprod(gridSizeCumprod,N);
+
+    for (jj = 0; jj < numChanged; ++jj) {
+
+        if (changedIndices[jj] >= gridNumel) {
+            continue;
+        }
+
+        /*
+         * Along each dimension, the coefficients within AKIMA_UPDATE_RADIUS nodes of the
+         * changed node are updated. They are computed on a sub-grid with another
+         * AKIMA_UPDATE_RADIUS nodes on each side, so that the sub-grid only differs from the
+         * full grid in slopes and weights that these coefficients do not use.
+         */
+        rr = changedIndices[jj];
+        for (ii = 0; ii < N; ++ii) {
+            sub = rr % gridSize[ii];
+            rr /= gridSize[ii];
+
+            lo = (sub > 2*AKIMA_UPDATE_RADIUS) ? sub - 2*AKIMA_UPDATE_RADIUS : 0;
+            hi = (sub + 2*AKIMA_UPDATE_RADIUS < gridSize[ii]) ? sub + 2*AKIMA_UPDATE_RADIUS
+                                                              : gridSize[ii] - 1;
+            boxStart[ii] = lo;
+            boxSize[ii] = hi - lo + 1;
+
+            lo = (sub > AKIMA_UPDATE_RADIUS) ? sub - AKIMA_UPDATE_RADIUS : 0;
+            hi = (sub + AKIMA_UPDATE_RADIUS < gridSize[ii]) ? sub + AKIMA_UPDATE_RADIUS
+                                                            : gridSize[ii] - 1;
+            updateStart[ii] = lo - boxStart[ii];
+            updateSize[ii] = hi - lo + 1;
+
+            boxVectors[ii] = gridVectors[ii] + boxStart[ii];
+        }
+        boxNumel = akimaProd(boxSize,N);
+        updateNumel = akimaProd(updateSize,N);
+        memcpy(boxSizeCumprod,boxSize,N*sizeof(MFL_INTERP_UINT));
+        akimaCumprod(boxSizeCumprod,N);
+
+        /* Copy the sub-grid values: */
+        for (pp = 0; pp < boxNumel; ++pp) {
+            qq = 0;
+            rr = pp;
+            for (ii = 0; ii < N; ++ii) {
+                qq += (boxStart[ii] + rr % boxSize[ii]) * gridSizeCumprod[ii];
+                rr /= boxSize[ii];
+            }
+            boxValues[pp] = gridValues[qq];
+        }
+
+        akimaCoefficients_double(boxVectors, boxValues, boxSize,
+                                  N, boxWorkspace, boxWorkspaceIndices, boxCoefficients);
+
+        /* Copy the updated coefficients back: */
+        for (pp = 0; pp < updateNumel; ++pp) {
+            qq = 0;
+            qqBox = 0;
+            rr = pp;
+            for (ii = 0; ii < N; ++ii) {
+                sub = updateStart[ii] + rr % updateSize[ii];
+                rr /= updateSize[ii];
+                qq += (boxStart[ii] + sub) * gridSizeCumprod[ii];
+                qqBox += sub * boxSizeCumprod[ii];
+            }
+            for (kk = 0; kk < pow2toN; ++kk) {
+                coefficients[kk*gridNumel + qq] = boxCoefficients[kk*boxNumel + qqBox];
+            }
+        }
+    }
+}
+
 /**
  * Interpolate using pre-computed Akima cubic polynomial coefficients for fixed grid vectors and
  * grid values, but different query points.
@@ -116,9 +282,333 @@ void akimaFixedGrid_interpolate_double
                                             Xq,
                                             binsXq,
                                             (void *)0,
+                                            (void *)0,
                                             Vq);
 }
 
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients for fixed grid vectors and
+ * grid values, evaluating several query points at a time with SIMD instructions.
+ *
+ * Same parameters and results as akimaFixedGrid_interpolate_double(), except that the
+ * workspaces must be sized by akimaFixedGrid_interpolateBatchedWS().
+ */
+
+void akimaFixedGrid_interpolateBatched_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    akimaEvaluationViaHermiteBasisBatched_double(
+                                            gridVectors,
+                                            gridSize,
+                                            N,
+                                            extrapMethod,
+                                            workspaceEvaluation,
+                                            workspaceIndices,
+                                            coefficients,
+                                            noDerivatives,
+                                            numQ,
+                                            Xq,
+                                            binsXq,
+                                            (void *)0,
+                                            (void *)0,
+                                            Vq);
+}
+
+/**
+ * Choose the bin search strategy of each grid vector for
+ * akimaFixedGrid_interpolateWithBinSearch_double() and
+ * akimaFixedGrid_interpolateBatchedWithBinSearch_double().
+ *
+ * Grid vectors with few nodes keep the linear search, evenly spaced grid vectors compute the bin
+ * directly, and the others try the bin of the previous query point before a binary search (see
+ * akimaBinSearch.h). All strategies return the same bins as the linear search.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *                          In MATLAB notation, the underlying N-D grid is given by:
+ *                          <tt>[XX1,...,XXN] = ndgrid(x1,...,xN)</tt>.
+ *
+ * \param[out] binSearch    Bin search descriptors. Must be \b pre-allocated with
+ *                          akimaFixedGrid_binSearchWS() elements.
+ */
+
+void akimaFixedGrid_precomputeBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    /* OUTPUTS: */
+    double*        binSearch
+)
+{
+    akimaBinSearchSetup_double(gridVectors, gridSize, N, binSearch);
+}
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients and bin search strategies
+ * for fixed grid vectors and grid values, but different query points.
+ *
+ * Same results as akimaFixedGrid_interpolate_double(), but the bins of the query points are
+ * found with the strategies chosen by akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace for floating-point quantities,
+ *                                  sized by akimaFixedGrid_interpolateWithBinSearchWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                                  akimaFixedGrid_interpolateWithBinSearchWS().
+ * \param[in]  binSearch            Bin search strategies computed by
+ *                                  akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const double*  binSearch,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    akimaEvaluationViaHermiteBasis_double(
+                                            gridVectors,
+                                            gridSize,
+                                            N,
+                                            extrapMethod,
+                                            workspaceEvaluation,
+                                            workspaceIndices,
+                                            coefficients,
+                                            noDerivatives,
+                                            numQ,
+                                            Xq,
+                                            binsXq,
+                                            binSearch,
+                                            (void *)0,
+                                            Vq);
+}
+
+/**
+ * Batched variant of akimaFixedGrid_interpolateWithBinSearch_double(). See
+ * akimaFixedGrid_interpolateBatched_double().
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace for floating-point quantities,
+ *                                  sized by akimaFixedGrid_interpolateBatchedWithBinSearchWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                                  akimaFixedGrid_interpolateBatchedWithBinSearchWS().
+ * \param[in]  binSearch            Bin search strategies computed by
+ *                                  akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateBatchedWithBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const double*  binSearch,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    akimaEvaluationViaHermiteBasisBatched_double(
+                                            gridVectors,
+                                            gridSize,
+                                            N,
+                                            extrapMethod,
+                                            workspaceEvaluation,
+                                            workspaceIndices,
+                                            coefficients,
+                                            noDerivatives,
+                                            numQ,
+                                            Xq,
+                                            binsXq,
+                                            binSearch,
+                                            (void *)0,
+                                            Vq);
+}
+
+/**
+ * Arguments of a parallel akimaFixedGrid_interpolateParallel_double() call.
+ */
+typedef struct akimaInterpolateArgs_double_tag {
+    MFL_INTERP_UINT        N;
+    const MFL_INTERP_UINT* gridSize;
+    const double** gridVectors;
+    MFL_INTERP_UINT        extrapMethod;
+    MFL_INTERP_UINT        noDerivatives;
+    double*        workspaceEvaluation;
+    MFL_INTERP_UINT*       workspaceIndices;
+    MFL_INTERP_UINT        numelWorkspaceEvaluation;
+    MFL_INTERP_UINT        numelWorkspaceIndices;
+    double*        coefficients;
+    MFL_INTERP_UINT        numQ;
+    const double** Xq;
+    MFL_INTERP_UINT**      binsXq;
+    double*        Vq;
+} akimaInterpolateArgs_double;
+
+/**
+ * Interpolate one contiguous chunk of query points on the current thread, using the
+ * workspace slice of the chunk.
+ */
+static void akimaFixedGrid_interpolateChunk_double
+(
+    void*                 args,
+    MFL_INTERP_UINT       chunkIdx,
+    MFL_INTERP_UINT       numChunks
+)
+{
+    const akimaInterpolateArgs_double* a = (const akimaInterpolateArgs_double*)args;
+    const double* XqChunk[AKIMA_THREADPOOL_MAX_DIMS];
+    MFL_INTERP_UINT* binsChunk[AKIMA_THREADPOOL_MAX_DIMS];
+    MFL_INTERP_UINT first, numChunkQ, jj;
+
+    /* Spread the remainder over the first chunks: */
+    numChunkQ = a->numQ/numChunks;
+    first = chunkIdx*numChunkQ + ((chunkIdx < a->numQ%numChunks) ? chunkIdx : a->numQ%numChunks);
+    numChunkQ += (chunkIdx < a->numQ%numChunks) ? 1 : 0;
+
+    for (jj = 0; jj < a->N; ++jj) {
+        XqChunk[jj] = a->Xq[jj] + first;
+        if (a->binsXq) {
+            binsChunk[jj] = a->binsXq[jj] + first;
+        }
+    }
+
+    akimaFixedGrid_interpolate_double(
+                                a->N,
+                                a->gridSize,
+                                a->gridVectors,
+                                a->extrapMethod,
+                                a->noDerivatives,
+                                a->workspaceEvaluation + chunkIdx*a->numelWorkspaceEvaluation,
+                                a->workspaceIndices + chunkIdx*a->numelWorkspaceIndices,
+                                a->coefficients,
+                                numChunkQ,
+                                XqChunk,
+                                a->binsXq ? binsChunk : a->binsXq,
+                                a->Vq + first);
+}
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients for fixed grid vectors and
+ * grid values, splitting the query points across the threads of the pool created by
+ * akimaThreadPoolInit().
+ *
+ * Same results as akimaFixedGrid_interpolate_double(). Calls with few query points, calls made
+ * while the pool is busy, and builds without MFL_INTERP_MT run serially on the calling thread.
+ *
+ * \param[in]  numThreads  Number of per-thread workspaces in \p workspace1 and \p workspace2,
+ *                         usually akimaThreadPoolGetNumThreads().
+ * \param[in]  workspace1  \b Pre-allocated workspace for floating-point quantities, sized by
+ *                         akimaFixedGrid_interpolateParallelWS().
+ * \param[in]  workspace2  \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                         akimaFixedGrid_interpolateParallelWS().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateParallel_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    const MFL_INTERP_UINT         numThreads,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    akimaInterpolateArgs_double args;
+    MFL_INTERP_UINT numChunks;
+
+    numChunks = (numThreads < numQ) ? numThreads : numQ;
+
+    if (numChunks > 1 && N <= AKIMA_THREADPOOL_MAX_DIMS &&
+        (double)numQ * (double)(((MFL_INTERP_UINT)1) << N) >= AKIMA_THREADPOOL_MIN_WORK) {
+
+        args.N = N;
+        args.gridSize = gridSize;
+        args.gridVectors = gridVectors;
+        args.extrapMethod = extrapMethod;
+        args.noDerivatives = noDerivatives;
+        args.workspaceEvaluation = workspaceEvaluation;
+        args.workspaceIndices = workspaceIndices;
+        akimaFixedGrid_interpolateWS(N, &args.numelWorkspaceEvaluation, &args.numelWorkspaceIndices);
+        args.coefficients = coefficients;
+        args.numQ = numQ;
+        args.Xq = Xq;
+        args.binsXq = binsXq;
+        args.Vq = Vq;
+
+        if (akimaThreadPoolRun(akimaFixedGrid_interpolateChunk_double, &args, numChunks)) {
+            return;
+        }
+    }
+
+    /* Serial: use the first per-thread workspace */
+    akimaFixedGrid_interpolate_double(
+                                N,
+                                gridSize,
+                                gridVectors,
+                                extrapMethod,
+                                noDerivatives,
+                                workspaceEvaluation,
+                                workspaceIndices,
+                                coefficients,
+                                numQ,
+                                Xq,
+                                binsXq,
+                                Vq);
+}
+
 /**
  * Pre-compute Akima cubic Hermite basis for fixed grid vectors and query points,
  * but different grid values.
@@ -179,9 +669,11 @@ void akimaFixedQuery_precompute_double
         for (jj = 0; jj < N; ++jj) {
 
             b = binsXq ? binsXq[jj][kk]
-                       : akimaFindGridInterval1D_double(gridVectors[jj],
-                                                                       gridSize[jj],
-                                                                       Xq[jj][kk]);
+                       : akimaFindGridIntervalFast1D_double(gridVectors[jj],
+                                                                           gridSize[jj],
+                                                                           (void *)0,
+                                                                           Xq[jj][kk],
+                                                                           0);
 
             /* Compute the first and second Hermite basis coefficients: */
             jj2 = jj*2*numQ;
@@ -277,6 +769,7 @@ void akimaFixedQuery_interpolate_double
                                             numQ,
                                             Xq,
                                             binsXq,
+                                            (void *)0,
                                             akimaBasis,
                                             Vq);
 }
@@ -318,11 +811,14 @@ void akimaQueryBins_double
     MFL_INTERP_UINT**             binsXq
 )
 {
-    MFL_INTERP_UINT i, k;
+    MFL_INTERP_UINT i, k, b;
 
     for (i = 0; i < N; ++i) {
+        /* Start each search from the bin of the previous query point: */
+        b = 0;
         for (k = 0; k < numQ; ++k) {
-            binsXq[i][k] = akimaFindGridInterval1D_double(gridVectors[i],gridSize[i],Xq[i][k]);
+            b = akimaFindGridIntervalFast1D_double(gridVectors[i],gridSize[i],(void *)0,Xq[i][k],b);
+            binsXq[i][k] = b;
         }
     }
 }
@@ -367,6 +863,83 @@ void akimaFixedGrid_precompute_1D_double
                                             coefficients);
 }
 
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Update pre-computed Akima cubic polynomial coefficients after some grid values changed.
+ * See akimaFixedGrid_update_double().
+ *
+ * \param[in]  nx            Number of 1-D grid coordinates.
+ * \param[in]  x             Vector of 1-D grid coordinates.
+ * \param[in]  v             Vector of 1-D grid values, including the changed values.
+ * \param[in]  numChanged    Number of changed grid values.
+ * \param[in]  changedIndices  0-based indices of the changed grid values. Indices outside the
+ *                             grid are ignored.
+ * \param[in]  workspace     \b Pre-allocated workspace for floating-point quantities
+ *                           (see akimaFixedGrid_updateWS_1D()).
+ *
+ * \param[in,out]  coefficients  Akima cubic polynomial coefficients pre-computed by
+ *                               akimaFixedGrid_precompute_1D_double().
+ */
+
+void akimaFixedGrid_update_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const double* v,
+    const MFL_INTERP_UINT        numChanged,
+    const MFL_INTERP_UINT*       changedIndices,
+    double*       workspace,
+    /* OUTPUTS: */
+    double*       coefficients
+)
+{
+    MFL_INTERP_UINT jj, boxStart, boxSize, updateStart, updateSize, lo, hi;
+    double* boxCoefficients;
+
+    /* See akimaFixedGrid_update_double() for the sub-grid sizes: */
+    boxCoefficients = workspace;
+    workspace += 2*((nx < AKIMA_UPDATE_BOX_SIZE) ? nx : AKIMA_UPDATE_BOX_SIZE);
+
+    for (jj = 0; jj < numChanged; ++jj) {
+
+        if (changedIndices[jj] >= nx) {
+            continue;
+        }
+
+        lo = (changedIndices[jj] > 2*AKIMA_UPDATE_RADIUS) ?
+            changedIndices[jj] - 2*AKIMA_UPDATE_RADIUS : 0;
+        hi = (changedIndices[jj] + 2*AKIMA_UPDATE_RADIUS < nx) ?
+            changedIndices[jj] + 2*AKIMA_UPDATE_RADIUS : nx - 1;
+        boxStart = lo;
+        boxSize = hi - lo + 1;
+
+        lo = (changedIndices[jj] > AKIMA_UPDATE_RADIUS) ?
+            changedIndices[jj] - AKIMA_UPDATE_RADIUS : 0;
+        hi = (changedIndices[jj] + AKIMA_UPDATE_RADIUS < nx) ?
+            changedIndices[jj] + AKIMA_UPDATE_RADIUS : nx - 1;
+        updateStart = lo;
+        updateSize = hi - lo + 1;
+
+        akimaCoefficients_1D_double(
+                                            x + boxStart,
+                                            v + boxStart,
+                                            boxSize,
+                                            workspace,
+                                            boxCoefficients);
+
+        /* Grid values and derivative estimates: */
+        memcpy(coefficients + updateStart, boxCoefficients + (updateStart - boxStart),
+               updateSize*sizeof(double));
+        memcpy(coefficients + nx + updateStart,
+               boxCoefficients + boxSize + (updateStart - boxStart),
+               updateSize*sizeof(double));
+    }
+}
+
 /**
  * Optimized 1-D function.
  *
@@ -424,6 +997,78 @@ void akimaFixedGrid_interpolate_1D_double
                                             numQ,
                                             xq,
                                             binsXq,
+                                            (void *)0,
+                                            vq);
+}
+
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Choose the bin search strategy of a 1-D grid vector for
+ * akimaFixedGrid_interpolateWithBinSearch_1D_double(). See
+ * akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * \param[in]  nx            Number of 1-D grid coordinates.
+ * \param[in]  x             Vector of 1-D grid coordinates.
+ *
+ * \param[out]  binSearch    Bin search descriptor. Must be \b pre-allocated with
+ *                           <tt>akimaFixedGrid_binSearchWS(1)</tt> elements.
+ */
+
+void akimaFixedGrid_precomputeBinSearch_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    /* OUTPUTS: */
+    double*       binSearch
+)
+{
+    akimaBinSearchSetup1D_double(x, nx, binSearch);
+}
+
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Same results as akimaFixedGrid_interpolate_1D_double(), but the bins of the query points are
+ * found with the strategy chosen by akimaFixedGrid_precomputeBinSearch_1D_double().
+ *
+ * \param[in]  binSearch    Bin search strategy computed by
+ *                          akimaFixedGrid_precomputeBinSearch_1D_double().
+ *
+ * See akimaFixedGrid_interpolate_1D_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearch_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const MFL_INTERP_UINT        extrapMethod,
+    const MFL_INTERP_UINT        noDerivatives,
+    double*       coefficients,
+    const double* binSearch,
+    const MFL_INTERP_UINT        numQ,
+    const double* xq,
+    const MFL_INTERP_UINT*       binsXq,
+    /* OUTPUTS: */
+    double*       vq
+)
+{
+    akimaEvaluationViaHermiteBasis1D_double(
+                                            x,
+                                            nx,
+                                            extrapMethod,
+                                            coefficients,
+                                            noDerivatives,
+                                            numQ,
+                                            xq,
+                                            binsXq,
+                                            binSearch,
                                             vq);
 }
 
@@ -475,10 +1120,11 @@ void akimaFixedQuery_precompute_1D_double
 {
     MFL_INTERP_UINT b, kk, kk2;
 
+    b = 0;
     for (kk = 0; kk < numQ; ++kk) {
         kk2 = 2*kk;
 
-        b = binsXq ? binsXq[kk] : akimaFindGridInterval1D_double(x,nx,xq[kk]);
+        b = binsXq ? binsXq[kk] : akimaFindGridIntervalFast1D_double(x,nx,(void *)0,xq[kk],b);
 
         /* Compute the first and second Hermite basis coefficients: */
         akimaHermiteBasis1D_double(
@@ -565,10 +1211,11 @@ void akimaFixedQuery_interpolate_1D_double
     /*
      * Evaluate 1-D Akima polynomial interpolant.
      */
+    b = 0;
     for (kk = 0; kk < numQ; ++kk) {
 
         /* Compute the bins if needed */
-        b = binsXq ? binsXq[kk] : akimaFindGridInterval1D_double(x,nx,xq[kk]);
+        b = binsXq ? binsXq[kk] : akimaFindGridIntervalFast1D_double(x,nx,(void *)0,xq[kk],b);
 
         /*
          * Form Hermite basis for each 1-D query point.
@@ -633,8 +1280,10 @@ void akimaQueryBins_1D_double
     MFL_INTERP_UINT*              binsXq
 )
 {
-    MFL_INTERP_UINT k;
+    MFL_INTERP_UINT k, b;
+    b = 0;
     for (k = 0; k < numQ; ++k) {
-        binsXq[k] = akimaFindGridInterval1D_double(x,nx,xq[k]);
+        b = akimaFindGridIntervalFast1D_double(x,nx,(void *)0,xq[k],b);
+        binsXq[k] = b;
     }
 }
@@ -47,6 +47,51 @@ void akimaFixedGrid_precompute_double
     double*        coefficients
 );
 
+/**
+ * Update pre-computed Akima cubic polynomial coefficients after some grid values changed.
+ *
+ * Only the coefficients within AKIMA_UPDATE_RADIUS nodes of a changed grid value depend on it.
+ * For each changed grid value, they are recomputed on a sub-grid of at most
+ * AKIMA_UPDATE_BOX_SIZE nodes along each dimension, and are identical to the coefficients
+ * computed by akimaFixedGrid_precompute_double().
+ *
+ * <b>NOTE: Each changed grid value costs a sub-grid computation. If most of the grid values
+ *          changed, akimaFixedGrid_precompute_double() is faster.</b>
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *                          In MATLAB notation, the underlying N-D grid is given by:
+ *                          <tt>[XX1,...,XXN] = ndgrid(x1,...,xN)</tt>.
+ * \param[in]  gridValues   Values at each grid node, including the changed values.
+ * \param[in]  numChanged   Number of changed grid values.
+ * \param[in]  changedIndices  0-based linear indices of the changed grid values. Indices
+ *                             outside the grid are ignored.
+ * \param[in]  workspace1   \b Pre-allocated workspace for floating-point quantities
+ *                          (see akimaFixedGrid_updateWS()).
+ * \param[in]  workspace2   \b Pre-allocated workspace for MFL_INTERP_UINT.
+ *
+ * \param[in,out]  coefficients  Akima cubic polynomial coefficients pre-computed by
+ *                               akimaFixedGrid_precompute_double().
+ */
+
+void akimaFixedGrid_update_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const double*  gridValues,
+    const MFL_INTERP_UINT         numChanged,
+    const MFL_INTERP_UINT*        changedIndices,
+    double*        work1,
+    MFL_INTERP_UINT*              work2,
+    /* OUTPUTS: */
+    double*        coefficients
+);
+
 /**
  * Interpolate using pre-computed Akima cubic polynomial coefficients for fixed grid vectors and
  * grid values, but different query points.
@@ -103,6 +148,169 @@ void akimaFixedGrid_interpolate_double
 );
 
 
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients for fixed grid vectors and
+ * grid values, evaluating several query points at a time with SIMD instructions.
+ *
+ * Same parameters and results as akimaFixedGrid_interpolate_double(), except that the
+ * workspaces must be sized by akimaFixedGrid_interpolateBatchedWS().
+ */
+
+void akimaFixedGrid_interpolateBatched_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
+/**
+ * Choose the bin search strategy of each grid vector for
+ * akimaFixedGrid_interpolateWithBinSearch_double() and
+ * akimaFixedGrid_interpolateBatchedWithBinSearch_double().
+ *
+ * Grid vectors with few nodes keep the linear search, evenly spaced grid vectors compute the bin
+ * directly, and the others try the bin of the previous query point before a binary search (see
+ * akimaBinSearch.h). All strategies return the same bins as the linear search.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *                          In MATLAB notation, the underlying N-D grid is given by:
+ *                          <tt>[XX1,...,XXN] = ndgrid(x1,...,xN)</tt>.
+ *
+ * \param[out] binSearch    Bin search descriptors. Must be \b pre-allocated with
+ *                          akimaFixedGrid_binSearchWS() elements.
+ */
+
+void akimaFixedGrid_precomputeBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    /* OUTPUTS: */
+    double*        binSearch
+);
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients and bin search strategies
+ * for fixed grid vectors and grid values, but different query points.
+ *
+ * Same results as akimaFixedGrid_interpolate_double(), but the bins of the query points are
+ * found with the strategies chosen by akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace for floating-point quantities,
+ *                                  sized by akimaFixedGrid_interpolateWithBinSearchWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                                  akimaFixedGrid_interpolateWithBinSearchWS().
+ * \param[in]  binSearch            Bin search strategies computed by
+ *                                  akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const double*  binSearch,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
+/**
+ * Batched variant of akimaFixedGrid_interpolateWithBinSearch_double(). See
+ * akimaFixedGrid_interpolateBatched_double().
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace for floating-point quantities,
+ *                                  sized by akimaFixedGrid_interpolateBatchedWithBinSearchWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                                  akimaFixedGrid_interpolateBatchedWithBinSearchWS().
+ * \param[in]  binSearch            Bin search strategies computed by
+ *                                  akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateBatchedWithBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const double*  binSearch,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients for fixed grid vectors and
+ * grid values, splitting the query points across the threads of the pool created by
+ * akimaThreadPoolInit().
+ *
+ * Same results as akimaFixedGrid_interpolate_double(). Calls with few query points, calls made
+ * while the pool is busy, and builds without MFL_INTERP_MT run serially on the calling thread.
+ *
+ * \param[in]  numThreads  Number of per-thread workspaces in \p workspace1 and \p workspace2,
+ *                         usually akimaThreadPoolGetNumThreads().
+ * \param[in]  workspace1  \b Pre-allocated workspace for floating-point quantities, sized by
+ *                         akimaFixedGrid_interpolateParallelWS().
+ * \param[in]  workspace2  \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                         akimaFixedGrid_interpolateParallelWS().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateParallel_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    const MFL_INTERP_UINT         numThreads,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
 /**
  * Pre-compute Akima cubic Hermite basis for fixed grid vectors and query points,
  * but different grid values.
@@ -280,6 +488,40 @@ void akimaFixedGrid_precompute_1D_double
     double*       coefficients
 );
 
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Update pre-computed Akima cubic polynomial coefficients after some grid values changed.
+ * See akimaFixedGrid_update_double().
+ *
+ * \param[in]  nx            Number of 1-D grid coordinates.
+ * \param[in]  x             Vector of 1-D grid coordinates.
+ * \param[in]  v             Vector of 1-D grid values, including the changed values.
+ * \param[in]  numChanged    Number of changed grid values.
+ * \param[in]  changedIndices  0-based indices of the changed grid values. Indices outside the
+ *                             grid are ignored.
+ * \param[in]  workspace     \b Pre-allocated workspace for floating-point quantities
+ *                           (see akimaFixedGrid_updateWS_1D()).
+ *
+ * \param[in,out]  coefficients  Akima cubic polynomial coefficients pre-computed by
+ *                               akimaFixedGrid_precompute_1D_double().
+ */
+
+void akimaFixedGrid_update_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const double* v,
+    const MFL_INTERP_UINT        numChanged,
+    const MFL_INTERP_UINT*       changedIndices,
+    double*       workspace,
+    /* OUTPUTS: */
+    double*       coefficients
+);
+
 /**
  * Optimized 1-D function.
  *
@@ -328,6 +570,61 @@ void akimaFixedGrid_interpolate_1D_double
     double*       vq
 );
 
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Choose the bin search strategy of a 1-D grid vector for
+ * akimaFixedGrid_interpolateWithBinSearch_1D_double(). See
+ * akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * \param[in]  nx            Number of 1-D grid coordinates.
+ * \param[in]  x             Vector of 1-D grid coordinates.
+ *
+ * \param[out]  binSearch    Bin search descriptor. Must be \b pre-allocated with
+ *                           <tt>akimaFixedGrid_binSearchWS(1)</tt> elements.
+ */
+
+void akimaFixedGrid_precomputeBinSearch_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    /* OUTPUTS: */
+    double*       binSearch
+);
+
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Same results as akimaFixedGrid_interpolate_1D_double(), but the bins of the query points are
+ * found with the strategy chosen by akimaFixedGrid_precomputeBinSearch_1D_double().
+ *
+ * \param[in]  binSearch    Bin search strategy computed by
+ *                          akimaFixedGrid_precomputeBinSearch_1D_double().
+ *
+ * See akimaFixedGrid_interpolate_1D_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearch_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const MFL_INTERP_UINT        extrapMethod,
+    const MFL_INTERP_UINT        noDerivatives,
+    double*       coefficients,
+    const double* binSearch,
+    const MFL_INTERP_UINT        numQ,
+    const double* xq,
+    const MFL_INTERP_UINT*       binsXq,
+    /* OUTPUTS: */
+    double*       vq
+);
+
 
 /**
  * Optimized 1-D function.
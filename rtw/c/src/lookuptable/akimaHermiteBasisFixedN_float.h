@@ -0,0 +1,110 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+/**
+ * \file
+ * N-D Akima cubic interpolant evaluation for a compile-time number of dimensions.
+ *
+ * This file is a template: akimaHermiteBasis_float.c includes it once for each
+ * <tt>AKIMA_FIXED_N = 1, ..., AKIMA_FIXED_N_MAX</tt> to define
+ * akimaEvaluationViaHermiteBasisN1_float(), ..., akimaEvaluationViaHermiteBasisN4_float().
+ * With \p N known at compile time, the loops over the dimensions and the 2^N corners of the
+ * N-D cube have constant trip counts and are unrolled by the compiler, and the strides, the
+ * N-D cube and the Hermite basis live on the stack.
+ *
+ * The results are identical to the general code in akimaEvaluationViaHermiteBasis_float().
+ */
+
+#ifndef AKIMA_FIXED_N
+#error "Define AKIMA_FIXED_N before including akimaHermiteBasisFixedN_float.h"
+#endif
+
+#ifndef AKIMA_FIXED_N_FCN_float
+#define AKIMA_FIXED_N_CAT_float(n) akimaEvaluationViaHermiteBasisN ## n ## _float
+#define AKIMA_FIXED_N_FCN_float(n) AKIMA_FIXED_N_CAT_float(n)
+#endif
+
+#define AKIMA_FIXED_POW2N (1 << AKIMA_FIXED_N)
+
+static void AKIMA_FIXED_N_FCN_float(AKIMA_FIXED_N)
+(
+    /* INPUTS:  */
+    const float** gridVectors,
+    const MFL_INTERP_UINT*        gridSize,
+    const MFL_INTERP_UINT         extrapMethod,
+    const float*  coefficients,
+    const MFL_INTERP_UINT         noDerivatives,
+    const MFL_INTERP_UINT         numVq,
+    const float** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    const float*  binSearch,
+    float*        hermXq,
+    /* OUTPUTS: */
+    float*        Vq
+)
+{
+    MFL_INTERP_UINT gridSizeCumprod[AKIMA_FIXED_N];
+    MFL_INTERP_UINT lastBins[AKIMA_FIXED_N];
+    MFL_INTERP_UINT strides[AKIMA_FIXED_POW2N];
+    MFL_INTERP_UINT gridNumel, ii, ii2, jj, jjh, hh, cc, kk, qq;
+    float H[2*AKIMA_FIXED_N];
+    float dH[2*AKIMA_FIXED_N];
+    float ndcube[AKIMA_FIXED_POW2N];
+    float vq;
+
+    gridNumel = akimaProd(gridSize,AKIMA_FIXED_N);
+    memcpy(gridSizeCumprod,gridSize,AKIMA_FIXED_N*sizeof(MFL_INTERP_UINT));
+    akimaCumprod(gridSizeCumprod,AKIMA_FIXED_N);
+    memset(lastBins,0,AKIMA_FIXED_N*sizeof(MFL_INTERP_UINT));
+
+    /* Offsets of the N-D cube corners, in the same order as the general code: */
+    strides[0] = 0;
+    for (ii = 0; ii < AKIMA_FIXED_N; ++ii) {
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) {
+            strides[jj] = strides[jj-ii2] + gridSizeCumprod[ii];
+        }
+    }
+
+    for (kk = 0; kk < numVq; ++kk) {
+
+        qq = akimaHermiteBasisND_float(
+                                    kk,
+                                    gridVectors,
+                                    gridSize,
+                                    gridSizeCumprod,
+                                    AKIMA_FIXED_N,
+                                    extrapMethod,
+                                    noDerivatives,
+                                    numVq,
+                                    Xq,
+                                    binsXq,
+                                    binSearch,
+                                    lastBins,
+                                    hermXq,
+                                    H,
+                                    dH);
+
+        vq = 0;
+        for (jj = 0; jj < AKIMA_FIXED_POW2N; ++jj) {
+
+            /* Copy Akima coefficients at corner qq+strides[jj] to a contiguous N-D cube: */
+            for (cc = 0; cc < AKIMA_FIXED_POW2N; ++cc) {
+                ndcube[cc] = coefficients[cc*gridNumel + qq + strides[jj]];
+            }
+
+            /* Collapse the cube one dimension at a time (see akimaHermitePolynomialND_float): */
+            for (ii = AKIMA_FIXED_N; ii > 0; --ii) {
+                jjh = 2*(AKIMA_FIXED_N-ii) + ((jj >> (AKIMA_FIXED_N-ii)) & 1);
+                ii2 = ((MFL_INTERP_UINT)1) << (ii-1);
+                for (hh = 0; hh < ii2; ++hh) {
+                    ndcube[hh] = ndcube[2*hh] * H[jjh] + ndcube[2*hh+1] * dH[jjh];
+                }
+            }
+
+            vq = (jj == 0) ? ndcube[0] : vq + ndcube[0];
+        }
+        Vq[kk] = vq;
+    }
+}
+
+#undef AKIMA_FIXED_POW2N
@@ -3,6 +3,8 @@
 #include <string.h> /* memcpy, memset */
 
 #include "akimaHermiteBasis_double.h"
+#include "akimaBinSearch.h"
+#include "akimaSimd.h"
 #include "akimaStrides.h"
 #include "akimaUtils_double.h"
 
@@ -11,6 +13,28 @@
  * Evaluate N-D Akima cubic polynomial using a Hermite basis.
  */
 
+/**
+ * Grids with up to AKIMA_FIXED_N_MAX dimensions are evaluated by code specialized on the
+ * number of dimensions (see akimaHermiteBasisFixedN_double.h).
+ */
+#define AKIMA_FIXED_N_MAX 4
+
+#define AKIMA_FIXED_N 1
+#include "akimaHermiteBasisFixedN_double.h"
+#undef AKIMA_FIXED_N
+
+#define AKIMA_FIXED_N 2
+#include "akimaHermiteBasisFixedN_double.h"
+#undef AKIMA_FIXED_N
+
+#define AKIMA_FIXED_N 3
+#include "akimaHermiteBasisFixedN_double.h"
+#undef AKIMA_FIXED_N
+
+#define AKIMA_FIXED_N 4
+#include "akimaHermiteBasisFixedN_double.h"
+#undef AKIMA_FIXED_N
+
 /**
  * Evaluate N-D Akima cubic interpolant at query points using a Hermite basis.
  *
@@ -47,6 +71,9 @@
  *                      bin n-2: xn-1 <= xq
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
+ * \param[in]  binSearch  Bin search descriptors set up by akimaBinSearchSetup_double(), used
+ *                        when \p binsXq is null. May be null; otherwise \p workspaceIndices
+ *                        holds N more elements for the bins of the previous query point.
  *
  * \param[out] Vq  If \p noDerivatives = 1, returns interpolation results at query points \p Xq.
  *                 Else, returns derivatives at query points \p Xq.
@@ -66,6 +93,7 @@ void akimaEvaluationViaHermiteBasis_double
     const MFL_INTERP_UINT         numVq,
     const double** Xq,
     MFL_INTERP_UINT**             binsXq,
+    const double*  binSearch,
     double*        hermXq,
     /* OUTPUTS: */
     double*        Vq
@@ -75,10 +103,37 @@ void akimaEvaluationViaHermiteBasis_double
     MFL_INTERP_UINT* gridSizeCumprod;
     MFL_INTERP_UINT* strides;
     MFL_INTERP_UINT* indH;
+    MFL_INTERP_UINT* lastBins;
     double* ndcube;
     double* H;
     double* dH;
 
+    /* Dimension-specialized evaluation for 1-D to AKIMA_FIXED_N_MAX-D grids: */
+    switch (N) {
+      case 1:
+        akimaEvaluationViaHermiteBasisN1_double(gridVectors, gridSize, extrapMethod, coefficients,
+                                                noDerivatives, numVq, Xq, binsXq, binSearch,
+                                                hermXq, Vq);
+        return;
+      case 2:
+        akimaEvaluationViaHermiteBasisN2_double(gridVectors, gridSize, extrapMethod, coefficients,
+                                                noDerivatives, numVq, Xq, binsXq, binSearch,
+                                                hermXq, Vq);
+        return;
+      case 3:
+        akimaEvaluationViaHermiteBasisN3_double(gridVectors, gridSize, extrapMethod, coefficients,
+                                                noDerivatives, numVq, Xq, binsXq, binSearch,
+                                                hermXq, Vq);
+        return;
+      case 4:
+        akimaEvaluationViaHermiteBasisN4_double(gridVectors, gridSize, extrapMethod, coefficients,
+                                                noDerivatives, numVq, Xq, binsXq, binSearch,
+                                                hermXq, Vq);
+        return;
+      default:
+        break;
+    }
+
     pow2toN = ((MFL_INTERP_UINT)1) << N;
     gridNumel = akimaProd(gridSize,N);
 
@@ -87,6 +142,8 @@ void akimaEvaluationViaHermiteBasis_double
      *  workspaceIndices[0,N)                         - for A = [1 cumprod(A(1:N-1))] (in MATLAB)
      *  workspaceIndices[N,N + 2^N)                   - 2^N-vector for strides
      *  workspaceIndices[N+2^N,N+2^N + N*2^N)         - Nx2^N matrix of indices
+     *  workspaceIndices[N+(N+1)*2^N, ... + N)        - bins of the previous query point,
+     *                                                  only with non-null binSearch
      */
     gridSizeCumprod = workspaceIndices;
     memcpy(gridSizeCumprod,gridSize,N*sizeof(MFL_INTERP_UINT));
@@ -95,6 +152,10 @@ void akimaEvaluationViaHermiteBasis_double
     strides[0] = 0; /* except for the first stride */
     indH = strides + pow2toN;
     memset(indH,0,N*pow2toN*sizeof(MFL_INTERP_UINT)); /* must be 0-initialized */
+    lastBins = binSearch ? indH + N*pow2toN : (MFL_INTERP_UINT*)0;
+    if (lastBins) {
+        memset(lastBins,0,N*sizeof(MFL_INTERP_UINT));
+    }
 
     /*
      * Evaluation workspace usage:
@@ -149,6 +210,8 @@ void akimaEvaluationViaHermiteBasis_double
                                     numVq,
                                     Xq,
                                     binsXq,
+                                    binSearch,
+                                    lastBins,
                                     hermXq,
                                     H,
                                     dH);
@@ -205,6 +268,194 @@ void akimaEvaluationViaHermiteBasis_double
     }
 }
 
+/**
+ * Evaluate N-D Akima cubic interpolant at query points using a Hermite basis, processing
+ * AKIMA_BATCH_double query points at a time.
+ *
+ * Same inputs and results as akimaEvaluationViaHermiteBasis_double(), but the Hermite basis,
+ * gathered Akima coefficients and partial sums of each batch are kept in structure-of-arrays
+ * layout so that the 2^N cube collapse runs across query points in SIMD registers.
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace sized by
+ *                                  akimaFixedGrid_interpolateBatchedWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace sized by
+ *                                  akimaFixedGrid_interpolateBatchedWS().
+ *
+ * See akimaEvaluationViaHermiteBasis_double() for the remaining parameters.
+ */
+void akimaEvaluationViaHermiteBasisBatched_double
+(
+    /* INPUTS:  */
+    const double** gridVectors,
+    const MFL_INTERP_UINT*        gridSize,
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT         extrapMethod,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const MFL_INTERP_UINT         noDerivatives,
+    const MFL_INTERP_UINT         numVq,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    const double*  binSearch,
+    double*        hermXq,
+    /* OUTPUTS: */
+    double*        Vq
+)
+{
+    MFL_INTERP_UINT pow2toN, gridNumel, ii, ii2, jj, hh, kk, ll, cc, jjh, offset, numLanes;
+    MFL_INTERP_UINT* gridSizeCumprod;
+    MFL_INTERP_UINT* strides;
+    MFL_INTERP_UINT* indH;
+    MFL_INTERP_UINT* lastBins;
+    MFL_INTERP_UINT* qq;
+    const MFL_INTERP_UINT* indHjj;
+    const MFL_INTERP_UINT batch = AKIMA_BATCH_double;
+    double* ndcube;
+    double* H;
+    double* dH;
+    double* Hlane;
+    double* dHlane;
+    double* acc;
+
+    pow2toN = ((MFL_INTERP_UINT)1) << N;
+    gridNumel = akimaProd(gridSize,N);
+
+    /*
+     * Indices workspace usage:
+     *  workspaceIndices[0,N)                         - for A = [1 cumprod(A(1:N-1))] (in MATLAB)
+     *  workspaceIndices[N,N + 2^N)                   - 2^N-vector for strides
+     *  workspaceIndices[N+2^N,N+2^N + N*2^N)         - Nx2^N matrix of indices
+     *  workspaceIndices[N+(N+1)*2^N, ... + N)        - bins of the previous query point,
+     *                                                  only with non-null binSearch
+     *  followed by batch entries                     - linear index of each query in the batch
+     */
+    gridSizeCumprod = workspaceIndices;
+    memcpy(gridSizeCumprod,gridSize,N*sizeof(MFL_INTERP_UINT));
+    akimaCumprod(gridSizeCumprod,N);
+    strides = gridSizeCumprod + N;
+    indH = strides + pow2toN;
+    memset(indH,0,N*pow2toN*sizeof(MFL_INTERP_UINT)); /* must be 0-initialized */
+    if (binSearch) {
+        lastBins = indH + N*pow2toN;
+        memset(lastBins,0,N*sizeof(MFL_INTERP_UINT));
+        qq = lastBins + N;
+    }
+    else {
+        lastBins = (MFL_INTERP_UINT*)0;
+        qq = indH + N*pow2toN;
+    }
+
+    /*
+     * Evaluation workspace usage (each batched quantity holds batch lanes):
+     *  ndcube   2^N batched entries   - contiguous N-D cube
+     *  H, dH    2*N batched entries   - Hermite basis coefficients
+     *  acc      1 batched entry       - interpolation result
+     *  Hlane    2*N entries           - Hermite basis of a single query point
+     *  dHlane   2*N entries
+     */
+    ndcube = workspaceEvaluation;
+    H = ndcube + pow2toN*batch;
+    dH = H + 2*N*batch;
+    acc = dH + 2*N*batch;
+    Hlane = acc + batch;
+    dHlane = Hlane + 2*N;
+
+    /* Same 2^N x N pattern of Hermite coefficient entries as the scalar evaluation: */
+    for (ii = 0; ii < N; ++ii) {
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) { /* skip jj = 0 */
+            for (hh = 0; hh < N; ++hh) {
+                indH[ jj*N + hh ] = (hh == ii) ? 1 : indH[ (jj - ii2)*N + hh ];
+            }
+        }
+    }
+
+    /* Offsets of the N-D cube corners do not depend on the query point: */
+    strides[0] = 0;
+    for (ii = 0; ii < N; ++ii) {
+        ii2 = ((MFL_INTERP_UINT)1) << ii;
+        for (jj = ii2; jj < 2*ii2; ++jj) {
+            strides[jj] = strides[jj-ii2] + gridSizeCumprod[ii];
+        }
+    }
+
+    for (kk = 0; kk < numVq; kk += batch) {
+
+        numLanes = (numVq - kk < batch) ? (numVq - kk) : batch;
+
+        /*
+         * Form the Hermite basis of each query point in the batch and transpose it into
+         * structure-of-arrays layout. Unused lanes of a partial batch repeat the last query.
+         */
+        for (ll = 0; ll < batch; ++ll) {
+            if (ll < numLanes) {
+                qq[ll] = akimaHermiteBasisND_double(
+                                            kk+ll,
+                                            gridVectors,
+                                            gridSize,
+                                            gridSizeCumprod,
+                                            N,
+                                            extrapMethod,
+                                            noDerivatives,
+                                            numVq,
+                                            Xq,
+                                            binsXq,
+                                            binSearch,
+                                            lastBins,
+                                            hermXq,
+                                            Hlane,
+                                            dHlane);
+            }
+            else {
+                qq[ll] = qq[ll-1];
+            }
+            for (hh = 0; hh < 2*N; ++hh) {
+                H[hh*batch + ll] = Hlane[hh];
+                dH[hh*batch + ll] = dHlane[hh];
+            }
+        }
+
+        /*
+         * Sum the interpolation results obtained at each corner of the N-D cube, in the same
+         * order as the scalar evaluation.
+         */
+        for (jj = 0; jj < pow2toN; ++jj) {
+
+            /* Gather the Akima coefficients at corner qq+strides[jj] of every lane: */
+            for (cc = 0; cc < pow2toN; ++cc) {
+                offset = cc*gridNumel + strides[jj];
+                for (ll = 0; ll < batch; ++ll) {
+                    ndcube[cc*batch + ll] = coefficients[offset + qq[ll]];
+                }
+            }
+
+            /* Collapse the cube one dimension at a time: */
+            indHjj = indH + jj*N;
+            for (ii = N; ii > 0; --ii) {
+                jjh = (2*(N-ii) + indHjj[N-ii])*batch;
+                ii2 = ((MFL_INTERP_UINT)1) << (ii-1);
+                for (hh = 0; hh < ii2; ++hh) {
+                    AKIMA_BATCH_COLLAPSE_double(ndcube + hh*batch,
+                                                ndcube + 2*hh*batch,
+                                                ndcube + (2*hh+1)*batch,
+                                                H + jjh,
+                                                dH + jjh);
+                }
+            }
+
+            if (jj == 0) {
+                memcpy(acc,ndcube,batch*sizeof(double));
+            }
+            else {
+                AKIMA_BATCH_ACCUMULATE_double(acc, ndcube);
+            }
+        }
+
+        memcpy(Vq+kk,acc,numLanes*sizeof(double));
+    }
+}
+
 /**
  * Evaluate 1-D Akima cubic interpolant at query points using a Hermite basis.
  *
@@ -221,6 +472,8 @@ void akimaEvaluationViaHermiteBasis_double
  * \param[in]  numVq         Number of 1-D query points.
  * \param[in]  xq            1-D query points.
  * \param[in]  bq            Pre-computed bins for the query points. If NULL, compute the bins.
+ * \param[in]  binSearch     Bin search descriptor set up by akimaBinSearchSetup1D_double(), used
+ *                           when \p bq is NULL. May be NULL.
  *
  * \param[out] vq  If \p noDerivatives = 1, returns interpolation results at query points \p xq.
  *                 Else, returns derivatives at query points \p xq.
@@ -237,6 +490,7 @@ void akimaEvaluationViaHermiteBasis1D_double
     const MFL_INTERP_UINT        numVq,
     const double* xq,
     const MFL_INTERP_UINT*       bq,
+    const double* binSearch,
     /* OUTPUTS: */
     double*       vq
 )
@@ -247,10 +501,11 @@ void akimaEvaluationViaHermiteBasis1D_double
     /*
      * Evaluate 1-D Akima polynomial interpolant.
      */
+    b = 0;
     for (kk = 0; kk < numVq; ++kk) {
 
         /* Compute the bins if needed */
-        b = bq ? bq[kk] : akimaFindGridInterval1D_double(x,nx,xq[kk]);
+        b = bq ? bq[kk] : akimaFindGridIntervalFast1D_double(x,nx,binSearch,xq[kk],b);
 
         /*
          * Form Hermite basis for each 1-D query point.
@@ -382,6 +637,9 @@ double akimaHermitePolynomialND_double
  *                      bin n-2: xn-1 <= xq
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
+ * \param[in]  binSearch  Bin search descriptors, or null. See akimaBinSearchSetup_double().
+ * \param[in]  lastBins   Bins of the previous query point, updated when \p binsXq is null.
+ *                        May be null.
  *
  * \param[out]  H      First Hermite basis coefficient.
  * \param[out]  dH     Second Hermite basis coefficient.
@@ -400,6 +658,8 @@ MFL_INTERP_UINT akimaHermiteBasisND_double
     const MFL_INTERP_UINT         numVq,
     const double** Xq,
     MFL_INTERP_UINT**             binsXq,
+    const double*  binSearch,
+    MFL_INTERP_UINT*              lastBins,
     double*        hermXq,
     /* OUTPUTS: */
     double*        H,
@@ -412,10 +672,20 @@ MFL_INTERP_UINT akimaHermiteBasisND_double
     kk2 = 2*kk;
     for (jj = 0; jj < N; ++jj) {
 
-        b = binsXq ? binsXq[jj][kk]
-                   : akimaFindGridInterval1D_double(gridVectors[jj],
-                                                                   gridSize[jj],
-                                                                   Xq[jj][kk]);
+        if (binsXq) {
+            b = binsXq[jj][kk];
+        }
+        else {
+            b = akimaFindGridIntervalFast1D_double(
+                            gridVectors[jj],
+                            gridSize[jj],
+                            binSearch ? binSearch + jj*AKIMA_BIN_SEARCH_NUMEL : binSearch,
+                            Xq[jj][kk],
+                            lastBins ? lastBins[jj] : 0);
+            if (lastBins) {
+                lastBins[jj] = b;
+            }
+        }
 
         if (hermXq != 0) {
             /* Just copy over the pre-computed Hermite basis coefficients: */
@@ -46,6 +46,9 @@
  *                      bin n-2: xn-1 <= xq
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
+ * \param[in]  binSearch  Bin search descriptors set up by akimaBinSearchSetup_float(), used
+ *                        when \p binsXq is null. May be null; otherwise \p workspaceIndices
+ *                        holds N more elements for the bins of the previous query point.
  *
  * \param[out] Vq  If \p noDerivatives = 1, returns interpolation results at query points \p Xq.
  *                 Else, returns derivatives at query points \p Xq.
@@ -65,6 +68,39 @@ void akimaEvaluationViaHermiteBasis_float
     const MFL_INTERP_UINT         numVq,
     const float** Xq,
     MFL_INTERP_UINT**             binsXq,
+    const float*  binSearch,
+    float*        hermXq,
+    /* OUTPUTS: */
+    float*        Vq
+);
+
+/**
+ * Evaluate N-D Akima cubic interpolant at query points using a Hermite basis, processing
+ * AKIMA_BATCH_float query points at a time in structure-of-arrays layout (AVX2/NEON when
+ * available). Results are identical to akimaEvaluationViaHermiteBasis_float().
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace sized by
+ *                                  akimaFixedGrid_interpolateBatchedWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace sized by
+ *                                  akimaFixedGrid_interpolateBatchedWS().
+ *
+ * See akimaEvaluationViaHermiteBasis_float() for the remaining parameters.
+ */
+void akimaEvaluationViaHermiteBasisBatched_float
+(
+    /* INPUTS:  */
+    const float** gridVectors,
+    const MFL_INTERP_UINT*        gridSize,
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT         extrapMethod,
+    float*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    float*        coefficients,
+    const MFL_INTERP_UINT         noDerivatives,
+    const MFL_INTERP_UINT         numVq,
+    const float** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    const float*  binSearch,
     float*        hermXq,
     /* OUTPUTS: */
     float*        Vq
@@ -86,6 +122,8 @@ void akimaEvaluationViaHermiteBasis_float
  * \param[in]  numVq         Number of 1-D query points.
  * \param[in]  xq            1-D query points.
  * \param[in]  bq            Pre-computed bins for the query points. If NULL, compute the bins.
+ * \param[in]  binSearch     Bin search descriptor set up by akimaBinSearchSetup1D_float(), used
+ *                           when \p bq is NULL. May be NULL.
  *
  * \param[out] vq  If \p noDerivatives = 1, returns interpolation results at query points \p xq.
  *                 Else, returns derivatives at query points \p xq.
@@ -102,6 +140,7 @@ void akimaEvaluationViaHermiteBasis1D_float
     const MFL_INTERP_UINT        numVq,
     const float* xq,
     const MFL_INTERP_UINT*       bq,
+    const float* binSearch,
     /* OUTPUTS: */
     float*       vq
 );
@@ -162,6 +201,9 @@ float akimaHermitePolynomialND_float
  *                      bin n-2: xn-1 <= xq
  *                    binsXq has the same size as Xq and must be \b pre-allocated.
  *                    Use null binsXq to indicate that the bins have not been pre-computed.
+ * \param[in]  binSearch  Bin search descriptors, or null. See akimaBinSearchSetup_float().
+ * \param[in]  lastBins   Bins of the previous query point, updated when \p binsXq is null.
+ *                        May be null.
  *
  * \param[out]  H      First Hermite basis coefficient.
  * \param[out]  dH     Second Hermite basis coefficient.
@@ -180,6 +222,8 @@ MFL_INTERP_UINT akimaHermiteBasisND_float
     const MFL_INTERP_UINT         numVq,
     const float** Xq,
     MFL_INTERP_UINT**             binsXq,
+    const float*  binSearch,
+    MFL_INTERP_UINT*              lastBins,
     float*        hermXq,
     /* OUTPUTS: */
     float*        H,
@@ -0,0 +1,114 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+#ifndef _MFL_INTERP_AKIMASIMD_H_
+#define _MFL_INTERP_AKIMASIMD_H_
+
+#include "mfl_interp_util.h" /* MFL_INTERP_UINT */
+
+/**
+ * \file
+ * Vector primitives for batched Akima evaluation.
+ *
+ * Batched evaluation processes AKIMA_BATCH_double (AKIMA_BATCH_float) query points at a time
+ * in structure-of-arrays layout: lane l of quantity c is stored at <tt>a[c*batch + l]</tt>.
+ * The primitives use AVX2 or NEON (AArch64) when the compiler targets them and plain lane
+ * loops otherwise. Products and sums are rounded exactly as in the scalar code (no fused
+ * multiply-add), so batched and scalar evaluation return identical results unless the compiler
+ * contracts the scalar code into fused multiply-adds (e.g. -ffp-contract=fast with FMA enabled).
+ */
+
+/**
+ * Number of query points evaluated together. AKIMA_BATCH_MAX bounds both and is used to
+ * size the batched evaluation workspace independently of the floating-point type.
+ */
+#define AKIMA_BATCH_double 4
+#define AKIMA_BATCH_float  8
+#define AKIMA_BATCH_MAX    8
+
+#if defined(__AVX2__) && !defined(MFL_INTERP_NO_SIMD)
+
+#include <immintrin.h>
+
+/** dst[l] = lo[l]*h[l] + hi[l]*dh[l] for all lanes. \p dst may alias \p lo. */
+#define AKIMA_BATCH_COLLAPSE_double(dst, lo, hi, h, dh)                             \
+    _mm256_storeu_pd((dst), _mm256_add_pd(                                          \
+                         _mm256_mul_pd(_mm256_loadu_pd(lo), _mm256_loadu_pd(h)),    \
+                         _mm256_mul_pd(_mm256_loadu_pd(hi), _mm256_loadu_pd(dh))))
+
+#define AKIMA_BATCH_COLLAPSE_float(dst, lo, hi, h, dh)                              \
+    _mm256_storeu_ps((dst), _mm256_add_ps(                                          \
+                         _mm256_mul_ps(_mm256_loadu_ps(lo), _mm256_loadu_ps(h)),    \
+                         _mm256_mul_ps(_mm256_loadu_ps(hi), _mm256_loadu_ps(dh))))
+
+/** acc[l] += a[l] for all lanes. */
+#define AKIMA_BATCH_ACCUMULATE_double(acc, a)                                       \
+    _mm256_storeu_pd((acc), _mm256_add_pd(_mm256_loadu_pd(acc), _mm256_loadu_pd(a)))
+
+#define AKIMA_BATCH_ACCUMULATE_float(acc, a)                                        \
+    _mm256_storeu_ps((acc), _mm256_add_ps(_mm256_loadu_ps(acc), _mm256_loadu_ps(a)))
+
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(MFL_INTERP_NO_SIMD)
+
+#include <arm_neon.h>
+
+#define AKIMA_NEON_COLLAPSE_F64(dst, lo, hi, h, dh)                                 \
+    vst1q_f64((dst), vaddq_f64(vmulq_f64(vld1q_f64(lo), vld1q_f64(h)),              \
+                               vmulq_f64(vld1q_f64(hi), vld1q_f64(dh))))
+
+#define AKIMA_NEON_COLLAPSE_F32(dst, lo, hi, h, dh)                                 \
+    vst1q_f32((dst), vaddq_f32(vmulq_f32(vld1q_f32(lo), vld1q_f32(h)),              \
+                               vmulq_f32(vld1q_f32(hi), vld1q_f32(dh))))
+
+#define AKIMA_BATCH_COLLAPSE_double(dst, lo, hi, h, dh)                             \
+    {                                                                               \
+        AKIMA_NEON_COLLAPSE_F64((dst),   (lo),   (hi),   (h),   (dh));              \
+        AKIMA_NEON_COLLAPSE_F64((dst)+2, (lo)+2, (hi)+2, (h)+2, (dh)+2);            \
+    }
+
+#define AKIMA_BATCH_COLLAPSE_float(dst, lo, hi, h, dh)                              \
+    {                                                                               \
+        AKIMA_NEON_COLLAPSE_F32((dst),   (lo),   (hi),   (h),   (dh));              \
+        AKIMA_NEON_COLLAPSE_F32((dst)+4, (lo)+4, (hi)+4, (h)+4, (dh)+4);            \
+    }
+
+#define AKIMA_BATCH_ACCUMULATE_double(acc, a)                                       \
+    {                                                                               \
+        vst1q_f64((acc),   vaddq_f64(vld1q_f64(acc),   vld1q_f64(a)));              \
+        vst1q_f64((acc)+2, vaddq_f64(vld1q_f64((acc)+2), vld1q_f64((a)+2)));        \
+    }
+
+#define AKIMA_BATCH_ACCUMULATE_float(acc, a)                                        \
+    {                                                                               \
+        vst1q_f32((acc),   vaddq_f32(vld1q_f32(acc),   vld1q_f32(a)));              \
+        vst1q_f32((acc)+4, vaddq_f32(vld1q_f32((acc)+4), vld1q_f32((a)+4)));        \
+    }
+
+#else
+
+/* Portable lane loops (auto-vectorized by most compilers): */
+
+#define AKIMA_BATCH_LANES(batch, expr)                                              \
+    {                                                                               \
+        MFL_INTERP_UINT ll_;                                                        \
+        for (ll_ = 0; ll_ < (batch); ++ll_) {                                       \
+            expr;                                                                   \
+        }                                                                           \
+    }
+
+#define AKIMA_BATCH_COLLAPSE_double(dst, lo, hi, h, dh)                             \
+    AKIMA_BATCH_LANES(AKIMA_BATCH_double,                                           \
+                      (dst)[ll_] = (lo)[ll_] * (h)[ll_] + (hi)[ll_] * (dh)[ll_])
+
+#define AKIMA_BATCH_COLLAPSE_float(dst, lo, hi, h, dh)                              \
+    AKIMA_BATCH_LANES(AKIMA_BATCH_float,                                            \
+                      (dst)[ll_] = (lo)[ll_] * (h)[ll_] + (hi)[ll_] * (dh)[ll_])
+
+#define AKIMA_BATCH_ACCUMULATE_double(acc, a)                                       \
+    AKIMA_BATCH_LANES(AKIMA_BATCH_double, (acc)[ll_] += (a)[ll_])
+
+#define AKIMA_BATCH_ACCUMULATE_float(acc, a)                                        \
+    AKIMA_BATCH_LANES(AKIMA_BATCH_float, (acc)[ll_] += (a)[ll_])
+
+#endif
+
+#endif /* _MFL_INTERP_AKIMASIMD_H_ */
@@ -0,0 +1,93 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+#include <stdlib.h> /* getenv, atoi */
+
+#include "akimaThreadPool.h"
+#include "rt_workerpool.h"
+
+/**
+ * \file
+ * Splitting of Akima interpolation across query points.
+ *
+ * akimaThreadPoolInit() attaches to the worker pool shared with the other runtime libraries
+ * (rt_workerpool.h), so that interpolation and the matrix library use one set of threads. A
+ * call is only split when the pool has workers and no other split call is in progress;
+ * otherwise the caller runs serially. Calls made from a worker therefore always run serially.
+ */
+
+/** Number of threads a call is split across, including the caller. 1 while not attached. */
+static MFL_INTERP_UINT akimaNumThreads = 1;
+
+/** Arguments of akimaThreadPoolRunChunk(). */
+typedef struct akimaThreadPoolJob_tag {
+    akimaThreadPoolFcn fcn;
+    void*              args;
+} akimaThreadPoolJob;
+
+static void akimaThreadPoolRunChunk(void* arg, int_T chunkIdx, int_T numChunks)
+{
+    const akimaThreadPoolJob* job = (const akimaThreadPoolJob*)arg;
+    job->fcn(job->args, (MFL_INTERP_UINT)chunkIdx, (MFL_INTERP_UINT)numChunks);
+}
+
+MFL_INTERP_UINT akimaThreadPoolInit(MFL_INTERP_UINT numThreads)
+{
+    MFL_INTERP_UINT poolThreads;
+    const char* env;
+
+    if (akimaNumThreads > 1) {
+        return akimaNumThreads; /* already initialized */
+    }
+
+    if (numThreads == 0) {
+        env = getenv(AKIMA_THREADPOOL_NUM_THREADS_ENV);
+        numThreads = (env != 0 && atoi(env) > 0) ? (MFL_INTERP_UINT)atoi(env) : 1;
+    }
+    if (numThreads > AKIMA_THREADPOOL_MAX_THREADS) {
+        numThreads = AKIMA_THREADPOOL_MAX_THREADS;
+    }
+    if (numThreads <= 1) {
+        return 1;
+    }
+
+    poolThreads = (MFL_INTERP_UINT)rt_WorkerPoolInit((int_T)numThreads);
+    if (poolThreads <= 1) {
+        rt_WorkerPoolTerminate();
+        return 1;
+    }
+    akimaNumThreads = (numThreads < poolThreads) ? numThreads : poolThreads;
+
+    return akimaNumThreads;
+}
+
+void akimaThreadPoolTerminate(void)
+{
+    if (akimaNumThreads <= 1) {
+        return;
+    }
+    akimaNumThreads = 1;
+    rt_WorkerPoolTerminate();
+}
+
+MFL_INTERP_UINT akimaThreadPoolGetNumThreads(void)
+{
+    return akimaNumThreads;
+}
+
+MFL_INTERP_UINT akimaThreadPoolRun(akimaThreadPoolFcn fcn,
+                                   void*              args,
+                                   MFL_INTERP_UINT    numChunks)
+{
+    akimaThreadPoolJob job;
+
+    if (akimaNumThreads <= 1 || numChunks < 2) {
+        return 0;
+    }
+    if (numChunks > akimaNumThreads) {
+        numChunks = akimaNumThreads;
+    }
+
+    job.fcn = fcn;
+    job.args = args;
+    return rt_WorkerPoolRun(akimaThreadPoolRunChunk, &job, (int_T)numChunks) ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+#ifndef _MFL_INTERP_AKIMATHREADPOOL_H_
+#define _MFL_INTERP_AKIMATHREADPOOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mfl_interp_util.h" /* MFL_INTERP_UINT */
+
+/**
+ * \file
+ * Splitting of Akima interpolation across query points, using the worker pool shared with the
+ * other runtime libraries (rt_workerpool.h).
+ *
+ * The pool is only available when compiled with MFL_INTERP_MT (POSIX threads). Without it,
+ * akimaThreadPoolInit() returns 1 and every parallel entry point runs serially.
+ */
+
+/**
+ * Maximum number of threads taking part in a parallel call, including the caller. The shared
+ * pool itself holds at most RT_WORKERPOOL_MAX_THREADS.
+ */
+#define AKIMA_THREADPOOL_MAX_THREADS 64
+
+/**
+ * Calls are split only if <tt>numQ * 2^N</tt> is at least this large, so that small query
+ * counts stay on the calling thread.
+ */
+#define AKIMA_THREADPOOL_MIN_WORK 65536
+
+/**
+ * Queries are split only for grids with at most this many dimensions (size of the per-chunk
+ * arrays of query pointers).
+ */
+#define AKIMA_THREADPOOL_MAX_DIMS 32
+
+/** Environment variable read by akimaThreadPoolInit() when called with 0 threads. */
+#define AKIMA_THREADPOOL_NUM_THREADS_ENV "MFL_INTERP_NUM_THREADS"
+
+/**
+ * Work item run on each thread.
+ *
+ * \param[in]  args       Arguments of the parallel call.
+ * \param[in]  chunkIdx   Index of this chunk, <tt>0 <= chunkIdx < numChunks</tt>.
+ * \param[in]  numChunks  Number of chunks the call is split into.
+ */
+typedef void (*akimaThreadPoolFcn)(void* args,
+                                   MFL_INTERP_UINT chunkIdx,
+                                   MFL_INTERP_UINT numChunks);
+
+/**
+ * Attach Akima interpolation to the shared worker pool, creating its threads if no other
+ * library did.
+ *
+ * \param[in]  numThreads  Total number of threads taking part in a parallel call, including
+ *                         the caller. If 0, the count is read from the environment variable
+ *                         AKIMA_THREADPOOL_NUM_THREADS_ENV.
+ *
+ * \return  Number of threads in use, at most the size of the shared pool. 1 means that
+ *          interpolation stays serial.
+ */
+MFL_INTERP_UINT akimaThreadPoolInit(MFL_INTERP_UINT numThreads);
+
+/**
+ * Detach from the shared worker pool. Subsequent calls run serially. The threads are joined
+ * once no library uses the pool.
+ */
+void akimaThreadPoolTerminate(void);
+
+/**
+ * \return  Number of threads taking part in a parallel call, including the caller.
+ */
+MFL_INTERP_UINT akimaThreadPoolGetNumThreads(void);
+
+/**
+ * Run \p fcn on up to \p numChunks threads and wait for all of them.
+ *
+ * \param[in]  fcn        Work item.
+ * \param[in]  args       Arguments passed to \p fcn.
+ * \param[in]  numChunks  Maximum number of chunks. The call uses fewer chunks if the pool has
+ *                        fewer threads.
+ *
+ * \return  1 if \p fcn was run, 0 (without calling \p fcn) if the pool is not available or is
+ *          in use by another call. The caller then runs serially.
+ */
+MFL_INTERP_UINT akimaThreadPoolRun(akimaThreadPoolFcn fcn,
+                                   void*              args,
+                                   MFL_INTERP_UINT    numChunks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MFL_INTERP_AKIMATHREADPOOL_H_ */
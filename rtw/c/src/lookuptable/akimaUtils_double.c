@@ -3,6 +3,7 @@
 #include <math.h> /* fabs */
 
 #include "akimaUtils_double.h"
+#include "akimaBinSearch.h"
 
 /**
  * \file
@@ -134,3 +135,184 @@ MFL_INTERP_UINT akimaGridVectorsAreValid_double
     }
     return isValid;
 }
+
+/**
+ * Choose the bin search strategy for a 1-D grid vector.
+ *
+ * \param[in]  x          Vector of 1-D grid coordinates.
+ * \param[in]  nx         Number of 1-D grid coordinates.
+ *
+ * \param[out] binSearch  AKIMA_BIN_SEARCH_NUMEL entries describing the bin search.
+ */
+void akimaBinSearchSetup1D_double
+(
+    /* INPUTS:  */
+    const double* x,
+    const MFL_INTERP_UINT        nx,
+    /* OUTPUTS: */
+    double*       binSearch
+)
+{
+    MFL_INTERP_UINT jj, isUniform;
+    double h;
+
+    binSearch[0] = (double)AKIMA_BIN_SEARCH_LINEAR;
+    binSearch[1] = x[0];
+    binSearch[2] = 0;
+
+    if (nx <= AKIMA_BIN_SEARCH_LINEAR_MAX) {
+        return;
+    }
+
+    /* Evenly spaced grid vectors get an O(1) index computation: */
+    h = (x[nx-1] - x[0]) / (double)(nx-1);
+    isUniform = 1;
+    for (jj = 1; jj < nx-1; ++jj) {
+        if ( !(akimaAbs_double(x[jj] - (x[0] + (double)jj*h))
+               <= h/AKIMA_BIN_SEARCH_UNIFORM_TOL) ) {
+            isUniform = 0;
+            break;
+        }
+    }
+
+    if (isUniform) {
+        binSearch[0] = (double)AKIMA_BIN_SEARCH_UNIFORM;
+        binSearch[2] = 1/h;
+    }
+    else {
+        binSearch[0] = (double)AKIMA_BIN_SEARCH_CACHED;
+    }
+}
+
+/**
+ * Choose the bin search strategy for each grid vector of an N-D grid.
+ *
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out] binSearch    AKIMA_BIN_SEARCH_NUMEL*N entries describing the bin searches.
+ */
+void akimaBinSearchSetup_double
+(
+    /* INPUTS:  */
+    const double** gridVectors,
+    const MFL_INTERP_UINT*        gridSize,
+    const MFL_INTERP_UINT         N,
+    /* OUTPUTS: */
+    double*        binSearch
+)
+{
+    MFL_INTERP_UINT ii;
+
+    for (ii = 0; ii < N; ++ii) {
+        akimaBinSearchSetup1D_double(
+                                gridVectors[ii],
+                                gridSize[ii],
+                                binSearch + ii*AKIMA_BIN_SEARCH_NUMEL);
+    }
+}
+
+/**
+ * Count the entries of a strictly increasing vector which are less than a query point, using
+ * a binary search without data-dependent branches.
+ *
+ * \param[in]  x    Strictly increasing vector.
+ * \param[in]  n    <tt>numel(x)</tt>, at least 1.
+ * \param[in]  xq   Query point.
+ *
+ * \return  <tt>sum(x < xq)</tt>. NaN query points return 0.
+ */
+static MFL_INTERP_UINT akimaCountLess_double
+(
+    const double* x,
+    MFL_INTERP_UINT              n,
+    const double  xq
+)
+{
+    const double* base = x;
+    MFL_INTERP_UINT half;
+
+    while (n > 1) {
+        half = n/2;
+        base = (base[half] < xq) ? base + half : base;
+        n -= half;
+    }
+    return (MFL_INTERP_UINT)(base - x) + ((base[0] < xq) ? 1 : 0);
+}
+
+/**
+ * Find the bins (grid intervals) containing a given 1-D query point using the strategy chosen
+ * by akimaBinSearchSetup1D_double().
+ *
+ * \param[in]  x          Vector of 1-D grid coordinates.
+ * \param[in]  n          <tt>numel(x)</tt>.
+ * \param[in]  binSearch  Bin search descriptor of \p x. If null, the strategy is chosen from
+ *                        \p n alone (evenly spaced grid vectors are not detected).
+ * \param[in]  xq         Query point.
+ * \param[in]  lastBin    Bin of the previous query point, or 0.
+ *
+ * \return  Bin (interval) number of x which contains xq. Same as akimaFindGridInterval1D_double().
+ */
+MFL_INTERP_UINT akimaFindGridIntervalFast1D_double
+(
+    const double* x,
+    const MFL_INTERP_UINT        n,
+    const double* binSearch,
+    const double  xq,
+    const MFL_INTERP_UINT        lastBin
+)
+{
+    MFL_INTERP_UINT method, last, b;
+    double k;
+
+    method = binSearch ? (MFL_INTERP_UINT)binSearch[0]
+                       : ((n > AKIMA_BIN_SEARCH_LINEAR_MAX) ? AKIMA_BIN_SEARCH_CACHED
+                                                           : AKIMA_BIN_SEARCH_LINEAR);
+    if (method == AKIMA_BIN_SEARCH_LINEAR) {
+        return akimaFindGridInterval1D_double(x,n,xq);
+    }
+
+    /*
+     * Same bins as the linear search: n-2 for xq >= x[n-2], otherwise the number of
+     * nodes x[1], ..., x[n-3] strictly less than xq.
+     */
+    last = n-2;
+    if (x[last] <= xq) {
+        return last;
+    }
+
+    if (method == AKIMA_BIN_SEARCH_UNIFORM) {
+        k = (xq - binSearch[1]) * binSearch[2];
+        if (k >= (double)(last-1)) {
+            b = last-1;
+        }
+        else if (k >= 1) {
+            b = (MFL_INTERP_UINT)k;
+        }
+        else {
+            b = 0; /* also for NaN */
+        }
+        /* Correct for rounding in the index computation: */
+        while (b > 0 && !(x[b] < xq)) {
+            --b;
+        }
+        while (b < last-1 && x[b+1] < xq) {
+            ++b;
+        }
+        return b;
+    }
+
+    /* Try the bin of the previous query point and its successor: */
+    b = (lastBin < last) ? lastBin : last-1;
+    if (b == 0 || x[b] < xq) {
+        if (b+1 == last || !(x[b+1] < xq)) {
+            return b;
+        }
+        ++b;
+        if (b+1 == last || !(x[b+1] < xq)) {
+            return b;
+        }
+    }
+    return akimaCountLess_double(x+1,last-1,xq);
+}
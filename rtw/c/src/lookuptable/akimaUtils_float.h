@@ -35,6 +35,63 @@ MFL_INTERP_UINT akimaFindGridInterval1D_float
     const float   xq
 );
 
+/**
+ * Choose the bin search strategy for a 1-D grid vector.
+ *
+ * \param[in]  x          Vector of 1-D grid coordinates.
+ * \param[in]  nx         Number of 1-D grid coordinates.
+ *
+ * \param[out] binSearch  AKIMA_BIN_SEARCH_NUMEL entries describing the bin search.
+ */
+void akimaBinSearchSetup1D_float
+(
+    /* INPUTS:  */
+    const float* x,
+    const MFL_INTERP_UINT        nx,
+    /* OUTPUTS: */
+    float*       binSearch
+);
+
+/**
+ * Choose the bin search strategy for each grid vector of an N-D grid.
+ *
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ * \param[in]  gridSize     Size of the underlying N-D grid.
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out] binSearch    AKIMA_BIN_SEARCH_NUMEL*N entries describing the bin searches.
+ */
+void akimaBinSearchSetup_float
+(
+    /* INPUTS:  */
+    const float** gridVectors,
+    const MFL_INTERP_UINT*        gridSize,
+    const MFL_INTERP_UINT         N,
+    /* OUTPUTS: */
+    float*        binSearch
+);
+
+/**
+ * Find the bins (grid intervals) containing a given 1-D query point using the strategy chosen
+ * by akimaBinSearchSetup1D_float().
+ *
+ * \param[in]  x          Vector of 1-D grid coordinates.
+ * \param[in]  n          <tt>numel(x)</tt>.
+ * \param[in]  binSearch  Bin search descriptor of \p x, or null.
+ * \param[in]  xq         Query point.
+ * \param[in]  lastBin    Bin of the previous query point, or 0.
+ *
+ * \return  Bin (interval) number of x which contains xq.
+ */
+MFL_INTERP_UINT akimaFindGridIntervalFast1D_float
+(
+    const float*  x,
+    const MFL_INTERP_UINT         n,
+    const float*  binSearch,
+    const float   xq,
+    const MFL_INTERP_UINT         lastBin
+);
+
 /**
  * Check that 1-D grid coordinates are strictly increasing and finite.
  *
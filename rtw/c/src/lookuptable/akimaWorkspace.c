@@ -1,7 +1,9 @@
 /* Copyright 2019 The MathWorks, Inc.*/
 
 #include "akimaWorkspace.h"
+#include "akimaBinSearch.h"
 #include "akimaStrides.h"
+#include "akimaSimd.h"
 
 /**
  * \file
@@ -103,6 +105,70 @@ void akimaFixedGrid_precomputeWS_1D
     *numelCoefficients = 2*nx;
 }
 
+/**
+ * Compute workspace size for akimaFixedGrid_update_double() and
+ * akimaFixedGrid_update_float().
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_updateWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT* gridSize,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+)
+{
+    MFL_INTERP_UINT boxSize[AKIMA_UPDATE_MAX_DIMS];
+    MFL_INTERP_UINT boxNumel, pow2toN, numelBoxWorkspace1, numelBoxWorkspace2,
+        numelBoxCoefficients, ii;
+
+    /* Largest sub-grid recomputed around a changed grid value: */
+    for (ii = 0; ii < N; ++ii) {
+        boxSize[ii] = (gridSize[ii] < AKIMA_UPDATE_BOX_SIZE) ? gridSize[ii] : AKIMA_UPDATE_BOX_SIZE;
+    }
+    boxNumel = akimaProd(boxSize,N);
+    pow2toN = ((MFL_INTERP_UINT)1) << N;
+
+    akimaFixedGrid_precomputeWS(N, boxSize,
+                                &numelBoxWorkspace1, &numelBoxWorkspace2, &numelBoxCoefficients);
+
+    /* Sub-grid values and coefficients, followed by the coefficients workspace: */
+    *numelWorkspace1 = boxNumel*(1+pow2toN) + numelBoxWorkspace1;
+    /* Sizes, cumprods and start indices of the grid and the sub-grids, followed by the
+     * coefficients workspace: */
+    *numelWorkspace2 = 6*N + numelBoxWorkspace2;
+}
+
+/**
+ * Compute workspace size for akimaFixedGrid_update_1D_double() and
+ * akimaFixedGrid_update_1D_float().
+ *
+ * \param[in]  nx                 Number of 1-D grid coordinates.
+ *
+ * \return  Workspace size for floating-point quantities.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_updateWS_1D
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT nx
+)
+{
+    MFL_INTERP_UINT boxSize = (nx < AKIMA_UPDATE_BOX_SIZE) ? nx : AKIMA_UPDATE_BOX_SIZE;
+    /* Sub-grid coefficients, followed by the coefficients workspace: */
+    return 2*boxSize + 2*boxSize+3;
+}
+
 /**
  * Compute workspace size for akimaFixedGrid_interpolate_double() and
  * akimaFixedGrid_interpolate_float().
@@ -129,6 +195,177 @@ void akimaFixedGrid_interpolateWS
     *numelWorkspaceIndices = N+(N+1)*pow2toN;
 }
 
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateBatched_double() and
+ * akimaFixedGrid_interpolateBatched_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateBatchedWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+)
+{
+    MFL_INTERP_UINT pow2toN = ((MFL_INTERP_UINT)1) << N;
+    /* Per-lane N-D cube, basis, basis derivatives and sum, plus one lane of basis terms: */
+    *numelWorkspace1 = (pow2toN+4*N+1)*AKIMA_BATCH_MAX + 4*N;
+    /* Intermediate N-D indices and batch of query indices */
+    *numelWorkspace2 = N+(N+1)*pow2toN + AKIMA_BATCH_MAX;
+}
+
+/**
+ * Compute storage size for akimaFixedGrid_precomputeBinSearch_double() and
+ * akimaFixedGrid_precomputeBinSearch_float(), or with \p N = 1 for
+ * akimaFixedGrid_precomputeBinSearch_1D_double() and
+ * akimaFixedGrid_precomputeBinSearch_1D_float().
+ *
+ * \param[in]  N  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \return  Number of floating-point elements to store the bin search strategies.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_binSearchWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N
+)
+{
+    return AKIMA_BIN_SEARCH_NUMEL*N;
+}
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateWithBinSearch_double() and
+ * akimaFixedGrid_interpolateWithBinSearch_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearchWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+)
+{
+    /* akimaFixedGrid_interpolateWS(), followed by the bins of the previous query point: */
+    akimaFixedGrid_interpolateWS(N, numelWorkspace1, numelWorkspace2);
+    *numelWorkspace2 += N;
+}
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateBatchedWithBinSearch_double() and
+ * akimaFixedGrid_interpolateBatchedWithBinSearch_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateBatchedWithBinSearchWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+)
+{
+    /* akimaFixedGrid_interpolateBatchedWS(), plus the bins of the previous query point: */
+    akimaFixedGrid_interpolateBatchedWS(N, numelWorkspace1, numelWorkspace2);
+    *numelWorkspace2 += N;
+}
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateParallel_double() and
+ * akimaFixedGrid_interpolateParallel_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  numThreads         Number of threads, usually akimaThreadPoolGetNumThreads().
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateParallelWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT  numThreads,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+)
+{
+    MFL_INTERP_UINT numelWorkspaceEvaluation, numelWorkspaceIndices;
+
+    /* One akimaFixedGrid_interpolateWS() workspace per thread: */
+    akimaFixedGrid_interpolateWS(N, &numelWorkspaceEvaluation, &numelWorkspaceIndices);
+    *numelWorkspace1 = numThreads*numelWorkspaceEvaluation;
+    *numelWorkspace2 = numThreads*numelWorkspaceIndices;
+}
+
+/**
+ * Compute storage size for akimaFixedGrid_compact_double().
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ *
+ * \return  Number of float elements to store the single-precision Akima coefficients.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_compactWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT* gridSize
+)
+{
+    MFL_INTERP_UINT pow2toN = ((MFL_INTERP_UINT)1) << N;
+    /* Single-precision coefficients: */
+    return akimaProd(gridSize,N)*pow2toN;
+}
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateCompact_double().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateCompactWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+)
+{
+    MFL_INTERP_UINT pow2toN = ((MFL_INTERP_UINT)1) << N;
+    /* N-D cube, H and dH coefficients: */
+    *numelWorkspace1 = 4*N+pow2toN;
+    /* Intermediate N-D indices, strides and bins of the previous query point */
+    *numelWorkspace2 = 2*N+pow2toN;
+}
+
 /**
  * Compute workspace size for akimaFixedQuery_precompute_double() and
  * akimaFixedQuery_precompute_float().
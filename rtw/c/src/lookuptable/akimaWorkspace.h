@@ -59,6 +59,59 @@ void akimaFixedGrid_precomputeWS_1D
     MFL_INTERP_UINT* numelCoefficients
 );
 
+/**
+ * An Akima coefficient at a grid node only depends on the grid values within
+ * AKIMA_UPDATE_RADIUS nodes along each dimension. akimaFixedGrid_update_double() recomputes
+ * the coefficients around each changed grid value on a sub-grid of at most
+ * AKIMA_UPDATE_BOX_SIZE nodes along each dimension.
+ */
+#define AKIMA_UPDATE_RADIUS   2
+#define AKIMA_UPDATE_BOX_SIZE (4*AKIMA_UPDATE_RADIUS+1)
+
+/**
+ * Maximum \p N for akimaFixedGrid_update_double(). Larger grids cannot be represented, since
+ * the 2^N coefficient arrays are counted in MFL_INTERP_UINT.
+ */
+#define AKIMA_UPDATE_MAX_DIMS 32
+
+/**
+ * Compute workspace size for akimaFixedGrid_update_double() and
+ * akimaFixedGrid_update_float().
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_updateWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT* gridSize,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+);
+
+/**
+ * Compute workspace size for akimaFixedGrid_update_1D_double() and
+ * akimaFixedGrid_update_1D_float().
+ *
+ * \param[in]  nx                 Number of 1-D grid coordinates.
+ *
+ * \return  Workspace size for floating-point quantities.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_updateWS_1D
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT nx
+);
+
 /**
  * Compute workspace size for akimaFixedGrid_interpolate_double() and
  * akimaFixedGrid_interpolate_float().
@@ -78,6 +131,137 @@ void akimaFixedGrid_interpolateWS
     MFL_INTERP_UINT* numelWorkspace2
 );
 
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateBatched_double() and
+ * akimaFixedGrid_interpolateBatched_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateBatchedWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+);
+
+/**
+ * Compute storage size for akimaFixedGrid_precomputeBinSearch_double() and
+ * akimaFixedGrid_precomputeBinSearch_float(), or with \p N = 1 for
+ * akimaFixedGrid_precomputeBinSearch_1D_double() and
+ * akimaFixedGrid_precomputeBinSearch_1D_float().
+ *
+ * \param[in]  N  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \return  Number of floating-point elements to store the bin search strategies.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_binSearchWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N
+);
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateWithBinSearch_double() and
+ * akimaFixedGrid_interpolateWithBinSearch_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearchWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+);
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateBatchedWithBinSearch_double() and
+ * akimaFixedGrid_interpolateBatchedWithBinSearch_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateBatchedWithBinSearchWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+);
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateParallel_double() and
+ * akimaFixedGrid_interpolateParallel_float().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  numThreads         Number of threads, usually akimaThreadPoolGetNumThreads().
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateParallelWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT  numThreads,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+);
+
+/**
+ * Compute storage size for akimaFixedGrid_compact_double().
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ *
+ * \return  Number of float elements to store the single-precision Akima coefficients.
+ */
+
+MFL_INTERP_UINT akimaFixedGrid_compactWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    const MFL_INTERP_UINT* gridSize
+);
+
+/**
+ * Compute workspace size for akimaFixedGrid_interpolateCompact_double().
+ *
+ * \param[in]  N                  Number of dimensions of underlying N-D grid, i.e., \p N.
+ *
+ * \param[out]  numelWorkspace1   Workspace size for floating-point quantities.
+ * \param[out]  numelWorkspace2   Workspace size for MFL_INTERP_UINT quantities.
+ */
+
+void akimaFixedGrid_interpolateCompactWS
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT  N,
+    /* OUTPUTS: */
+    MFL_INTERP_UINT* numelWorkspace1,
+    MFL_INTERP_UINT* numelWorkspace2
+);
+
 /**
  * Compute workspace size for akimaFixedQuery_precompute_double() and
  * akimaFixedQuery_precompute_float().
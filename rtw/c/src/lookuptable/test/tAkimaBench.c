@@ -0,0 +1,527 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+/**
+ * \file
+ * Benchmark of the fixed-grid Akima interpolation routines, in single and double precision, for
+ * N = 1, ..., 4, small and large grids, evenly and unevenly spaced grid vectors, and random,
+ * monotone and clustered query streams.
+ *
+ * Each path is reported in ns/query, with the workspace it needs per call and the data it keeps
+ * between calls (coefficients, bin search strategies, pre-computed bins or Akima basis). The
+ * prelookup paths are akimaQueryBins_double() alone and interpolation with the bins it returns.
+ * The results of every path are compared with akimaFixedGrid_interpolate_double() (or _float);
+ * a path fails if it differs by more than T_TOL_EXACT_DOUBLE (T_TOL_EXACT_FLOAT) relative to
+ * <tt>max(abs(Vq))</tt>, or by more than T_TOL_COMPACT for the single-precision coefficients of
+ * akimaFixedGrid_interpolateCompact_double().
+ *
+ * Build and run from the lookuptable directory, e.g.:
+ * <tt>cc -O2 -I. -I../.. -I<matlabroot>/extern/include -I<matlabroot>/simulink/include
+ *     test/tAkimaBench.c akima*.c ../../rt_workerpool.c -lm && ./a.out [numQ [numThreads]]</tt>
+ * Add <tt>-DMFL_INTERP_MT -lpthread</tt> to measure akimaFixedGrid_interpolateParallel_double()
+ * on more than one thread. Returns 0 if all paths pass.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "akimaEvaluation_double.h"
+#include "akimaEvaluation_float.h"
+#include "akimaCompact_double.h"
+#include "akimaWorkspace.h"
+#include "akimaThreadPool.h"
+
+#define T_NUMQ              (10000)
+#define T_MIN_TIME          (0.05)      /* seconds timed per path */
+#define T_MAX_COEFFICIENTS  (1 << 23)   /* larger grids are skipped */
+#define T_CLUSTER_LEN       (256)       /* queries around one cluster center */
+#define T_EXTRAP            (0)         /* Akima extrapolation */
+#define T_VALUES            (1)         /* noDerivatives */
+#define T_TOL_EXACT_DOUBLE  (1e-12)
+#define T_TOL_EXACT_FLOAT   (1e-5)
+#define T_TOL_COMPACT       (5e-3)
+
+/* Query streams */
+#define T_QUERY_RANDOM      (0)
+#define T_QUERY_MONOTONE    (1)
+#define T_QUERY_CLUSTERED   (2)
+
+static const char* tQueryNames[3] = { "random", "monotone", "clustered" };
+
+/* Grid size along each dimension: small and large grid for N = 1, ..., 4 */
+static const MFL_INTERP_UINT tGridSizes[4][2] = { { 16, 65536 }, { 16, 256 }, { 8, 40 },
+                                                  { 6, 16 } };
+
+/** One grid and query stream in one precision. The pointers are double* or float*. */
+typedef struct tCase_tag {
+    MFL_INTERP_UINT  N;
+    MFL_INTERP_UINT  gridSize[4];
+    MFL_INTERP_UINT  numQ;
+    MFL_INTERP_UINT  numThreads;
+    MFL_INTERP_UINT  numelCoefficients;
+    int              isSingle;
+    void*            gridVectors[4];
+    void*            gridValues;
+    void*            coefficients;
+    float*           compactCoefficients;
+    void*            binSearch;
+    void*            akimaBasis;
+    void*            Xq[4];
+    MFL_INTERP_UINT* binsXq[4];
+} tCase;
+
+/*=============================*
+ * Paths under measure         *
+ *=============================*/
+
+typedef void (*tPathFcn)(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq);
+
+#define T_WRAP_INTERP(name, fcn, T, bins)                                                   \
+    static void name(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq)            \
+    {                                                                                       \
+        fcn(c->N, c->gridSize, (const T**)c->gridVectors, T_EXTRAP, T_VALUES, (T*)ws1, ws2, \
+            (T*)c->coefficients, c->numQ, (const T**)c->Xq, bins, (T*)Vq);                  \
+    }
+
+#define T_WRAP_BINSEARCH(name, fcn, T)                                                      \
+    static void name(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq)            \
+    {                                                                                       \
+        fcn(c->N, c->gridSize, (const T**)c->gridVectors, T_EXTRAP, T_VALUES, (T*)ws1, ws2, \
+            (T*)c->coefficients, (const T*)c->binSearch, c->numQ, (const T**)c->Xq, NULL,   \
+            (T*)Vq);                                                                        \
+    }
+
+#define T_WRAP_PARALLEL(name, fcn, T)                                                       \
+    static void name(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq)            \
+    {                                                                                       \
+        fcn(c->N, c->gridSize, (const T**)c->gridVectors, T_EXTRAP, T_VALUES,               \
+            c->numThreads, (T*)ws1, ws2, (T*)c->coefficients, c->numQ, (const T**)c->Xq,    \
+            NULL, (T*)Vq);                                                                  \
+    }
+
+#define T_WRAP_FIXEDQUERY(name, fcn, T)                                                     \
+    static void name(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq)            \
+    {                                                                                       \
+        fcn(c->N, c->gridSize, (const T**)c->gridVectors, (const T*)c->gridValues,          \
+            T_EXTRAP, T_VALUES, (T*)ws1, ws2, (T*)c->akimaBasis, c->numQ,                   \
+            (const T**)c->Xq, NULL, (T*)Vq);                                                \
+    }
+
+#define T_WRAP_QUERYBINS(name, fcn, T)                                                      \
+    static void name(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq)            \
+    {                                                                                       \
+        (void)ws1;                                                                          \
+        (void)ws2;                                                                          \
+        (void)Vq;                                                                           \
+        fcn(c->N, c->gridSize, (const T**)c->gridVectors, c->numQ, (const T**)c->Xq,        \
+            (MFL_INTERP_UINT**)c->binsXq);                                                  \
+    }
+
+T_WRAP_INTERP(tInterpolate_double, akimaFixedGrid_interpolate_double, double, NULL)
+T_WRAP_INTERP(tInterpolate_float, akimaFixedGrid_interpolate_float, float, NULL)
+T_WRAP_INTERP(tInterpolateBins_double, akimaFixedGrid_interpolate_double, double,
+              (MFL_INTERP_UINT**)c->binsXq)
+T_WRAP_INTERP(tInterpolateBins_float, akimaFixedGrid_interpolate_float, float,
+              (MFL_INTERP_UINT**)c->binsXq)
+T_WRAP_INTERP(tBatched_double, akimaFixedGrid_interpolateBatched_double, double, NULL)
+T_WRAP_INTERP(tBatched_float, akimaFixedGrid_interpolateBatched_float, float, NULL)
+T_WRAP_BINSEARCH(tBinSearch_double, akimaFixedGrid_interpolateWithBinSearch_double, double)
+T_WRAP_BINSEARCH(tBinSearch_float, akimaFixedGrid_interpolateWithBinSearch_float, float)
+T_WRAP_BINSEARCH(tBatchedBinSearch_double,
+                 akimaFixedGrid_interpolateBatchedWithBinSearch_double, double)
+T_WRAP_BINSEARCH(tBatchedBinSearch_float,
+                 akimaFixedGrid_interpolateBatchedWithBinSearch_float, float)
+T_WRAP_PARALLEL(tParallel_double, akimaFixedGrid_interpolateParallel_double, double)
+T_WRAP_PARALLEL(tParallel_float, akimaFixedGrid_interpolateParallel_float, float)
+T_WRAP_FIXEDQUERY(tFixedQuery_double, akimaFixedQuery_interpolate_double, double)
+T_WRAP_FIXEDQUERY(tFixedQuery_float, akimaFixedQuery_interpolate_float, float)
+T_WRAP_QUERYBINS(tQueryBins_double, akimaQueryBins_double, double)
+T_WRAP_QUERYBINS(tQueryBins_float, akimaQueryBins_float, float)
+
+static void tCompact_double(const tCase* c, void* ws1, MFL_INTERP_UINT* ws2, void* Vq)
+{
+    akimaFixedGrid_interpolateCompact_double(c->N, c->gridSize, (const double**)c->gridVectors,
+                                             T_EXTRAP, T_VALUES, (double*)ws1, ws2,
+                                             c->compactCoefficients, c->numQ,
+                                             (const double**)c->Xq, NULL, (double*)Vq);
+}
+
+/* Kinds of path, which determine the workspace and stored data */
+#define T_PATH_INTERPOLATE        (0)
+#define T_PATH_INTERPOLATE_BINS   (1)
+#define T_PATH_BATCHED            (2)
+#define T_PATH_BINSEARCH          (3)
+#define T_PATH_BATCHED_BINSEARCH  (4)
+#define T_PATH_PARALLEL           (5)
+#define T_PATH_COMPACT            (6)
+#define T_PATH_FIXEDQUERY         (7)
+#define T_PATH_QUERYBINS          (8)
+
+typedef struct tPath_tag {
+    const char* name;
+    int         kind;
+    tPathFcn    fcn[2];     /* double, float; NULL if not available */
+} tPath;
+
+static const tPath tPaths[] = {
+    { "interpolate",       T_PATH_INTERPOLATE,       { tInterpolate_double, tInterpolate_float } },
+    { "querybins",         T_PATH_QUERYBINS,         { tQueryBins_double, tQueryBins_float } },
+    { "interpolate+bins",  T_PATH_INTERPOLATE_BINS,  { tInterpolateBins_double,
+                                                       tInterpolateBins_float } },
+    { "fixedquery",        T_PATH_FIXEDQUERY,        { tFixedQuery_double, tFixedQuery_float } },
+    { "batched",           T_PATH_BATCHED,           { tBatched_double, tBatched_float } },
+    { "binsearch",         T_PATH_BINSEARCH,         { tBinSearch_double, tBinSearch_float } },
+    { "batched+binsearch", T_PATH_BATCHED_BINSEARCH, { tBatchedBinSearch_double,
+                                                       tBatchedBinSearch_float } },
+    { "parallel",          T_PATH_PARALLEL,          { tParallel_double, tParallel_float } },
+    { "compact",           T_PATH_COMPACT,           { tCompact_double, NULL } }
+};
+
+/**
+ * Workspace sizes of one call of a path, and bytes of the data it keeps between calls.
+ */
+static void tFootprint(const tPath* p, const tCase* c, MFL_INTERP_UINT* nws1,
+                       MFL_INTERP_UINT* nws2, size_t* dataBytes)
+{
+    size_t elSize = c->isSingle ? sizeof(float) : sizeof(double);
+    size_t coefficientBytes = c->numelCoefficients * elSize;
+
+    *nws1 = 0;
+    *nws2 = 0;
+    *dataBytes = coefficientBytes;
+    switch (p->kind) {
+    case T_PATH_INTERPOLATE:
+        akimaFixedGrid_interpolateWS(c->N, nws1, nws2);
+        break;
+    case T_PATH_INTERPOLATE_BINS:
+        akimaFixedGrid_interpolateWS(c->N, nws1, nws2);
+        *dataBytes += (size_t)c->N * c->numQ * sizeof(MFL_INTERP_UINT);
+        break;
+    case T_PATH_BATCHED:
+        akimaFixedGrid_interpolateBatchedWS(c->N, nws1, nws2);
+        break;
+    case T_PATH_BINSEARCH:
+        akimaFixedGrid_interpolateWithBinSearchWS(c->N, nws1, nws2);
+        *dataBytes += akimaFixedGrid_binSearchWS(c->N) * elSize;
+        break;
+    case T_PATH_BATCHED_BINSEARCH:
+        akimaFixedGrid_interpolateBatchedWithBinSearchWS(c->N, nws1, nws2);
+        *dataBytes += akimaFixedGrid_binSearchWS(c->N) * elSize;
+        break;
+    case T_PATH_PARALLEL:
+        akimaFixedGrid_interpolateParallelWS(c->N, c->numThreads, nws1, nws2);
+        break;
+    case T_PATH_COMPACT:
+        akimaFixedGrid_interpolateCompactWS(c->N, nws1, nws2);
+        *dataBytes = akimaFixedGrid_compactWS(c->N, c->gridSize) * sizeof(float);
+        break;
+    case T_PATH_FIXEDQUERY:
+        akimaFixedQuery_interpolateWS(c->N, c->gridSize, nws1, nws2);
+        *dataBytes = akimaFixedQuery_precomputeWS(c->N, c->numQ) * elSize;
+        break;
+    default: /* T_PATH_QUERYBINS: the bins are its output */
+        *dataBytes = 0;
+        break;
+    }
+}
+
+/*=============================*
+ * Grids and query streams     *
+ *=============================*/
+
+static double tNow(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static double tRand(void)
+{
+    return rand() / (double)RAND_MAX;
+}
+
+static void* tMalloc(size_t numBytes)
+{
+    void* p = malloc(numBytes > 0 ? numBytes : 1);
+    if (p == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    return p;
+}
+
+/** Copy n doubles into a new array of the precision of the case. */
+static void* tConvert(const tCase* c, const double* x, MFL_INTERP_UINT n)
+{
+    MFL_INTERP_UINT ii;
+    void* y;
+    if (!c->isSingle) {
+        y = tMalloc(n * sizeof(double));
+        memcpy(y, x, n * sizeof(double));
+    } else {
+        y = tMalloc(n * sizeof(float));
+        for (ii = 0; ii < n; ++ii) {
+            ((float*)y)[ii] = (float)x[ii];
+        }
+    }
+    return y;
+}
+
+/**
+ * Query coordinates along one dimension, within [lo, hi]. Clustered queries stay within two
+ * grid steps \p h of a center that moves every T_CLUSTER_LEN queries.
+ */
+static void tQueries(int stream, MFL_INTERP_UINT numQ, double lo, double hi, double h,
+                     double* xq)
+{
+    MFL_INTERP_UINT ii;
+    double center = lo;
+    for (ii = 0; ii < numQ; ++ii) {
+        switch (stream) {
+        case T_QUERY_RANDOM:
+            xq[ii] = lo + (hi - lo) * tRand();
+            break;
+        case T_QUERY_MONOTONE:
+            xq[ii] = lo + (hi - lo) * ((double)ii + 0.5) / (double)numQ;
+            break;
+        default:
+            if (ii % T_CLUSTER_LEN == 0) {
+                center = lo + (hi - lo) * tRand();
+            }
+            xq[ii] = center + 2.0 * h * (2.0 * tRand() - 1.0);
+            if (xq[ii] < lo) xq[ii] = lo;
+            if (xq[ii] > hi) xq[ii] = hi;
+            break;
+        }
+    }
+}
+
+/** Set up the grid, coefficients and query stream of a case. Returns 0 if it is too large. */
+static int tSetup(tCase* c, int uniform, int stream)
+{
+    MFL_INTERP_UINT dd, ii, numelGrid = 1, nws1, nws2, nwsPre, nwsIdxPre;
+    double* x;
+    void* ws1;
+    MFL_INTERP_UINT* ws2;
+
+    akimaFixedGrid_precomputeWS(c->N, c->gridSize, &nwsPre, &nwsIdxPre, &c->numelCoefficients);
+    if (c->numelCoefficients > T_MAX_COEFFICIENTS) {
+        return 0;
+    }
+
+    for (dd = 0; dd < c->N; ++dd) {
+        MFL_INTERP_UINT n = c->gridSize[dd];
+        x = (double*)tMalloc((n > c->numQ ? n : c->numQ) * sizeof(double));
+        for (ii = 0; ii < n; ++ii) {
+            x[ii] = uniform ? (double)ii : (double)ii + 0.4 * sin((double)ii);
+        }
+        c->gridVectors[dd] = tConvert(c, x, n);
+        tQueries(stream, c->numQ, x[0], x[n - 1], (x[n - 1] - x[0]) / (double)(n - 1), x);
+        c->Xq[dd] = tConvert(c, x, c->numQ);
+        c->binsXq[dd] = (MFL_INTERP_UINT*)tMalloc(c->numQ * sizeof(MFL_INTERP_UINT));
+        numelGrid *= n;
+        free(x);
+    }
+    x = (double*)tMalloc(numelGrid * sizeof(double));
+    for (ii = 0; ii < numelGrid; ++ii) {
+        x[ii] = 100.0 * sin(0.001 * (double)ii) + cos(0.37 * (double)ii);
+    }
+    c->gridValues = tConvert(c, x, numelGrid);
+    free(x);
+
+    akimaFixedQuery_interpolateWS(c->N, c->gridSize, &nws1, &nws2);
+    if (nwsPre > nws1) nws1 = nwsPre;
+    if (nwsIdxPre > nws2) nws2 = nwsIdxPre;
+    ws1 = tMalloc(nws1 * (c->isSingle ? sizeof(float) : sizeof(double)));
+    ws2 = (MFL_INTERP_UINT*)tMalloc(nws2 * sizeof(MFL_INTERP_UINT));
+
+    c->coefficients = tMalloc(c->numelCoefficients *
+                              (c->isSingle ? sizeof(float) : sizeof(double)));
+    c->binSearch = tMalloc(akimaFixedGrid_binSearchWS(c->N) *
+                           (c->isSingle ? sizeof(float) : sizeof(double)));
+    c->akimaBasis = tMalloc(akimaFixedQuery_precomputeWS(c->N, c->numQ) *
+                            (c->isSingle ? sizeof(float) : sizeof(double)));
+    c->compactCoefficients = NULL;
+    if (!c->isSingle) {
+        akimaFixedGrid_precompute_double(c->N, c->gridSize, (const double**)c->gridVectors,
+                                         (const double*)c->gridValues, (double*)ws1, ws2,
+                                         (double*)c->coefficients);
+        akimaFixedGrid_precomputeBinSearch_double(c->N, c->gridSize,
+                                                  (const double**)c->gridVectors,
+                                                  (double*)c->binSearch);
+        akimaFixedQuery_precompute_double(c->N, c->gridSize, (const double**)c->gridVectors,
+                                          T_EXTRAP, T_VALUES, c->numQ, (const double**)c->Xq,
+                                          NULL, (double*)c->akimaBasis);
+        c->compactCoefficients =
+            (float*)tMalloc(akimaFixedGrid_compactWS(c->N, c->gridSize) * sizeof(float));
+        akimaFixedGrid_compact_double(c->N, c->gridSize, (const double*)c->coefficients,
+                                      c->compactCoefficients);
+        akimaQueryBins_double(c->N, c->gridSize, (const double**)c->gridVectors, c->numQ,
+                              (const double**)c->Xq, c->binsXq);
+    } else {
+        akimaFixedGrid_precompute_float(c->N, c->gridSize, (const float**)c->gridVectors,
+                                        (const float*)c->gridValues, (float*)ws1, ws2,
+                                        (float*)c->coefficients);
+        akimaFixedGrid_precomputeBinSearch_float(c->N, c->gridSize,
+                                                 (const float**)c->gridVectors,
+                                                 (float*)c->binSearch);
+        akimaFixedQuery_precompute_float(c->N, c->gridSize, (const float**)c->gridVectors,
+                                         T_EXTRAP, T_VALUES, c->numQ, (const float**)c->Xq,
+                                         NULL, (float*)c->akimaBasis);
+        akimaQueryBins_float(c->N, c->gridSize, (const float**)c->gridVectors, c->numQ,
+                             (const float**)c->Xq, c->binsXq);
+    }
+    free(ws1);
+    free(ws2);
+    return 1;
+}
+
+static void tCleanup(tCase* c)
+{
+    MFL_INTERP_UINT dd;
+    for (dd = 0; dd < c->N; ++dd) {
+        free(c->gridVectors[dd]);
+        free(c->Xq[dd]);
+        free(c->binsXq[dd]);
+    }
+    free(c->gridValues);
+    free(c->coefficients);
+    free(c->compactCoefficients);
+    free(c->binSearch);
+    free(c->akimaBasis);
+}
+
+static double tValue(const tCase* c, const void* Vq, MFL_INTERP_UINT ii)
+{
+    return c->isSingle ? (double)((const float*)Vq)[ii] : ((const double*)Vq)[ii];
+}
+
+/*=============================*
+ * Benchmark                   *
+ *=============================*/
+
+/** Time every path of one case. Returns the number of paths that failed. */
+static int tBenchCase(tCase* c, int uniform, int stream)
+{
+    char gridName[32];
+    void* VqRef;
+    void* Vq;
+    double maxAbs = 0.0;
+    size_t elSize = c->isSingle ? sizeof(float) : sizeof(double);
+    size_t pp;
+    MFL_INTERP_UINT ii;
+    int numFailed = 0;
+
+    if (!tSetup(c, uniform, stream)) {
+        printf("SKIP N=%u grid %u^%u: more than %d coefficients\n", (unsigned)c->N,
+               (unsigned)c->gridSize[0], (unsigned)c->N, T_MAX_COEFFICIENTS);
+        return 0;
+    }
+    sprintf(gridName, "%u^%u %s", (unsigned)c->gridSize[0], (unsigned)c->N,
+            uniform ? "uniform" : "nonuniform");
+
+    VqRef = tMalloc(c->numQ * elSize);
+    Vq = tMalloc(c->numQ * elSize);
+
+    for (pp = 0; pp < sizeof(tPaths) / sizeof(tPaths[0]); ++pp) {
+        const tPath* p = &tPaths[pp];
+        tPathFcn fcn = p->fcn[c->isSingle ? 1 : 0];
+        MFL_INTERP_UINT nws1, nws2;
+        size_t dataBytes;
+        void* ws1;
+        MFL_INTERP_UINT* ws2;
+        double t0, t, maxErr = 0.0, tol;
+        long reps, rr;
+        int pass;
+
+        if (fcn == NULL) {
+            continue;
+        }
+        tFootprint(p, c, &nws1, &nws2, &dataBytes);
+        ws1 = tMalloc(nws1 * elSize);
+        ws2 = (MFL_INTERP_UINT*)tMalloc(nws2 * sizeof(MFL_INTERP_UINT));
+
+        fcn(c, ws1, ws2, (p->kind == T_PATH_INTERPOLATE) ? VqRef : Vq);
+        if (p->kind == T_PATH_INTERPOLATE) {
+            for (ii = 0; ii < c->numQ; ++ii) {
+                if (fabs(tValue(c, VqRef, ii)) > maxAbs) maxAbs = fabs(tValue(c, VqRef, ii));
+            }
+        } else if (p->kind != T_PATH_QUERYBINS) {
+            for (ii = 0; ii < c->numQ; ++ii) {
+                double err = fabs(tValue(c, Vq, ii) - tValue(c, VqRef, ii));
+                if (!(err <= maxErr)) maxErr = err;  /* NaN counts as an error */
+            }
+        }
+        tol = ((p->kind == T_PATH_COMPACT) ? T_TOL_COMPACT :
+               (c->isSingle ? T_TOL_EXACT_FLOAT : T_TOL_EXACT_DOUBLE)) * maxAbs;
+        pass = (maxErr <= tol);
+        numFailed += pass ? 0 : 1;
+
+        reps = 1;
+        for (;;) {
+            t0 = tNow();
+            for (rr = 0; rr < reps; ++rr) {
+                fcn(c, ws1, ws2, Vq);
+            }
+            t = tNow() - t0;
+            if (t >= T_MIN_TIME) break;
+            reps *= 2;
+        }
+
+        printf("%s N=%u %-16s %-9s %-6s %-17s %9.1f ns/query  ws %7lu B  data %10lu B  "
+               "error %.1e\n",
+               pass ? "PASS" : "FAIL", (unsigned)c->N, gridName, tQueryNames[stream],
+               c->isSingle ? "float" : "double", p->name, 1e9 * t / ((double)reps * c->numQ),
+               (unsigned long)(nws1 * elSize + nws2 * sizeof(MFL_INTERP_UINT)),
+               (unsigned long)dataBytes, (maxAbs > 0.0) ? maxErr / maxAbs : maxErr);
+        fflush(stdout);
+
+        free(ws1);
+        free(ws2);
+    }
+
+    free(VqRef);
+    free(Vq);
+    tCleanup(c);
+    return numFailed;
+}
+
+int main(int argc, char* argv[])
+{
+    MFL_INTERP_UINT numQ = (argc > 1) ? (MFL_INTERP_UINT)atoi(argv[1]) : T_NUMQ;
+    MFL_INTERP_UINT numThreads =
+        akimaThreadPoolInit((argc > 2) ? (MFL_INTERP_UINT)atoi(argv[2]) : 0);
+    MFL_INTERP_UINT N, dd;
+    int size, uniform, stream, isSingle;
+    int numFailed = 0;
+
+    printf("%u queries, %u thread(s)\n", (unsigned)numQ, (unsigned)numThreads);
+    srand(1);
+    for (N = 1; N <= 4; ++N) {
+        for (size = 0; size < 2; ++size) {
+            for (uniform = 1; uniform >= 0; --uniform) {
+                for (stream = T_QUERY_RANDOM; stream <= T_QUERY_CLUSTERED; ++stream) {
+                    for (isSingle = 0; isSingle < 2; ++isSingle) {
+                        tCase c;
+                        memset(&c, 0, sizeof(c));
+                        c.N = N;
+                        c.numQ = numQ;
+                        c.numThreads = numThreads;
+                        c.isSingle = isSingle;
+                        for (dd = 0; dd < N; ++dd) {
+                            c.gridSize[dd] = tGridSizes[N - 1][size];
+                        }
+                        numFailed += tBenchCase(&c, uniform, stream);
+                    }
+                }
+            }
+        }
+    }
+
+    akimaThreadPoolTerminate();
+    printf("%d path(s) failed\n", numFailed);
+    return (numFailed == 0) ? 0 : 1;
+}
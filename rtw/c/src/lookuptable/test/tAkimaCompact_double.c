@@ -0,0 +1,148 @@
+/* Copyright 2019 The MathWorks, Inc.*/
+
+/**
+ * \file
+ * Accuracy test of akimaFixedGrid_interpolateCompact_double() against the full-precision
+ * akimaFixedGrid_interpolate_double(), for N = 1, ..., 4, all extrapolation methods, values
+ * and derivatives. The tolerances are relative to <tt>max(abs(Vq))</tt> and follow the
+ * accuracy documented in akimaCompact_double.h.
+ *
+ * Build and run from the lookuptable directory, e.g.:
+ * <tt>cc -I. -I../.. -I<matlabroot>/extern/include -I<matlabroot>/simulink/include
+ *     test/tAkimaCompact_double.c akima*.c ../../rt_workerpool.c -lm && ./a.out</tt>
+ * Returns 0 if all cases pass.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "akimaEvaluation_double.h"
+#include "akimaCompact_double.h"
+#include "akimaWorkspace.h"
+
+#define T_NUMQ          (5000)
+#define T_TOL_VALUES    (5e-3)
+#define T_TOL_DERIVS    (2e-2)
+
+/* Grid values: smooth data around zero, and the same variation on a large offset */
+static double tGridValue(MFL_INTERP_UINT dataSet, MFL_INTERP_UINT ii)
+{
+    return (dataSet == 0) ? 100.0*sin(0.001*(double)ii) + cos(0.37*(double)ii) :
+                            1000.0 + sin(0.3*(double)ii);
+}
+
+static int tAkimaCompact(MFL_INTERP_UINT N, MFL_INTERP_UINT dataSet, double h)
+{
+    MFL_INTERP_UINT gridSize[4];
+    double*         gridVectors[4];
+    double*         Xq[4];
+    double          *gridValues, *coefficients, *ws1, *ws2, *Vq, *VqCompact;
+    float*          compactCoefficients;
+    MFL_INTERP_UINT *wsIdx1, *wsIdx2;
+    MFL_INTERP_UINT numelGrid, numelCoefficients, nws1, nwsIdx1, nws2, nwsIdx2, nwsPre, nwsIdxPre;
+    MFL_INTERP_UINT dd, ii, extrapMethod, noDerivatives;
+    int             numFailed = 0;
+
+    numelGrid = 1;
+    for (dd = 0; dd < N; ++dd) {
+        double span;
+        gridSize[dd] = (N == 4) ? 12 : ((N == 3) ? 20 : 40);
+        gridVectors[dd] = (double*)malloc(gridSize[dd]*sizeof(double));
+        for (ii = 0; ii < gridSize[dd]; ++ii) {
+            /* non-uniform spacing */
+            gridVectors[dd][ii] = h*((double)ii + 0.1*sin((double)ii));
+        }
+        span = gridVectors[dd][gridSize[dd]-1] - gridVectors[dd][0];
+        Xq[dd] = (double*)malloc(T_NUMQ*sizeof(double));
+        for (ii = 0; ii < T_NUMQ; ++ii) {
+            /* covers the grid and two grid steps of extrapolation on either side */
+            Xq[dd][ii] = gridVectors[dd][0] - 2.0*h + (span + 4.0*h)*rand()/(double)RAND_MAX;
+        }
+        numelGrid *= gridSize[dd];
+    }
+    gridValues = (double*)malloc(numelGrid*sizeof(double));
+    for (ii = 0; ii < numelGrid; ++ii) {
+        gridValues[ii] = tGridValue(dataSet, ii);
+    }
+
+    akimaFixedGrid_precomputeWS(N, gridSize, &nwsPre, &nwsIdxPre, &numelCoefficients);
+    akimaFixedGrid_interpolateWS(N, &nws1, &nwsIdx1);
+    akimaFixedGrid_interpolateCompactWS(N, &nws2, &nwsIdx2);
+    if (nwsPre > nws1) nws1 = nwsPre;
+    if (nwsIdxPre > nwsIdx1) nwsIdx1 = nwsIdxPre;
+
+    coefficients = (double*)malloc(numelCoefficients*sizeof(double));
+    compactCoefficients = (float*)malloc(akimaFixedGrid_compactWS(N, gridSize)*sizeof(float));
+    ws1 = (double*)malloc(nws1*sizeof(double));
+    ws2 = (double*)malloc(nws2*sizeof(double));
+    wsIdx1 = (MFL_INTERP_UINT*)malloc(nwsIdx1*sizeof(MFL_INTERP_UINT));
+    wsIdx2 = (MFL_INTERP_UINT*)malloc(nwsIdx2*sizeof(MFL_INTERP_UINT));
+    Vq = (double*)malloc(T_NUMQ*sizeof(double));
+    VqCompact = (double*)malloc(T_NUMQ*sizeof(double));
+
+    akimaFixedGrid_precompute_double(N, gridSize, (const double**)gridVectors, gridValues,
+                                     ws1, wsIdx1, coefficients);
+    akimaFixedGrid_compact_double(N, gridSize, coefficients, compactCoefficients);
+
+    for (extrapMethod = 0; extrapMethod < 3; ++extrapMethod) {
+        for (noDerivatives = 0; noDerivatives < 2; ++noDerivatives) {
+            double maxAbs = 0.0, maxErr = 0.0, tol;
+
+            akimaFixedGrid_interpolate_double(N, gridSize, (const double**)gridVectors,
+                                              extrapMethod, noDerivatives, ws1, wsIdx1,
+                                              coefficients, T_NUMQ, (const double**)Xq,
+                                              NULL, Vq);
+            akimaFixedGrid_interpolateCompact_double(N, gridSize, (const double**)gridVectors,
+                                                     extrapMethod, noDerivatives, ws2, wsIdx2,
+                                                     compactCoefficients, T_NUMQ,
+                                                     (const double**)Xq, NULL, VqCompact);
+            for (ii = 0; ii < T_NUMQ; ++ii) {
+                if (fabs(Vq[ii]) > maxAbs) maxAbs = fabs(Vq[ii]);
+                if (fabs(VqCompact[ii] - Vq[ii]) > maxErr) maxErr = fabs(VqCompact[ii] - Vq[ii]);
+            }
+            tol = (noDerivatives ? T_TOL_VALUES : T_TOL_DERIVS)*maxAbs;
+            if (!(maxErr <= tol)) {
+                numFailed++;
+            }
+            printf("%s N=%u data=%u h=%g extrap=%u %-11s relative error %.2e\n",
+                   (maxErr <= tol) ? "PASS" : "FAIL", (unsigned)N, (unsigned)dataSet, h,
+                   (unsigned)extrapMethod, noDerivatives ? "values" : "derivatives",
+                   (maxAbs > 0.0) ? maxErr/maxAbs : maxErr);
+        }
+    }
+
+    for (dd = 0; dd < N; ++dd) {
+        free(gridVectors[dd]);
+        free(Xq[dd]);
+    }
+    free(gridValues);
+    free(coefficients);
+    free(compactCoefficients);
+    free(ws1);
+    free(ws2);
+    free(wsIdx1);
+    free(wsIdx2);
+    free(Vq);
+    free(VqCompact);
+
+    return numFailed;
+}
+
+int main(void)
+{
+    static const double h[3] = { 0.01, 0.1, 1.0 };
+    MFL_INTERP_UINT N, dataSet, hh;
+    int numFailed = 0;
+
+    srand(1);
+    for (N = 1; N <= 4; ++N) {
+        for (dataSet = 0; dataSet < 2; ++dataSet) {
+            for (hh = 0; hh < 3; ++hh) {
+                numFailed += tAkimaCompact(N, dataSet, h[hh]);
+            }
+        }
+    }
+    printf("%d case(s) failed\n", numFailed);
+    return (numFailed == 0) ? 0 : 1;
+}
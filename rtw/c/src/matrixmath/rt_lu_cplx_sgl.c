@@ -21,6 +21,12 @@ void rt_lu_cplx_sgl(creal32_T *A,     /* in and out                         */
 {
   int_T k;
 
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_LuBlas_Sgl(A, n, piv, true)) {
+    return;
+  }
+#endif
+
   /* initialize row-pivot indices: */
   for (k = 0; k < n; k++) {
     piv[k] = k;
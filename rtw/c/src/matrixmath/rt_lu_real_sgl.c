@@ -20,6 +20,12 @@ void rt_lu_real_sgl(real32_T      *A,    /* in and out                         *
 {
   int_T k;
 
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_LuBlas_Sgl(A, n, piv, false)) {
+    return;
+  }
+#endif
+
   /* initialize row-pivot indices: */
   for (k = 0; k < n; k++) {
     piv[k] = k;
@@ -21,6 +21,22 @@
 #  endif
 #endif
 
+#if defined(RT_MATRIXLIB_MT) && defined(CREAL_T)
+/* Solve for columns [c0, c1) of Out once the LU factors are available */
+static void MatDivCC_Dbl_SolveColumns(void *args, int_T c0, int_T c1)
+{
+  const rt_MatDivSolveArgs *a = (const rt_MatDivSolveArgs *)args;
+  int_T N = a->N;
+  creal_T *lu = (creal_T *)a->lu;
+  creal_T *x = (creal_T *)a->x;
+
+  rt_ForwardSubstitutionCC_Dbl(lu, (const creal_T *)a->In2 + c0*N, x + c0*N,
+                               N, c1-c0, a->piv, true);
+  rt_BackwardSubstitutionCC_Dbl(lu + N*N - 1, x + c1*N - 1,
+                                (creal_T *)a->Out + c0*N, N, c1-c0, false);
+}
+#endif
+
 /* Function: rt_MatDivCC_Dbl ===================================================
  * Abstract: 
  *           Calculate inv(In1)*In2 using LU factorization.
@@ -41,10 +57,33 @@ void rt_MatDivCC_Dbl(creal_T       *Out,
   const boolean_T unit_upper = false;
   const boolean_T unit_lower = true;
 
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_MatDivBlas_Dbl(Out, In1, In2, lu, piv, x, dims,
+                        RT_MATRIXLIB_BLAS_A_CPLX | RT_MATRIXLIB_BLAS_B_CPLX)) {
+    return;
+  }
+#endif
+
   (void)memcpy(lu, In1, N2*sizeof(real_T)*2);
 
   rt_lu_cplx(lu, N, piv);
 
+#ifdef RT_MATRIXLIB_MT
+  {
+    rt_MatDivSolveArgs args;
+    args.Out = Out;
+    args.In2 = In2;
+    args.lu  = lu;
+    args.piv = piv;
+    args.x   = x;
+    args.N   = N;
+    if (rt_MatrixLibParallelColumns(MatDivCC_Dbl_SolveColumns, &args, P,
+                                    (real_T)N2)) {
+      return;
+    }
+  }
+#endif
+
   rt_ForwardSubstitutionCC_Dbl(lu, In2, x, N, P, piv,unit_lower);
 
   rt_BackwardSubstitutionCC_Dbl(lu + N2 -1, x + NP -1, Out, N, P, unit_upper);
@@ -21,6 +21,22 @@
 #  endif
 #endif
 
+#ifdef RT_MATRIXLIB_MT
+/* Solve for columns [c0, c1) of Out once the LU factors are available */
+static void MatDivRR_Sgl_SolveColumns(void *args, int_T c0, int_T c1)
+{
+  const rt_MatDivSolveArgs *a = (const rt_MatDivSolveArgs *)args;
+  int_T N = a->N;
+  real32_T *lu = (real32_T *)a->lu;
+  real32_T *x = (real32_T *)a->x;
+
+  rt_ForwardSubstitutionRR_Sgl(lu, (const real32_T *)a->In2 + c0*N, x + c0*N,
+                               N, c1-c0, a->piv, true);
+  rt_BackwardSubstitutionRR_Sgl(lu + N*N - 1, x + c1*N - 1,
+                                (real32_T *)a->Out + c0*N, N, c1-c0, false);
+}
+#endif
+
 /*
  * Function: rt_MatDivRR_Sgl
  * Abstract:
@@ -41,10 +57,33 @@ void rt_MatDivRR_Sgl(real32_T       *Out,
   const boolean_T unit_upper = false;
   const boolean_T unit_lower = true;
 
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_MatDivBlas_Sgl(Out, In1, In2, lu, piv, x, dims,
+                        0)) {
+    return;
+  }
+#endif
+
   (void)memcpy(lu, In1, N2*sizeof(real32_T));
 
   rt_lu_real_sgl(lu, N, piv);
 
+#ifdef RT_MATRIXLIB_MT
+  {
+    rt_MatDivSolveArgs args;
+    args.Out = Out;
+    args.In2 = In2;
+    args.lu  = lu;
+    args.piv = piv;
+    args.x   = x;
+    args.N   = N;
+    if (rt_MatrixLibParallelColumns(MatDivRR_Sgl_SolveColumns, &args, P,
+                                    (real_T)N2)) {
+      return;
+    }
+  }
+#endif
+
   rt_ForwardSubstitutionRR_Sgl(lu, In2, x, N, P, piv, unit_lower);
 
   rt_BackwardSubstitutionRR_Sgl(lu + N2 -1, x + NP -1, Out, N, P, unit_upper);
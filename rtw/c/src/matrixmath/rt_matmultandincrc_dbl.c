@@ -11,6 +11,18 @@
 
 #include "rt_matrixlib.h"
 
+#if defined(RT_MATRIXLIB_MT) && defined(CREAL_T)
+/* Serial kernel entry used by the worker pool for a block of columns */
+static void MatMultAndIncRC_Dbl_Kernel(void       *y,
+                                       const void *A,
+                                       const void *B,
+                                       const int_T dims[3])
+{
+  rt_MatMultAndIncRC_Dbl((creal_T *)y, (const real_T *)A,
+                         (const creal_T *)B, dims);
+}
+#endif
+
 /*
  * Function: rt_MatMultAndIncRC_Dbl
  * Abstract:
@@ -25,6 +37,17 @@ void rt_MatMultAndIncRC_Dbl(creal_T       *y,
                             const int_T     dims[3])
 {
   int_T k;
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_MatMultBlas_Dbl(y, A, B, dims, RT_MATRIXLIB_BLAS_B_CPLX, true)) {
+    return;
+  }
+#endif
+#ifdef RT_MATRIXLIB_MT
+  if (rt_MatMultParallel(MatMultAndIncRC_Dbl_Kernel, y, A, B, dims,
+                         sizeof(creal_T), sizeof(creal_T))) {
+    return;
+  }
+#endif
   for(k=dims[2]; k-- > 0; ) {
     const real_T *A1 = A;
     int_T i;
@@ -11,6 +11,18 @@
 
 #include "rt_matrixlib.h"
 
+#if defined(RT_MATRIXLIB_MT) && defined(CREAL_T)
+/* Serial kernel entry used by the worker pool for a block of columns */
+static void MatMultAndIncRC_Sgl_Kernel(void       *y,
+                                       const void *A,
+                                       const void *B,
+                                       const int_T dims[3])
+{
+  rt_MatMultAndIncRC_Sgl((creal32_T *)y, (const real32_T *)A,
+                         (const creal32_T *)B, dims);
+}
+#endif
+
 /*
  * Function: rt_MatMultAndIncRC_Sgl
  * Abstract:
@@ -25,6 +37,17 @@ void rt_MatMultAndIncRC_Sgl(creal32_T       *y,
                             const int_T       dims[3])
 {
   int_T k;
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_MatMultBlas_Sgl(y, A, B, dims, RT_MATRIXLIB_BLAS_B_CPLX, true)) {
+    return;
+  }
+#endif
+#ifdef RT_MATRIXLIB_MT
+  if (rt_MatMultParallel(MatMultAndIncRC_Sgl_Kernel, y, A, B, dims,
+                         sizeof(creal32_T), sizeof(creal32_T))) {
+    return;
+  }
+#endif
   for(k=dims[2]; k-- > 0; ) {
     const real32_T *A1 = A;
     int_T i;
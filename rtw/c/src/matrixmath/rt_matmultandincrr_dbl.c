@@ -10,6 +10,18 @@
 
 #include "rt_matrixlib.h"
 
+#ifdef RT_MATRIXLIB_MT
+/* Serial kernel entry used by the worker pool for a block of columns */
+static void MatMultAndIncRR_Dbl_Kernel(void       *y,
+                                       const void *A,
+                                       const void *B,
+                                       const int_T dims[3])
+{
+  rt_MatMultAndIncRR_Dbl((real_T *)y, (const real_T *)A,
+                         (const real_T *)B, dims);
+}
+#endif
+
 /*
  * Function: rt_MatMultAndIncRR_Dbl
  * Abstract:
@@ -23,6 +35,17 @@ void rt_MatMultAndIncRR_Dbl(real_T       *y,
                             const int_T    dims[3])
 {
   int_T k;
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_MatMultBlas_Dbl(y, A, B, dims, 0, true)) {
+    return;
+  }
+#endif
+#ifdef RT_MATRIXLIB_MT
+  if (rt_MatMultParallel(MatMultAndIncRR_Dbl_Kernel, y, A, B, dims,
+                         sizeof(real_T), sizeof(real_T))) {
+    return;
+  }
+#endif
   for(k=dims[2]; k-- > 0; ) {
     const real_T *A1 = A;
     int_T i;
@@ -10,6 +10,18 @@
 
 #include "rt_matrixlib.h"
 
+#ifdef RT_MATRIXLIB_MT
+/* Serial kernel entry used by the worker pool for a block of columns */
+static void MatMultRR_Sgl_Kernel(void       *y,
+                                 const void *A,
+                                 const void *B,
+                                 const int_T dims[3])
+{
+  rt_MatMultRR_Sgl((real32_T *)y, (const real32_T *)A,
+                   (const real32_T *)B, dims);
+}
+#endif
+
 /*
  * Function: rt_MatMultRR_Sgl
  * Abstract:
@@ -23,6 +35,17 @@ void rt_MatMultRR_Sgl(real32_T       *y,
                       const int_T     dims[3])
 {
   int_T k;
+#ifdef RT_MATRIXLIB_USE_BLAS
+  if (rt_MatMultBlas_Sgl(y, A, B, dims, 0, false)) {
+    return;
+  }
+#endif
+#ifdef RT_MATRIXLIB_MT
+  if (rt_MatMultParallel(MatMultRR_Sgl_Kernel, y, A, B, dims,
+                         sizeof(real32_T), sizeof(real32_T))) {
+    return;
+  }
+#endif
   for(k=dims[2]; k-- > 0; ) {
     const real32_T *A1 = A;
     int_T i;
@@ -16,6 +16,7 @@
 
 #include "rtwtypes.h"
 #include <limits.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -353,6 +354,138 @@ extern real_T rt_Hypot_Dbl(real_T In1,
 extern real32_T rt_Hypot_Sgl(real32_T In1,
                              real32_T In2);
 
+/* Multithreaded large-matrix support (rt_matrixlib_mt.c)
+ *
+ * Compiled in only when RT_MATRIXLIB_MT is defined. The library attaches to
+ * the worker pool shared with the other runtime libraries (rt_workerpool.h)
+ * in rt_MatrixLibThreadPoolInit at model initialization and detaches in
+ * rt_MatrixLibThreadPoolTerminate; while detached all routines run
+ * serially on the calling thread.
+ */
+#ifdef RT_MATRIXLIB_MT
+
+/* Minimum number of multiply-adds before a call is split across threads */
+#ifndef RT_MATRIXLIB_MT_MIN_WORK
+#define RT_MATRIXLIB_MT_MIN_WORK        (262144.0)
+#endif
+
+/* Upper bound on the threads a call is split across (including the calling
+ * thread); the shared pool itself holds at most RT_WORKERPOOL_MAX_THREADS */
+#ifndef RT_MATRIXLIB_MT_MAX_THREADS
+#define RT_MATRIXLIB_MT_MAX_THREADS     (64)
+#endif
+
+/* Environment variable read when no thread count is supplied */
+#define RT_MATRIXLIB_NUM_THREADS_ENV    "RT_MATRIXLIB_NUM_THREADS"
+
+/* Processes output columns [colStart, colEnd) */
+typedef void (*rt_MatrixLibColumnFcn)(void *args,
+                                      int_T colStart,
+                                      int_T colEnd);
+
+/* Serial y = A*B (or y += A*B) kernel with type-erased operands */
+typedef void (*rt_MatMultKernelFcn)(void       *y,
+                                    const void *A,
+                                    const void *B,
+                                    const int_T dims[3]);
+
+/* Arguments shared by the column-parallel forward/backward substitution
+ * stage of the rt_MatDiv* routines */
+typedef struct rt_MatDivSolveArgs_tag {
+    void          *Out;
+    const void    *In2;
+    void          *lu;
+    const int32_T *piv;
+    void          *x;
+    int_T          N;
+} rt_MatDivSolveArgs;
+
+extern int_T rt_MatrixLibThreadPoolInit(int_T numThreads);
+
+extern void rt_MatrixLibThreadPoolTerminate(void);
+
+extern int_T rt_MatrixLibGetNumThreads(void);
+
+extern boolean_T rt_MatrixLibParallelColumns(rt_MatrixLibColumnFcn fcn,
+                                             void                 *args,
+                                             int_T                 numCols,
+                                             real_T                workPerCol);
+
+extern boolean_T rt_MatMultParallel(rt_MatMultKernelFcn kernel,
+                                    void               *y,
+                                    const void         *A,
+                                    const void         *B,
+                                    const int_T         dims[3],
+                                    size_t              yElemSize,
+                                    size_t              bElemSize);
+
+#endif /* RT_MATRIXLIB_MT */
+
+/* BLAS/LAPACK dispatch (rt_matrixlib_blas_dbl.c, rt_matrixlib_blas_sgl.c)
+ *
+ * Compiled in only when RT_MATRIXLIB_USE_BLAS is defined; the executable
+ * must then link a BLAS/LAPACK library using the Fortran calling
+ * convention and ptrdiff_t integers declared in extern/include/blas.h.
+ * Each routine returns false when the operands are below the dispatch
+ * threshold (or a work buffer cannot be allocated), in which case the
+ * caller runs its own kernel.
+ */
+#ifdef RT_MATRIXLIB_USE_BLAS
+
+/* Matrix multiplies are dispatched when M*N*P >= RT_MATRIXLIB_BLAS_MIN_DIM^3,
+ * LU factorizations and matrix divides when N >= RT_MATRIXLIB_BLAS_MIN_DIM */
+#ifndef RT_MATRIXLIB_BLAS_MIN_DIM
+#define RT_MATRIXLIB_BLAS_MIN_DIM       (32)
+#endif
+
+/* Operand complexity flags */
+#define RT_MATRIXLIB_BLAS_A_CPLX        (1)
+#define RT_MATRIXLIB_BLAS_B_CPLX        (2)
+
+extern boolean_T rt_MatMultBlas_Dbl(void        *y,
+                                    const void  *A,
+                                    const void  *B,
+                                    const int_T  dims[3],
+                                    int_T        cplx,
+                                    boolean_T    accumulate);
+
+extern boolean_T rt_MatMultBlas_Sgl(void        *y,
+                                    const void  *A,
+                                    const void  *B,
+                                    const int_T  dims[3],
+                                    int_T        cplx,
+                                    boolean_T    accumulate);
+
+extern boolean_T rt_LuBlas_Dbl(void      *A,
+                               int_T      n,
+                               int32_T   *piv,
+                               boolean_T  cplx);
+
+extern boolean_T rt_LuBlas_Sgl(void      *A,
+                               int_T      n,
+                               int32_T   *piv,
+                               boolean_T  cplx);
+
+extern boolean_T rt_MatDivBlas_Dbl(void        *Out,
+                                   const void  *In1,
+                                   const void  *In2,
+                                   void        *lu,
+                                   int32_T     *piv,
+                                   void        *x,
+                                   const int_T  dims[3],
+                                   int_T        cplx);
+
+extern boolean_T rt_MatDivBlas_Sgl(void        *Out,
+                                   const void  *In1,
+                                   const void  *In2,
+                                   void        *lu,
+                                   int32_T     *piv,
+                                   void        *x,
+                                   const int_T  dims[3],
+                                   int_T        cplx);
+
+#endif /* RT_MATRIXLIB_USE_BLAS */
+
 #ifdef __cplusplus
 }
 #endif
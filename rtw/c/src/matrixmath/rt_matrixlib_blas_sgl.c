@@ -0,0 +1,265 @@
+/* Copyright 2019 The MathWorks, Inc.
+ *
+ * File: rt_matrixlib_blas_sgl.c
+ *
+ * Abstract:
+ *      Dispatch of single precision matrix multiply, LU factorization and
+ *      matrix division to an external BLAS/LAPACK library
+ *      (sgemm/cgemm, sgetrf/cgetrf, sgetrs/cgetrs).
+ *
+ *      Only compiled when RT_MATRIXLIB_USE_BLAS is defined. Complex data
+ *      uses the interleaved creal32_T layout, which matches the Fortran
+ *      COMPLEX layout expected by the c* routines.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "rt_matrixlib.h"
+
+#ifdef RT_MATRIXLIB_USE_BLAS
+
+#include "blas.h"
+
+/* LAPACK prototypes (same calling convention as blas.h) */
+#define sgetrf FORTRAN_WRAPPER(sgetrf)
+extern void sgetrf(const ptrdiff_t *m, const ptrdiff_t *n, float *a,
+                   const ptrdiff_t *lda, ptrdiff_t *ipiv, ptrdiff_t *info);
+
+#define cgetrf FORTRAN_WRAPPER(cgetrf)
+extern void cgetrf(const ptrdiff_t *m, const ptrdiff_t *n, float *a,
+                   const ptrdiff_t *lda, ptrdiff_t *ipiv, ptrdiff_t *info);
+
+#define sgetrs FORTRAN_WRAPPER(sgetrs)
+extern void sgetrs(const char *trans, const ptrdiff_t *n,
+                   const ptrdiff_t *nrhs, const float *a,
+                   const ptrdiff_t *lda, const ptrdiff_t *ipiv, float *b,
+                   const ptrdiff_t *ldb, ptrdiff_t *info);
+
+#define cgetrs FORTRAN_WRAPPER(cgetrs)
+extern void cgetrs(const char *trans, const ptrdiff_t *n,
+                   const ptrdiff_t *nrhs, const float *a,
+                   const ptrdiff_t *lda, const ptrdiff_t *ipiv, float *b,
+                   const ptrdiff_t *ldb, ptrdiff_t *info);
+
+/* Function: BlasPivToPerm_Sgl =================================================
+ * Abstract:
+ *      Convert the LAPACK row interchange sequence (1-based) into the
+ *      0-based row permutation vector produced by rt_lu_real_sgl and
+ *      rt_lu_cplx_sgl.
+ */
+static void BlasPivToPerm_Sgl(const ptrdiff_t *ipiv, int_T n, int32_T *piv)
+{
+    int_T k;
+    for (k = 0; k < n; k++) {
+        piv[k] = k;
+    }
+    for (k = 0; k < n; k++) {
+        int_T p = (int_T)ipiv[k] - 1;
+        if (p != k) {
+            int32_T t = piv[p]; piv[p] = piv[k]; piv[k] = t;
+        }
+    }
+}
+
+/* Function: rt_MatMultBlas_Sgl ================================================
+ * Abstract:
+ *      y = A*B (or y += A*B when accumulate is true), dims = [M N P].
+ *      A complex A is viewed as a real 2M x N matrix so that a complex-by-
+ *      real product is a single sgemm; a real-by-complex product promotes
+ *      A to complex and calls cgemm.
+ */
+boolean_T rt_MatMultBlas_Sgl(void        *y,
+                             const void  *A,
+                             const void  *B,
+                             const int_T  dims[3],
+                             int_T        cplx,
+                             boolean_T    accumulate)
+{
+    const char   noTrans = 'N';
+    ptrdiff_t    m = (ptrdiff_t)dims[0];
+    ptrdiff_t    k = (ptrdiff_t)dims[1];
+    ptrdiff_t    n = (ptrdiff_t)dims[2];
+    const real32_T alpha[2] = {1.0F, 0.0F};
+    real32_T       beta[2];
+    const real_T   minWork = (real_T)RT_MATRIXLIB_BLAS_MIN_DIM *
+        (real_T)RT_MATRIXLIB_BLAS_MIN_DIM * (real_T)RT_MATRIXLIB_BLAS_MIN_DIM;
+
+    if ((real_T)m * (real_T)k * (real_T)n < minWork) {
+        return false;
+    }
+
+    beta[0] = accumulate ? 1.0F : 0.0F;
+    beta[1] = 0.0F;
+
+    switch (cplx) {
+      case 0:
+        sgemm(&noTrans, &noTrans, &m, &n, &k, alpha,
+              (const float *)A, &m, (const float *)B, &k,
+              beta, (float *)y, &m);
+        break;
+
+      case RT_MATRIXLIB_BLAS_A_CPLX:
+        {
+            ptrdiff_t m2 = 2*m;
+            sgemm(&noTrans, &noTrans, &m2, &n, &k, alpha,
+                  (const float *)A, &m2, (const float *)B, &k,
+                  beta, (float *)y, &m2);
+        }
+        break;
+
+      case RT_MATRIXLIB_BLAS_B_CPLX:
+        {
+            const real32_T *Ar = (const real32_T *)A;
+            real32_T       *Ac = (real32_T *)
+                malloc((size_t)(2*m*k)*sizeof(real32_T));
+            ptrdiff_t       i;
+            if (Ac == NULL) return false;
+            for (i = 0; i < m*k; i++) {
+                Ac[2*i]   = Ar[i];
+                Ac[2*i+1] = 0.0F;
+            }
+            cgemm(&noTrans, &noTrans, &m, &n, &k, alpha,
+                  Ac, &m, (const float *)B, &k,
+                  beta, (float *)y, &m);
+            free(Ac);
+        }
+        break;
+
+      default:
+        cgemm(&noTrans, &noTrans, &m, &n, &k, alpha,
+              (const float *)A, &m, (const float *)B, &k,
+              beta, (float *)y, &m);
+        break;
+    }
+
+    return true;
+}
+
+/* Function: rt_LuBlas_Sgl =====================================================
+ * Abstract:
+ *      In-place LU factorization of the n x n matrix A with the same
+ *      output format as rt_lu_real_sgl and
+ *      rt_lu_cplx_sgl.
+ */
+boolean_T rt_LuBlas_Sgl(void      *A,
+                        int_T      n,
+                        int32_T   *piv,
+                        boolean_T  cplx)
+{
+    ptrdiff_t  N = (ptrdiff_t)n;
+    ptrdiff_t  info = 0;
+    ptrdiff_t *ipiv;
+
+    if (n < RT_MATRIXLIB_BLAS_MIN_DIM) {
+        return false;
+    }
+    ipiv = (ptrdiff_t *)malloc((size_t)n*sizeof(ptrdiff_t));
+    if (ipiv == NULL) return false;
+
+    if (cplx) {
+        cgetrf(&N, &N, (float *)A, &N, ipiv, &info);
+    } else {
+        sgetrf(&N, &N, (float *)A, &N, ipiv, &info);
+    }
+    BlasPivToPerm_Sgl(ipiv, n, piv);
+
+    free(ipiv);
+    return true;
+}
+
+/* Function: rt_MatDivBlas_Sgl =================================================
+ * Abstract:
+ *      Out = inv(In1)*In2 (dims = [N N P]) using xGETRF/xGETRS. lu and piv
+ *      receive the factorization as in the serial path; x is used as
+ *      scratch for a real In1 with complex In2, whose real and imaginary
+ *      parts are solved together as 2P right-hand sides.
+ */
+boolean_T rt_MatDivBlas_Sgl(void        *Out,
+                            const void  *In1,
+                            const void  *In2,
+                            void        *lu,
+                            int32_T     *piv,
+                            void        *x,
+                            const int_T  dims[3],
+                            int_T        cplx)
+{
+    const char  noTrans = 'N';
+    int_T       N  = dims[0];
+    int_T       P  = dims[2];
+    ptrdiff_t   n  = (ptrdiff_t)N;
+    ptrdiff_t   NP = (ptrdiff_t)N * P;
+    ptrdiff_t   nrhs = (ptrdiff_t)P;
+    ptrdiff_t   info = 0;
+    ptrdiff_t  *ipiv;
+    ptrdiff_t   j;
+
+    if (N < RT_MATRIXLIB_BLAS_MIN_DIM || P < 1) {
+        return false;
+    }
+    ipiv = (ptrdiff_t *)malloc((size_t)N*sizeof(ptrdiff_t));
+    if (ipiv == NULL) return false;
+
+    switch (cplx) {
+      case 0:
+        (void)memcpy(lu, In1, (size_t)(n*n)*sizeof(real32_T));
+        (void)memcpy(Out, In2, (size_t)NP*sizeof(real32_T));
+        sgetrf(&n, &n, (float *)lu, &n, ipiv, &info);
+        sgetrs(&noTrans, &n, &nrhs, (const float *)lu, &n, ipiv,
+               (float *)Out, &n, &info);
+        break;
+
+      case RT_MATRIXLIB_BLAS_B_CPLX:
+        {
+            const real32_T *b  = (const real32_T *)In2;
+            real32_T       *xr = (real32_T *)x;
+            real32_T       *y  = (real32_T *)Out;
+            ptrdiff_t     nrhs2 = 2*nrhs;
+
+            (void)memcpy(lu, In1, (size_t)(n*n)*sizeof(real32_T));
+            for (j = 0; j < NP; j++) {
+                xr[j]    = b[2*j];
+                xr[NP+j] = b[2*j+1];
+            }
+            sgetrf(&n, &n, (float *)lu, &n, ipiv, &info);
+            sgetrs(&noTrans, &n, &nrhs2, (const float *)lu, &n, ipiv,
+                   xr, &n, &info);
+            for (j = 0; j < NP; j++) {
+                y[2*j]   = xr[j];
+                y[2*j+1] = xr[NP+j];
+            }
+        }
+        break;
+
+      case RT_MATRIXLIB_BLAS_A_CPLX:
+        {
+            const real32_T *b = (const real32_T *)In2;
+            real32_T       *y = (real32_T *)Out;
+
+            (void)memcpy(lu, In1, (size_t)(n*n)*2*sizeof(real32_T));
+            for (j = 0; j < NP; j++) {
+                y[2*j]   = b[j];
+                y[2*j+1] = 0.0F;
+            }
+            cgetrf(&n, &n, (float *)lu, &n, ipiv, &info);
+            cgetrs(&noTrans, &n, &nrhs, (const float *)lu, &n, ipiv,
+                   (float *)Out, &n, &info);
+        }
+        break;
+
+      default:
+        (void)memcpy(lu, In1, (size_t)(n*n)*2*sizeof(real32_T));
+        (void)memcpy(Out, In2, (size_t)NP*2*sizeof(real32_T));
+        cgetrf(&n, &n, (float *)lu, &n, ipiv, &info);
+        cgetrs(&noTrans, &n, &nrhs, (const float *)lu, &n, ipiv,
+               (float *)Out, &n, &info);
+        break;
+    }
+    BlasPivToPerm_Sgl(ipiv, N, piv);
+
+    free(ipiv);
+    return true;
+}
+
+#endif /* RT_MATRIXLIB_USE_BLAS */
+
+/* [EOF] rt_matrixlib_blas_sgl.c */
@@ -0,0 +1,190 @@
+/* Copyright 2019 The MathWorks, Inc.
+ *
+ * File: rt_matrixlib_mt.c
+ *
+ * Abstract:
+ *      Splits large rt_MatMult* and rt_MatDiv* calls across the threads of
+ *      the worker pool shared with the other runtime libraries
+ *      (rt_workerpool.c).
+ *
+ *      The library attaches to the pool once (rt_MatrixLibThreadPoolInit)
+ *      at model initialization. A call is only split when the library is
+ *      attached, the amount of work exceeds RT_MATRIXLIB_MT_MIN_WORK and
+ *      the pool is not running another split call; otherwise the caller
+ *      falls back to the serial kernel. Nested calls made from a worker
+ *      therefore always run serially.
+ *
+ *      Only compiled when RT_MATRIXLIB_MT is defined (POSIX threads).
+ */
+
+#include "rt_matrixlib.h"
+
+#ifdef RT_MATRIXLIB_MT
+
+#include <stdlib.h>
+#include "rt_workerpool.h"
+
+/* Number of threads the library splits a call across, including the
+ * caller; 1 while the library is not attached to the pool */
+static int_T gMatrixLibNumThreads = 1;
+
+typedef struct MatrixLibJob_tag {
+    rt_MatrixLibColumnFcn fcn;
+    void                 *args;
+    int_T                 numCols;
+} MatrixLibJob;
+
+/* Function: MatrixLibRunChunk =================================================
+ * Abstract:
+ *      Process the columns belonging to one chunk of a split call.
+ */
+static void MatrixLibRunChunk(void *arg, int_T chunkIdx, int_T numChunks)
+{
+    const MatrixLibJob *job = (const MatrixLibJob *)arg;
+    int_T colStart = (int_T)(((long)chunkIdx * job->numCols) / numChunks);
+    int_T colEnd   = (int_T)(((long)(chunkIdx+1) * job->numCols) / numChunks);
+    if (colEnd > colStart) {
+        job->fcn(job->args, colStart, colEnd);
+    }
+}
+
+/* Function: rt_MatrixLibThreadPoolInit ========================================
+ * Abstract:
+ *      Attach the library to the shared worker pool. numThreads is the
+ *      total number of threads taking part in a split call, including the
+ *      caller. When numThreads <= 0 the count is read from the
+ *      RT_MATRIXLIB_NUM_THREADS environment variable. A count of 1 (or an
+ *      unset variable) leaves the library serial. Returns the number of
+ *      threads in use, which is also bounded by the size of the pool if
+ *      another library created it first.
+ */
+int_T rt_MatrixLibThreadPoolInit(int_T numThreads)
+{
+    int_T poolThreads;
+
+    if (gMatrixLibNumThreads > 1) {
+        return gMatrixLibNumThreads;  /* already initialized */
+    }
+
+    if (numThreads <= 0) {
+        const char *env = getenv(RT_MATRIXLIB_NUM_THREADS_ENV);
+        numThreads = (env != NULL) ? (int_T)atoi(env) : 1;
+    }
+    if (numThreads > RT_MATRIXLIB_MT_MAX_THREADS) {
+        numThreads = RT_MATRIXLIB_MT_MAX_THREADS;
+    }
+    if (numThreads <= 1) {
+        return 1;
+    }
+
+    poolThreads = rt_WorkerPoolInit(numThreads);
+    if (poolThreads <= 1) {
+        rt_WorkerPoolTerminate();
+        return 1;
+    }
+    gMatrixLibNumThreads = (numThreads < poolThreads) ? numThreads : poolThreads;
+
+    return gMatrixLibNumThreads;
+}
+
+/* Function: rt_MatrixLibThreadPoolTerminate ===================================
+ * Abstract:
+ *      Detach the library from the shared worker pool. Subsequent calls run
+ *      serially.
+ */
+void rt_MatrixLibThreadPoolTerminate(void)
+{
+    if (gMatrixLibNumThreads <= 1) return;
+
+    gMatrixLibNumThreads = 1;
+    rt_WorkerPoolTerminate();
+}
+
+int_T rt_MatrixLibGetNumThreads(void)
+{
+    return gMatrixLibNumThreads;
+}
+
+/* Function: rt_MatrixLibParallelColumns =======================================
+ * Abstract:
+ *      Split numCols independent columns across the pool and wait for all
+ *      of them. Returns false, without calling fcn, when the call should
+ *      run serially instead.
+ */
+boolean_T rt_MatrixLibParallelColumns(rt_MatrixLibColumnFcn fcn,
+                                      void                 *args,
+                                      int_T                 numCols,
+                                      real_T                workPerCol)
+{
+    MatrixLibJob job;
+
+    if (gMatrixLibNumThreads <= 1 || numCols < 2 ||
+        (real_T)numCols * workPerCol < RT_MATRIXLIB_MT_MIN_WORK) {
+        return false;
+    }
+
+    job.fcn     = fcn;
+    job.args    = args;
+    job.numCols = numCols;
+
+    return rt_WorkerPoolRun(MatrixLibRunChunk, &job,
+                            (numCols < gMatrixLibNumThreads) ?
+                            numCols : gMatrixLibNumThreads);
+}
+
+typedef struct MatMultArgs_tag {
+    rt_MatMultKernelFcn kernel;
+    char               *y;
+    const void         *A;
+    const char         *B;
+    const int_T        *dims;
+    size_t              yColBytes;
+    size_t              bColBytes;
+} MatMultArgs;
+
+static void MatMultColumns(void *args, int_T colStart, int_T colEnd)
+{
+    const MatMultArgs *mm = (const MatMultArgs *)args;
+    int_T sliceDims[3];
+
+    sliceDims[0] = mm->dims[0];
+    sliceDims[1] = mm->dims[1];
+    sliceDims[2] = colEnd - colStart;
+
+    mm->kernel(mm->y + (size_t)colStart * mm->yColBytes,
+               mm->A,
+               mm->B + (size_t)colStart * mm->bColBytes,
+               sliceDims);
+}
+
+/* Function: rt_MatMultParallel ================================================
+ * Abstract:
+ *      Compute y = A*B (dims = [M N P]) by handing contiguous blocks of
+ *      columns of B and y to the serial kernel on each thread. Returns
+ *      false if the product was not computed.
+ */
+boolean_T rt_MatMultParallel(rt_MatMultKernelFcn kernel,
+                             void               *y,
+                             const void         *A,
+                             const void         *B,
+                             const int_T         dims[3],
+                             size_t              yElemSize,
+                             size_t              bElemSize)
+{
+    MatMultArgs args;
+
+    args.kernel    = kernel;
+    args.y         = (char *)y;
+    args.A         = A;
+    args.B         = (const char *)B;
+    args.dims      = dims;
+    args.yColBytes = (size_t)dims[0] * yElemSize;
+    args.bColBytes = (size_t)dims[1] * bElemSize;
+
+    return rt_MatrixLibParallelColumns(MatMultColumns, &args, dims[2],
+                                       (real_T)dims[0] * (real_T)dims[1]);
+}
+
+#endif /* RT_MATRIXLIB_MT */
+
+/* [EOF] rt_matrixlib_mt.c */
@@ -0,0 +1,559 @@
+/* Copyright 2019 The MathWorks, Inc.
+ *
+ * File: tMatrixLibBench.c
+ *
+ * Abstract:
+ *      Benchmark and accuracy check of the matrixmath kernels: rt_MatMult*,
+ *      rt_MatMultAndInc* and rt_MatDiv* in all RR/RC/CR/CC variants, and
+ *      rt_lu_*, in single and double precision. The forward and backward
+ *      substitution routines are exercised through rt_MatDiv*.
+ *
+ *      For square operands of size 2 up to the maximum dimension (default
+ *      1024) each kernel is timed and reported in GFLOP/s, using nominal
+ *      flop counts (2, 4 or 8 flops per real-real, real-complex or
+ *      complex-complex multiply-add, 2/3*N^3 multiply-adds per LU). The
+ *      result is checked on a few sampled columns against a long double
+ *      reference, as a residual scaled by N*eps times the magnitude of the
+ *      terms involved; a kernel fails when its scaled residual exceeds
+ *      T_TOL_SCALED.
+ *
+ *      Build and run from the matrixmath directory with an rtwtypes.h on
+ *      the include path, e.g.:
+ *        cc -O2 -I. -I.. -I<matlabroot>/extern/include
+ *           -I<matlabroot>/simulink/include test/tMatrixLibBench.c rt_*.c
+ *           ../rt_workerpool.c -lm && ./a.out [maxDim [numThreads]]
+ *      Add -DRT_MATRIXLIB_MT -lpthread to measure the multithreaded
+ *      kernels, or -DRT_MATRIXLIB_USE_BLAS and a BLAS/LAPACK library to
+ *      measure the BLAS dispatch. Returns 0 if all kernels pass.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+
+#include "rt_matrixlib.h"
+
+#define T_MAX_DIM          (1024)
+#define T_MIN_TIME         (0.2)   /* seconds timed per kernel and size */
+#define T_NUM_CHECK_COLS   (4)     /* columns checked against the reference */
+#define T_TOL_SCALED       (4.0)
+
+static const int_T tDims[] = {2, 3, 4, 7, 8, 16, 31, 32, 64, 100, 128, 256,
+                              512, 1024};
+
+/*==================*
+ * Operand handling *
+ *==================*/
+
+/* Element type of an operand */
+typedef struct tType_tag {
+    boolean_T isSingle;
+    boolean_T isCplx;
+} tType;
+
+static size_t tElemSize(tType t)
+{
+    return (t.isSingle ? sizeof(real32_T) : sizeof(real_T)) * (t.isCplx ? 2 : 1);
+}
+
+static void tGet(const void *p, tType t, size_t idx, long double *re, long double *im)
+{
+    if (t.isSingle) {
+        const real32_T *v = (const real32_T *)p + (t.isCplx ? 2*idx : idx);
+        *re = v[0];
+        *im = t.isCplx ? v[1] : 0.0f;
+    } else {
+        const real_T *v = (const real_T *)p + (t.isCplx ? 2*idx : idx);
+        *re = v[0];
+        *im = t.isCplx ? v[1] : 0.0;
+    }
+}
+
+static void tSet(void *p, tType t, size_t idx, double re, double im)
+{
+    if (t.isSingle) {
+        real32_T *v = (real32_T *)p + (t.isCplx ? 2*idx : idx);
+        v[0] = (real32_T)re;
+        if (t.isCplx) v[1] = (real32_T)im;
+    } else {
+        real_T *v = (real_T *)p + (t.isCplx ? 2*idx : idx);
+        v[0] = re;
+        if (t.isCplx) v[1] = im;
+    }
+}
+
+/* Deterministic uniform numbers in [-1, 1] */
+static unsigned long tSeed = 12345UL;
+static double tRand(void)
+{
+    tSeed = (1103515245UL*tSeed + 12345UL) & 0x7fffffffUL;
+    return 2.0*(double)tSeed/(double)0x7fffffffUL - 1.0;
+}
+
+static void *tAlloc(tType t, size_t numel)
+{
+    void *p = malloc(numel*tElemSize(t) + 1);
+    if (p == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+    return p;
+}
+
+/* Random matrix; diagDom adds diagDom to the diagonal of a square matrix */
+static void *tRandMatrix(tType t, int_T M, int_T N, double diagDom)
+{
+    void  *p = tAlloc(t, (size_t)M*N);
+    int_T i, j;
+    for (j = 0; j < N; j++) {
+        for (i = 0; i < M; i++) {
+            double re = tRand();
+            double im = t.isCplx ? tRand() : 0.0;
+            if (i == j) re += diagDom;
+            tSet(p, t, (size_t)j*M + i, re, im);
+        }
+    }
+    return p;
+}
+
+static double tEps(boolean_T isSingle)
+{
+    return isSingle ? (double)FLT_EPSILON : DBL_EPSILON;
+}
+
+static double tNow(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
+}
+
+/* Column j of the columns checked against the reference */
+static int_T tCheckCol(int_T c, int_T P)
+{
+    return (P <= T_NUM_CHECK_COLS) ? c : (int_T)(((long)c*(P-1))/(T_NUM_CHECK_COLS-1));
+}
+
+static int_T tNumCheckCols(int_T P)
+{
+    return (P < T_NUM_CHECK_COLS) ? P : T_NUM_CHECK_COLS;
+}
+
+/* Add x*y to (re, im) and |x|*|y| to absSum, with |z| = |re(z)| + |im(z)| */
+static void tMulAdd(long double xr, long double xi, long double yr, long double yi,
+                    long double *re, long double *im, long double *absSum)
+{
+    *re += xr*yr - xi*yi;
+    *im += xr*yi + xi*yr;
+    *absSum += (fabsl(xr) + fabsl(xi))*(fabsl(yr) + fabsl(yi));
+}
+
+/*=======================*
+ * Kernels under measure *
+ *=======================*/
+
+typedef void (*tMatMultFcn)(void *y, const void *A, const void *B, const int_T dims[3]);
+typedef void (*tMatDivFcn)(void *Out, const void *In1, const void *In2, void *lu,
+                           int32_T *piv, void *x, const int_T dims[3]);
+typedef void (*tLuFcn)(void *A, int_T n, int32_T *piv);
+
+#define T_MATMULT_WRAP(fcn, TY, TA, TB)                                     \
+    static void t_##fcn(void *y, const void *A, const void *B,              \
+                        const int_T dims[3])                                \
+    {                                                                       \
+        fcn((TY *)y, (const TA *)A, (const TB *)B, dims);                   \
+    }
+
+#define T_MATDIV_WRAP(fcn, TY, TA, TB, TLU)                                 \
+    static void t_##fcn(void *Out, const void *In1, const void *In2,        \
+                        void *lu, int32_T *piv, void *x,                    \
+                        const int_T dims[3])                                \
+    {                                                                       \
+        fcn((TY *)Out, (const TA *)In1, (const TB *)In2, (TLU *)lu, piv,    \
+            (TY *)x, dims);                                                 \
+    }
+
+#define T_LU_WRAP(fcn, TA)                                                  \
+    static void t_##fcn(void *A, int_T n, int32_T *piv)                     \
+    {                                                                       \
+        fcn((TA *)A, n, piv);                                               \
+    }
+
+T_MATMULT_WRAP(rt_MatMultRR_Dbl, real_T,    real_T,    real_T)
+T_MATMULT_WRAP(rt_MatMultRC_Dbl, creal_T,   real_T,    creal_T)
+T_MATMULT_WRAP(rt_MatMultCR_Dbl, creal_T,   creal_T,   real_T)
+T_MATMULT_WRAP(rt_MatMultCC_Dbl, creal_T,   creal_T,   creal_T)
+T_MATMULT_WRAP(rt_MatMultRR_Sgl, real32_T,  real32_T,  real32_T)
+T_MATMULT_WRAP(rt_MatMultRC_Sgl, creal32_T, real32_T,  creal32_T)
+T_MATMULT_WRAP(rt_MatMultCR_Sgl, creal32_T, creal32_T, real32_T)
+T_MATMULT_WRAP(rt_MatMultCC_Sgl, creal32_T, creal32_T, creal32_T)
+
+T_MATMULT_WRAP(rt_MatMultAndIncRR_Dbl, real_T,    real_T,    real_T)
+T_MATMULT_WRAP(rt_MatMultAndIncRC_Dbl, creal_T,   real_T,    creal_T)
+T_MATMULT_WRAP(rt_MatMultAndIncCR_Dbl, creal_T,   creal_T,   real_T)
+T_MATMULT_WRAP(rt_MatMultAndIncCC_Dbl, creal_T,   creal_T,   creal_T)
+T_MATMULT_WRAP(rt_MatMultAndIncRR_Sgl, real32_T,  real32_T,  real32_T)
+T_MATMULT_WRAP(rt_MatMultAndIncRC_Sgl, creal32_T, real32_T,  creal32_T)
+T_MATMULT_WRAP(rt_MatMultAndIncCR_Sgl, creal32_T, creal32_T, real32_T)
+T_MATMULT_WRAP(rt_MatMultAndIncCC_Sgl, creal32_T, creal32_T, creal32_T)
+
+T_MATDIV_WRAP(rt_MatDivRR_Dbl, real_T,    real_T,    real_T,    real_T)
+T_MATDIV_WRAP(rt_MatDivRC_Dbl, creal_T,   real_T,    creal_T,   real_T)
+T_MATDIV_WRAP(rt_MatDivCR_Dbl, creal_T,   creal_T,   real_T,    creal_T)
+T_MATDIV_WRAP(rt_MatDivCC_Dbl, creal_T,   creal_T,   creal_T,   creal_T)
+T_MATDIV_WRAP(rt_MatDivRR_Sgl, real32_T,  real32_T,  real32_T,  real32_T)
+T_MATDIV_WRAP(rt_MatDivRC_Sgl, creal32_T, real32_T,  creal32_T, real32_T)
+T_MATDIV_WRAP(rt_MatDivCR_Sgl, creal32_T, creal32_T, real32_T,  creal32_T)
+T_MATDIV_WRAP(rt_MatDivCC_Sgl, creal32_T, creal32_T, creal32_T, creal32_T)
+
+T_LU_WRAP(rt_lu_real,     real_T)
+T_LU_WRAP(rt_lu_cplx,     creal_T)
+T_LU_WRAP(rt_lu_real_sgl, real32_T)
+T_LU_WRAP(rt_lu_cplx_sgl, creal32_T)
+
+/* One RR/RC/CR/CC variant in one precision */
+typedef struct tVariant_tag {
+    const char  *name;
+    boolean_T   isSingle;
+    boolean_T   aCplx;
+    boolean_T   bCplx;
+    tMatMultFcn mult;
+    tMatMultFcn multInc;
+    tMatDivFcn  div;
+} tVariant;
+
+static const tVariant tVariants[] = {
+    {"RR_Dbl", false, false, false, t_rt_MatMultRR_Dbl, t_rt_MatMultAndIncRR_Dbl, t_rt_MatDivRR_Dbl},
+    {"RC_Dbl", false, false, true,  t_rt_MatMultRC_Dbl, t_rt_MatMultAndIncRC_Dbl, t_rt_MatDivRC_Dbl},
+    {"CR_Dbl", false, true,  false, t_rt_MatMultCR_Dbl, t_rt_MatMultAndIncCR_Dbl, t_rt_MatDivCR_Dbl},
+    {"CC_Dbl", false, true,  true,  t_rt_MatMultCC_Dbl, t_rt_MatMultAndIncCC_Dbl, t_rt_MatDivCC_Dbl},
+    {"RR_Sgl", true,  false, false, t_rt_MatMultRR_Sgl, t_rt_MatMultAndIncRR_Sgl, t_rt_MatDivRR_Sgl},
+    {"RC_Sgl", true,  false, true,  t_rt_MatMultRC_Sgl, t_rt_MatMultAndIncRC_Sgl, t_rt_MatDivRC_Sgl},
+    {"CR_Sgl", true,  true,  false, t_rt_MatMultCR_Sgl, t_rt_MatMultAndIncCR_Sgl, t_rt_MatDivCR_Sgl},
+    {"CC_Sgl", true,  true,  true,  t_rt_MatMultCC_Sgl, t_rt_MatMultAndIncCC_Sgl, t_rt_MatDivCC_Sgl}
+};
+
+typedef struct tLuVariant_tag {
+    const char *name;
+    boolean_T  isSingle;
+    boolean_T  isCplx;
+    tLuFcn     lu;
+} tLuVariant;
+
+static const tLuVariant tLuVariants[] = {
+    {"real",     false, false, t_rt_lu_real},
+    {"cplx",     false, true,  t_rt_lu_cplx},
+    {"real_sgl", true,  false, t_rt_lu_real_sgl},
+    {"cplx_sgl", true,  true,  t_rt_lu_cplx_sgl}
+};
+
+/* Flops of one multiply-add of operands of the given complexity */
+static double tMacFlops(boolean_T aCplx, boolean_T bCplx)
+{
+    return (aCplx && bCplx) ? 8.0 : ((aCplx || bCplx) ? 4.0 : 2.0);
+}
+
+static int tReport(const char *kernel, const char *variant, int_T N,
+                   double flops, double secPerCall, double scaledResidual)
+{
+    boolean_T pass = (scaledResidual <= T_TOL_SCALED);
+    printf("%-4s %-12s %-8s N=%5d %9.3f GFLOP/s  scaled residual %.2e\n",
+           pass ? "PASS" : "FAIL", kernel, variant, (int)N,
+           flops/secPerCall*1e-9, scaledResidual);
+    fflush(stdout);
+    return pass ? 0 : 1;
+}
+
+/*=========*
+ * Kernels *
+ *=========*/
+
+/* Scaled residual of y = C + A*B (C == NULL for a plain product) */
+static double tCheckMatMult(const tVariant *v, const void *y, const void *C,
+                            const void *A, const void *B, int_T N)
+{
+    tType  tA, tB, tY;
+    double worst = 0.0;
+    int_T  c, i, k;
+
+    tA.isSingle = tB.isSingle = tY.isSingle = v->isSingle;
+    tA.isCplx = v->aCplx;
+    tB.isCplx = v->bCplx;
+    tY.isCplx = v->aCplx || v->bCplx;
+
+    for (c = 0; c < tNumCheckCols(N); c++) {
+        int_T j = tCheckCol(c, N);
+        for (i = 0; i < N; i++) {
+            long double re = 0.0L, im = 0.0L, absSum = 0.0L, yr, yi, err;
+            for (k = 0; k < N; k++) {
+                long double ar, ai, br, bi;
+                tGet(A, tA, (size_t)k*N + i, &ar, &ai);
+                tGet(B, tB, (size_t)j*N + k, &br, &bi);
+                tMulAdd(ar, ai, br, bi, &re, &im, &absSum);
+            }
+            if (C != NULL) {
+                long double cr, ci;
+                tGet(C, tY, (size_t)j*N + i, &cr, &ci);
+                re += cr;
+                im += ci;
+                absSum += fabsl(cr) + fabsl(ci);
+            }
+            tGet(y, tY, (size_t)j*N + i, &yr, &yi);
+            err = fabsl(yr - re) + fabsl(yi - im);
+            if (absSum > 0.0L) {
+                double s = (double)(err/(absSum*(N+1)*tEps(v->isSingle)));
+                if (s > worst) worst = s;
+            }
+        }
+    }
+    return worst;
+}
+
+static int tBenchMatMult(const tVariant *v, int_T N, boolean_T accumulate)
+{
+    tType  tA, tB, tY;
+    void   *A, *B, *y, *C = NULL;
+    int_T  dims[3];
+    double t0, t, flops, residual;
+    long   reps, r;
+    size_t ySize;
+
+    tA.isSingle = tB.isSingle = tY.isSingle = v->isSingle;
+    tA.isCplx = v->aCplx;
+    tB.isCplx = v->bCplx;
+    tY.isCplx = v->aCplx || v->bCplx;
+
+    dims[0] = dims[1] = dims[2] = N;
+    A = tRandMatrix(tA, N, N, 0.0);
+    B = tRandMatrix(tB, N, N, 0.0);
+    y = tRandMatrix(tY, N, N, 0.0);
+    ySize = (size_t)N*N*tElemSize(tY);
+    if (accumulate) {
+        C = tAlloc(tY, (size_t)N*N);
+        (void)memcpy(C, y, ySize);
+    }
+
+    (accumulate ? v->multInc : v->mult)(y, A, B, dims);
+    residual = tCheckMatMult(v, y, C, A, B, N);
+
+    /* For the timing the accumulated result is left to grow */
+    reps = 1;
+    for (;;) {
+        t0 = tNow();
+        for (r = 0; r < reps; r++) {
+            (accumulate ? v->multInc : v->mult)(y, A, B, dims);
+        }
+        t = tNow() - t0;
+        if (t >= T_MIN_TIME) break;
+        reps *= 2;
+    }
+    flops = (double)N*N*N*tMacFlops(v->aCplx, v->bCplx);
+
+    free(A);
+    free(B);
+    free(y);
+    free(C);
+    return tReport(accumulate ? "MatMultAndInc" : "MatMult", v->name, N,
+                   flops, t/(double)reps, residual);
+}
+
+/* Scaled residual of In1*Out - In2 */
+static double tCheckMatDiv(const tVariant *v, const void *Out, const void *In1,
+                           const void *In2, int_T N)
+{
+    tType  tA, tB, tY;
+    double worst = 0.0;
+    int_T  c, i, k;
+
+    tA.isSingle = tB.isSingle = tY.isSingle = v->isSingle;
+    tA.isCplx = v->aCplx;
+    tB.isCplx = v->bCplx;
+    tY.isCplx = v->aCplx || v->bCplx;
+
+    for (c = 0; c < tNumCheckCols(N); c++) {
+        int_T j = tCheckCol(c, N);
+        for (i = 0; i < N; i++) {
+            long double re = 0.0L, im = 0.0L, absSum = 0.0L, br, bi, err;
+            for (k = 0; k < N; k++) {
+                long double ar, ai, xr, xi;
+                tGet(In1, tA, (size_t)k*N + i, &ar, &ai);
+                tGet(Out, tY, (size_t)j*N + k, &xr, &xi);
+                tMulAdd(ar, ai, xr, xi, &re, &im, &absSum);
+            }
+            tGet(In2, tB, (size_t)j*N + i, &br, &bi);
+            err = fabsl(re - br) + fabsl(im - bi);
+            absSum += fabsl(br) + fabsl(bi);
+            if (absSum > 0.0L) {
+                double s = (double)(err/(absSum*(N+1)*tEps(v->isSingle)));
+                if (s > worst) worst = s;
+            }
+        }
+    }
+    return worst;
+}
+
+static int tBenchMatDiv(const tVariant *v, int_T N)
+{
+    tType   tA, tB, tY;
+    void    *In1, *In2, *Out, *lu, *x;
+    int32_T *piv;
+    int_T   dims[3];
+    double  t0, t, flops, residual;
+    long    reps, r;
+
+    tA.isSingle = tB.isSingle = tY.isSingle = v->isSingle;
+    tA.isCplx = v->aCplx;
+    tB.isCplx = v->bCplx;
+    tY.isCplx = v->aCplx || v->bCplx;
+
+    dims[0] = dims[1] = dims[2] = N;
+    /* Diagonally dominant, so that the pivot growth stays small */
+    In1 = tRandMatrix(tA, N, N, (double)N);
+    In2 = tRandMatrix(tB, N, N, 0.0);
+    Out = tAlloc(tY, (size_t)N*N);
+    x   = tAlloc(tY, (size_t)N*N);
+    lu  = tAlloc(tA, (size_t)N*N);
+    piv = (int32_T *)malloc((size_t)N*sizeof(int32_T));
+
+    v->div(Out, In1, In2, lu, piv, x, dims);
+    residual = tCheckMatDiv(v, Out, In1, In2, N);
+
+    reps = 1;
+    for (;;) {
+        t0 = tNow();
+        for (r = 0; r < reps; r++) {
+            v->div(Out, In1, In2, lu, piv, x, dims);
+        }
+        t = tNow() - t0;
+        if (t >= T_MIN_TIME) break;
+        reps *= 2;
+    }
+    /* LU of In1, then a forward and a backward substitution per column */
+    flops = 2.0/3.0*(double)N*N*N*tMacFlops(v->aCplx, v->aCplx) +
+        (double)N*N*N*tMacFlops(v->aCplx, v->bCplx);
+
+    free(In1);
+    free(In2);
+    free(Out);
+    free(x);
+    free(lu);
+    free(piv);
+    return tReport("MatDiv", v->name, N, flops, t/(double)reps, residual);
+}
+
+/* Scaled residual of L*U - A(piv,:) */
+static double tCheckLu(const tLuVariant *v, const void *LU, const int32_T *piv,
+                       const void *A, int_T N)
+{
+    tType  tA;
+    double worst = 0.0;
+    int_T  c, i, k;
+
+    tA.isSingle = v->isSingle;
+    tA.isCplx   = v->isCplx;
+
+    for (c = 0; c < tNumCheckCols(N); c++) {
+        int_T j = tCheckCol(c, N);
+        for (i = 0; i < N; i++) {
+            long double re = 0.0L, im = 0.0L, absSum = 0.0L, ar, ai, err;
+            int_T kEnd = (i < j) ? i : j;
+            for (k = 0; k <= kEnd; k++) {
+                long double lr, li, ur, ui;
+                if (k == i) {
+                    lr = 1.0L;
+                    li = 0.0L;
+                } else {
+                    tGet(LU, tA, (size_t)k*N + i, &lr, &li);
+                }
+                tGet(LU, tA, (size_t)j*N + k, &ur, &ui);
+                tMulAdd(lr, li, ur, ui, &re, &im, &absSum);
+            }
+            tGet(A, tA, (size_t)j*N + piv[i], &ar, &ai);
+            err = fabsl(re - ar) + fabsl(im - ai);
+            if (absSum > 0.0L) {
+                double s = (double)(err/(absSum*(N+1)*tEps(v->isSingle)));
+                if (s > worst) worst = s;
+            }
+        }
+    }
+    return worst;
+}
+
+static int tBenchLu(const tLuVariant *v, int_T N)
+{
+    tType   tA;
+    void    *A, *LU;
+    int32_T *piv;
+    double  t0, t, flops, residual;
+    long    reps, r;
+    size_t  aSize;
+
+    tA.isSingle = v->isSingle;
+    tA.isCplx   = v->isCplx;
+
+    A   = tRandMatrix(tA, N, N, 0.0);
+    LU  = tAlloc(tA, (size_t)N*N);
+    piv = (int32_T *)malloc((size_t)N*sizeof(int32_T));
+    aSize = (size_t)N*N*tElemSize(tA);
+
+    (void)memcpy(LU, A, aSize);
+    v->lu(LU, N, piv);
+    residual = tCheckLu(v, LU, piv, A, N);
+
+    /* The timing includes restoring A before each factorization */
+    reps = 1;
+    for (;;) {
+        t0 = tNow();
+        for (r = 0; r < reps; r++) {
+            (void)memcpy(LU, A, aSize);
+            v->lu(LU, N, piv);
+        }
+        t = tNow() - t0;
+        if (t >= T_MIN_TIME) break;
+        reps *= 2;
+    }
+    flops = 2.0/3.0*(double)N*N*N*tMacFlops(v->isCplx, v->isCplx);
+
+    free(A);
+    free(LU);
+    free(piv);
+    return tReport("lu", v->name, N, flops, t/(double)reps, residual);
+}
+
+int main(int argc, char *argv[])
+{
+    int_T  maxDim = (argc > 1) ? (int_T)atoi(argv[1]) : T_MAX_DIM;
+    int    numFailed = 0;
+    size_t d, vi;
+
+#ifdef RT_MATRIXLIB_MT
+    printf("threads %d\n",
+           (int)rt_MatrixLibThreadPoolInit((argc > 2) ? (int_T)atoi(argv[2]) : 0));
+#else
+    (void)argv;
+#endif
+
+    for (d = 0; d < sizeof(tDims)/sizeof(tDims[0]) && tDims[d] <= maxDim; d++) {
+        int_T N = tDims[d];
+        for (vi = 0; vi < sizeof(tVariants)/sizeof(tVariants[0]); vi++) {
+            numFailed += tBenchMatMult(&tVariants[vi], N, false);
+            numFailed += tBenchMatMult(&tVariants[vi], N, true);
+            numFailed += tBenchMatDiv(&tVariants[vi], N);
+        }
+        for (vi = 0; vi < sizeof(tLuVariants)/sizeof(tLuVariants[0]); vi++) {
+            numFailed += tBenchLu(&tLuVariants[vi], N);
+        }
+    }
+
+#ifdef RT_MATRIXLIB_MT
+    rt_MatrixLibThreadPoolTerminate();
+#endif
+
+    printf("%d failed\n", numFailed);
+    return (numFailed == 0) ? 0 : 1;
+}
+
+/* [EOF] tMatrixLibBench.c */
@@ -14,6 +14,7 @@
 # include "simstruc.h"
 #endif
 #include "rt_matrixlib.h"
+#include "rt_snapshot.h"
 #include "odesup.h"
 
 #define MAXORDER 4
@@ -395,3 +396,23 @@ void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
     rtsiSetSimTimeStep(si,MAJOR_TIME_STEP);
 }
 
+/* Function: rt_ODESnapshotIntegrationData ====================================
+ * Abstract:
+ *      Add the ode14x history to a model snapshot. The Jacobian and its LU
+ *      factors are recomputed at every step, so only the numjac increments
+ *      in fac, which adapt from one step to the next, are added.
+ */
+const char_T *rt_ODESnapshotIntegrationData(RTWSolverInfo *si,
+                                            struct rtSnapshot_Tag *snap)
+{
+    IntgData  *id = rtsiGetSolverData(si);
+
+#ifdef NCSTATES
+    int_T     nx  = NCSTATES;
+#else
+    int_T     nx  = rtsiGetNumContStates(si);
+#endif
+
+    return(rt_SnapshotAddRegion(snap, "ode14x.fac", id->fac,
+                                nx*sizeof(real_T)));
+}
@@ -146,5 +146,13 @@ void rt_ODEUpdateContinuousStates(RTWSolverInfo *si)
     rtsiSetSimTimeStep(si,MAJOR_TIME_STEP);
 }
 
+/* The explicit solver data is recomputed at every step; nothing to snapshot */
+const char_T *rt_ODESnapshotIntegrationData(RTWSolverInfo *si,
+                                            struct rtSnapshot_Tag *snap)
+{
+    (void)si;
+    (void)snap;
+    return(NULL);
+}
 
 /* [EOF] ode3.c */
@@ -67,6 +67,11 @@ void rt_ODEStateReduction(real_T* x, int_T* p, int_T n, real_T* r) {
                                                rtsiGetNumPeriodicContStates(si),    \
                                                rtsiGetPeriodicContStateRanges(si))
 
+struct rtSnapshot_Tag; /* see rt_snapshot.h */
+
+const char_T *rt_ODESnapshotIntegrationData(RTWSolverInfo *si,
+                                            struct rtSnapshot_Tag *snap);
+
 #ifndef USE_RTMODEL
 
 void rt_ODECreateIntegrationData(RTWSolverInfo *si);
@@ -217,5 +222,16 @@ void rt_UpdateContinuousStates(SimStruct *S)
     rt_ODERetrieveDataFromSolverInfo(S);
 }
 
+/*
+ * Add the solver data that carries over from one step to the next to a model
+ * snapshot (see rt_snapshot.h). The continuous states belong to the model and
+ * are registered with the model's other states.
+ */
+const char_T *rt_SnapshotIntegrationData(SimStruct *S, struct rtSnapshot_Tag *snap)
+{
+    rt_ODECacheDataIntoSolverInfo(S);
+    return(rt_ODESnapshotIntegrationData(ssGetRTWSolverInfo(S), snap));
+}
+
 #endif
 #endif /* __ODE_SUP__ */
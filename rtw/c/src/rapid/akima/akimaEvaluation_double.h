@@ -112,6 +112,72 @@ void akimaFixedGrid_interpolate_double
 );
 
 
+/**
+ * Choose the bin search strategy of each grid vector for
+ * akimaFixedGrid_interpolateWithBinSearch_double().
+ *
+ * Grid vectors with few nodes keep the linear search, evenly spaced grid vectors compute the bin
+ * directly, and the others try the bin of the previous query point before a binary search (see
+ * akimaBinSearch.h). All strategies return the same bins as the linear search.
+ *
+ * \param[in]  N            Number of dimensions of underlying N-D grid, i.e., \p N.
+ * \param[in]  gridSize     Size of the underlying N-D grid. In MATLAB notation:
+ *                          <tt>[gridSize(1), ..., gridSize(N)] = size(ndgrid(x1, ..., xN))</tt>,
+ *                          where <tt>x1, ..., xN </tt> are the \p N vectors defining the N-D grid.
+ * \param[in]  gridVectors  Vectors of grid coordinates: <tt> x1, x2, ..., xN</tt>.
+ *                          In MATLAB notation, the underlying N-D grid is given by:
+ *                          <tt>[XX1,...,XXN] = ndgrid(x1,...,xN)</tt>.
+ *
+ * \param[out] binSearch    Bin search descriptors. Must be \b pre-allocated with
+ *                          akimaFixedGrid_binSearchWS() elements.
+ */
+
+void akimaFixedGrid_precomputeBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    /* OUTPUTS: */
+    double*        binSearch
+);
+
+/**
+ * Interpolate using pre-computed Akima cubic polynomial coefficients and bin search strategies
+ * for fixed grid vectors and grid values, but different query points.
+ *
+ * Same results as akimaFixedGrid_interpolate_double(), but the bins of the query points are
+ * found with the strategies chosen by akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * \param[in]  workspaceEvaluation  \b Pre-allocated workspace for floating-point quantities,
+ *                                  sized by akimaFixedGrid_interpolateWithBinSearchWS().
+ * \param[in]  workspaceIndices     \b Pre-allocated workspace for MFL_INTERP_UINT, sized by
+ *                                  akimaFixedGrid_interpolateWithBinSearchWS().
+ * \param[in]  binSearch            Bin search strategies computed by
+ *                                  akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * See akimaFixedGrid_interpolate_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearch_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT         N,
+    const MFL_INTERP_UINT*        gridSize,
+    const double** gridVectors,
+    const MFL_INTERP_UINT         extrapMethod,
+    const MFL_INTERP_UINT         noDerivatives,
+    double*        workspaceEvaluation,
+    MFL_INTERP_UINT*              workspaceIndices,
+    double*        coefficients,
+    const double*  binSearch,
+    const MFL_INTERP_UINT         numQ,
+    const double** Xq,
+    MFL_INTERP_UINT**             binsXq,
+    /* OUTPUTS: */
+    double*        Vq
+);
+
 /**
  * Pre-compute Akima cubic Hermite basis for fixed grid vectors and query points,
  * but different grid values.
@@ -337,6 +403,61 @@ void akimaFixedGrid_interpolate_1D_double
     double*       vq
 );
 
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Choose the bin search strategy of a 1-D grid vector for
+ * akimaFixedGrid_interpolateWithBinSearch_1D_double(). See
+ * akimaFixedGrid_precomputeBinSearch_double().
+ *
+ * \param[in]  nx            Number of 1-D grid coordinates.
+ * \param[in]  x             Vector of 1-D grid coordinates.
+ *
+ * \param[out]  binSearch    Bin search descriptor. Must be \b pre-allocated with
+ *                           <tt>akimaFixedGrid_binSearchWS(1)</tt> elements.
+ */
+
+void akimaFixedGrid_precomputeBinSearch_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    /* OUTPUTS: */
+    double*       binSearch
+);
+
+/**
+ * Optimized 1-D function.
+ *
+ * <b>NOTE: This is a faster 1-D alternative to the general N-D code <tt>(N = 1,2,3,...)</tt>.
+ *
+ * Same results as akimaFixedGrid_interpolate_1D_double(), but the bins of the query points are
+ * found with the strategy chosen by akimaFixedGrid_precomputeBinSearch_1D_double().
+ *
+ * \param[in]  binSearch    Bin search strategy computed by
+ *                          akimaFixedGrid_precomputeBinSearch_1D_double().
+ *
+ * See akimaFixedGrid_interpolate_1D_double() for the remaining parameters.
+ */
+
+void akimaFixedGrid_interpolateWithBinSearch_1D_double
+(
+    /* INPUTS:  */
+    const MFL_INTERP_UINT        nx,
+    const double* x,
+    const MFL_INTERP_UINT        extrapMethod,
+    const MFL_INTERP_UINT        noDerivatives,
+    double*       coefficients,
+    const double* binSearch,
+    const MFL_INTERP_UINT        numQ,
+    const double* xq,
+    const MFL_INTERP_UINT*       binsXq,
+    /* OUTPUTS: */
+    double*       vq
+);
+
 
 /**
  * Optimized 1-D function.
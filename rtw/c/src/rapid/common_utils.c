@@ -19,6 +19,33 @@
 #include  <float.h>
 #include  <ctype.h>
 
+#if !defined(_WIN32) && !defined(RT_RAPID_NO_MMAP)
+# define RT_RAPID_USE_MMAP
+# include  <sys/types.h>
+# include  <sys/mman.h>
+# include  <sys/stat.h>
+# include  <fcntl.h>
+# include  <unistd.h>
+#endif
+
+#if !defined(_WIN32) && !defined(RT_RAPID_NO_FORK)
+# define RT_RAPID_USE_FORK
+# include  <sys/types.h>
+# include  <sys/wait.h>
+# include  <unistd.h>
+# include  <errno.h>
+#endif
+
+#if !defined(_WIN32) && !defined(RT_RAPID_NO_THREADS)
+# define RT_RAPID_USE_THREADS
+# include  <pthread.h>
+#endif
+
+#if !defined(_WIN32)
+# define RT_RAPID_USE_MONOTONIC_CLOCK
+#endif
+#include  <time.h>
+
 /*
  * We want access to the real mx* routines in this file and not their RTW
  * variants in rt_matrx.h, the defines below prior to including simstruc.h
@@ -50,6 +77,14 @@ extern FNamePair   *gblFrFNamepair;
 
 extern int_T         gblParamCellIndex;
 
+/* defined in rsim_utils.c or raccel_utils.c */
+extern void rt_RapidReadMatFileAndUpdateParams(const SimStruct *S);
+extern const char *rt_RapidReadParamSweepMatFile(const SimStruct *S,
+                                                 int_T firstCellIndex,
+                                                 int_T numCells);
+extern void rt_RapidUpdateParamsFromSweep(const SimStruct *S, int_T cellIndex);
+extern void rt_RapidFreeParamSweep(void);
+
 /* total signal width of root inports */
 extern int_T gblNumModelInputs;
 /* total number of root inports */
@@ -78,6 +113,12 @@ void  *slioCatalogue = NULL;
 #define MULTIPLEVAR_LIST (2) 
 
 
+#if defined(MX_HAS_INTERLEAVED_COMPLEX)
+# define IS_INTERLEAVED_COMPLEX(isComplex) (isComplex)
+#else
+# define IS_INTERLEAVED_COMPLEX(isComplex) false
+#endif
+
 # define Interpolate(v1,v2,f1,f2) \
 	    (((v1)==(v2))?((real_T)(v1)):\
                           (((f1)*((real_T)(v1)))+((f2)*((real_T)(v2)))))
@@ -94,15 +135,51 @@ void  *slioCatalogue = NULL;
   that still need the de-interleaved representation and cannot be changed
   at this time.  
 
+  The usual element sizes are split with typed loops, which the compiler
+  vectorizes; other sizes fall back to a memcpy per part.
+
   TODO: watch out for performance impact, and do work to remove this.
 */
-static void deInterleaveComplex(char* realDst, char* imagDst, char* src, 
+#define DEINTERLEAVE_COMPLEX(T)                                 \
+    {                                                           \
+        T       *re = (T *)realDst;                             \
+        T       *im = (T *)imagDst;                             \
+        const T *in = (const T *)src;                           \
+        for (i = 0; i < numEls; i++) {                          \
+            re[i] = in[2*i];                                    \
+            im[i] = in[2*i+1];                                  \
+        }                                                       \
+    }
+
+static void deInterleaveComplex(char* realDst, char* imagDst, const char* src, 
                                 size_t halfElementSize, size_t M, size_t N) {
-    size_t i, j;
-    for (j=0;j < N;j++)
-    {
-        for (i=0;i < M;i++)
+    size_t i, numEls = M*N;
+    switch (halfElementSize) {
+      case 8:
+        /* Copy as pairs of 32-bit words, so no value goes through an FPU */
         {
+            uint32_T       *re = (uint32_T *)realDst;
+            uint32_T       *im = (uint32_T *)imagDst;
+            const uint32_T *in = (const uint32_T *)src;
+            for (i = 0; i < numEls; i++) {
+                re[2*i]   = in[4*i];
+                re[2*i+1] = in[4*i+1];
+                im[2*i]   = in[4*i+2];
+                im[2*i+1] = in[4*i+3];
+            }
+        }
+        break;
+      case 4:
+        DEINTERLEAVE_COMPLEX(uint32_T)
+        break;
+      case 2:
+        DEINTERLEAVE_COMPLEX(uint16_T)
+        break;
+      case 1:
+        DEINTERLEAVE_COMPLEX(uint8_T)
+        break;
+      default:
+        for (i = 0; i < numEls; i++) {
             /* Copy real part. */
             (void)memcpy(realDst,src,halfElementSize);
             src += halfElementSize;
@@ -113,9 +190,12 @@ static void deInterleaveComplex(char* realDst, char* imagDst, char* src,
             src += halfElementSize;
             imagDst += halfElementSize;
         }
+        break;
     }
 }
 
+#undef DEINTERLEAVE_COMPLEX
+
 /*
   This is taken from rt_matrx with an added multiplication factor
  */
@@ -857,12 +937,16 @@ static const char* setGblInportTUtableElement(int_T inportIdx,
                                               bool isComplex,
                                               bool isPeriodicFcnCall,
                                               char* matDataRe,
-                                              char* matDataIm) {
+                                              char* matDataIm,
+                                              bool isInterleaved,
+                                              mxClassID storageClass) {
     int_T portWidth  = 
         gblInportDims[inportIdx*2]*gblInportDims[inportIdx*2 + 1];
     gblInportTUtables[inportIdx].ur = NULL;
     gblInportTUtables[inportIdx].ui = NULL;
     gblInportTUtables[inportIdx].time = NULL; 
+    gblInportTUtables[inportIdx].elSize = 0;
+    gblInportTUtables[inportIdx].interpFcn = NULL;
     
     gblInportTUtables[inportIdx].complex = isComplex ? 1 : 0;    
     gblInportTUtables[inportIdx].isPeriodicFcnCall = isPeriodicFcnCall;
@@ -881,6 +965,21 @@ static const char* setGblInportTUtableElement(int_T inportIdx,
     gblInportTUtables[inportIdx].time = inportTimeDataPtr;
 
     if (elementSize > 0) {
+        /*
+         * Interleaved complex data is split straight into the TU table; each
+         * part is half the size of a complex element.
+         */
+        if (isInterleaved) {
+            elementSize /= 2;
+        }
+
+        /* select the interpolation kernel once, when the inport is loaded */
+        gblInportTUtables[inportIdx].elSize = elementSize;
+        gblInportTUtables[inportIdx].interpFcn =
+            rt_GetInterpolateDatatypeFcn(
+                rt_GetInterpolateStorageDTypeId(gblInportDataTypeIdx[inportIdx],
+                                                storageClass));
+
         /* allocate memory */
         gblInportTUtables[inportIdx].ur = 
             (char*)calloc(numOfTimePoints*portWidth,elementSize);     
@@ -899,6 +998,14 @@ static const char* setGblInportTUtableElement(int_T inportIdx,
         
         /* now we can steal the data from the mxArray and 
          * generate tu table */
+
+        if (isInterleaved) {
+            deInterleaveComplex(gblInportTUtables[inportIdx].ur,
+                                gblInportTUtables[inportIdx].ui,
+                                matDataRe, elementSize,
+                                numOfTimePoints, portWidth);
+            return NULL;
+        }
     
         (void)memcpy(gblInportTUtables[inportIdx].ur, matDataRe, 
                      elementSize*numOfTimePoints*portWidth);
@@ -947,9 +1054,6 @@ const char* rt_ConvertInportsMatDatatoTUtable(int_T matFileDataFormat,
     int_T  portWidth;
     int_T  inportIdx;
     size_t elementSize = 0; /* invalid value */
-#if defined(MX_HAS_INTERLEAVED_COMPLEX)
-    void *matData = NULL;
-#endif
   
     mxArray *mxInportSignal;
     const double* timeDataPtr = NULL;       
@@ -965,9 +1069,11 @@ const char* rt_ConvertInportsMatDatatoTUtable(int_T matFileDataFormat,
         /* If we are in raccel the first variable is the 
          * externalInputIsInDatasetFormat flag.
          */
+        mxDestroyArray(mxInputPtr);
         mxInputPtr = matGetNextVariable(pmat, NULL);
 
         /* The second variable is the set of periodic function call flags. */
+        mxDestroyArray(mxInputPtr);
         mxInputPtr = matGetNextVariable(pmat, NULL);
     }
 
@@ -1009,7 +1115,8 @@ const char* rt_ConvertInportsMatDatatoTUtable(int_T matFileDataFormat,
         for (inportIdx = 0; inportIdx < gblNumRootInportBlks; ++inportIdx) {
             result = setGblInportTUtableElement(inportIdx, numOfTimePoints, 
                                                 inportTimeDataPtr, elementSize, 
-                                                false, false, matDataRe, NULL);
+                                                false, false, matDataRe, NULL,
+                                                false, mxDOUBLE_CLASS);
             if (result != NULL){
                 (void)strcpy(errmsg, result);
                 goto EXIT_POINT;
@@ -1058,36 +1165,18 @@ const char* rt_ConvertInportsMatDatatoTUtable(int_T matFileDataFormat,
                          false : (bool) gblInportComplex[inportIdx]);  
             elementSize = mxGetElementSize(mxInportSignalValues);
 #if defined(MX_HAS_INTERLEAVED_COMPLEX)
-            /* Conversion to non-interleaved. */
-            matData = mxGetData(mxInportSignalValues);
-            if(isComplex) {
-                size_t halfElementSize = elementSize/2;
-                size_t ncols = mxGetN(mxInportSignalValues);
-                matDataRe = (char*)calloc(numOfTimePoints*ncols,halfElementSize);
-                matDataIm = (char*)calloc(numOfTimePoints*ncols,halfElementSize);
-                deInterleaveComplex(matDataRe, matDataIm, matData, 
-                                    halfElementSize, numOfTimePoints, ncols);
-            } else {
-                matDataRe = matData;
-            }
-            /* Stay with old non-interleaved model beyond this point for now. */
+            /* Complex data is de-interleaved while it is copied to the tu table */
+            matDataRe = mxGetData(mxInportSignalValues);
+            matDataIm = NULL;
 #else
             matDataRe = mxGetData(mxInportSignalValues);
             matDataIm = isComplex ? mxGetImagData(mxInportSignalValues) : NULL;
 #endif
             result = setGblInportTUtableElement(inportIdx, numOfTimePoints, 
                                                 inportTimeDataPtr, elementSize, 
-                                                isComplex, false, matDataRe, matDataIm);
-#if defined(MX_HAS_INTERLEAVED_COMPLEX)
-            /* setGblInportTUtableElement() has made a copy. */
-            if(isComplex) {
-                /* In the real case, we are just using the original matrix directly.
-                   This is already getting freed.  In the complex case, we calloc()'ed
-                   additional arrays, free them now. */
-                free(matDataRe);
-                free(matDataIm);
-            }
-#endif
+                                                isComplex, false, matDataRe, matDataIm,
+                                                IS_INTERLEAVED_COMPLEX(isComplex),
+                                                mxGetClassID(mxInportSignalValues));
             if (result != NULL){
                 (void)strcpy(errmsg, result);
                 goto EXIT_POINT;
@@ -1182,7 +1271,7 @@ const char* rt_ConvertInportsMatDatatoTUtable(int_T matFileDataFormat,
                 result = setGblInportTUtableElement(
                     inportIdx, numOfTimePoints, inportTimeDataPtr, 
                     elementSize, false, periodicFunctionCallInports[inportIdx],
-                    matDataRe, NULL);
+                    matDataRe, NULL, false, mxDOUBLE_CLASS);
                 if (result != NULL) {
                     (void)strcpy(errmsg, result);
                     goto EXIT_POINT;
@@ -1223,42 +1312,25 @@ const char* rt_ConvertInportsMatDatatoTUtable(int_T matFileDataFormat,
                              false : (bool) gblInportComplex[inportIdx]);  
                 elementSize = mxGetElementSize(mxInportSignalValues);
 #if defined(MX_HAS_INTERLEAVED_COMPLEX)
-                /* Conversion to non-interleaved. */
-                matData = mxGetData(mxInportSignalValues);
-                if(isComplex) {
-                    size_t halfElementSize = elementSize/2;
-                    size_t ncols = mxGetN(mxInportSignalValues);
-                    matDataRe = (char*)calloc(numOfTimePoints*ncols,halfElementSize);
-                    matDataIm = (char*)calloc(numOfTimePoints*ncols,halfElementSize);
-                    deInterleaveComplex(matDataRe, matDataIm, matData, 
-                                        halfElementSize, numOfTimePoints, ncols);
-                } else {
-                    matDataRe = matData;
-                }
-                /* Stay with old non-interleaved model beyond this point for now. */
+                /* Complex data is de-interleaved while it is copied to the tu table */
+                matDataRe = mxGetData(mxInportSignalValues);
+                matDataIm = NULL;
 #else
                 matDataRe = mxGetData(mxInportSignalValues);
                 matDataIm = isComplex ? mxGetImagData(mxInportSignalValues) : NULL;
 #endif
                 result = setGblInportTUtableElement(
                     inportIdx, numOfTimePoints, inportTimeDataPtr, elementSize,
-                    isComplex, false, matDataRe, matDataIm);
-
-#if defined(MX_HAS_INTERLEAVED_COMPLEX)
-            /* setGblInportTUtableElement() has made a copy. */
-            if(isComplex) {
-                /* In the real case, we are just using the original matrix directly.
-                   This is already getting freed.  In the complex case, we calloc()'ed
-                   additional arrays, free them now. */
-                free(matDataRe);
-                free(matDataIm);
-            }
-#endif          
+                    isComplex, false, matDataRe, matDataIm,
+                    IS_INTERLEAVED_COMPLEX(isComplex),
+                    mxGetClassID(mxInportSignalValues));
                 if (result != NULL){
                     (void)strcpy(errmsg, result);
                     goto EXIT_POINT;
                 }
             }
+            /* The tu table holds copies; release the variable before reading the next */
+            mxDestroyArray(mxInputPtr);
             mxInputPtr = matGetNextVariable(pmat, NULL);
         }
 
@@ -1296,6 +1368,152 @@ static void FreeFNamePairList(FNamePair *list, int_T len)
 } /* end FreeFFnameList */
 
 
+/* Function: RemapFromFileName ================================================
+ * Abstract:
+ *	Return the MAT-filename to read for a From File block, remapped if told
+ *      to do so by the user via a -f command line switch.
+ */
+static const char *RemapFromFileName(const char *origFileName)
+{
+    int_T i;
+
+    for (i=0; i<gblNumFrFiles; i++) {
+        if (gblFrFNamepair[i].newName != NULL && \
+            strcmp(origFileName, gblFrFNamepair[i].oldName)==0) {
+            gblFrFNamepair[i].remapped = 1;
+            return gblFrFNamepair[i].newName; /* remap */
+        }
+    }
+    return origFileName;
+
+} /* end RemapFromFileName */
+
+
+/*
+ * Level 5 MAT-file data types and array class used by the From File
+ * streaming reader.
+ */
+#define MAT5_HEADER_BYTES   (128)
+#define MAT5_VERSION        (0x0100)
+#define MAT5_ENDIAN_NATIVE  (('M' << 8) | 'I')
+#define MAT5_miINT8         (1)
+#define MAT5_miINT32        (5)
+#define MAT5_miUINT32       (6)
+#define MAT5_miDOUBLE       (9)
+#define MAT5_miMATRIX       (14)
+#define MAT5_mxDOUBLE_CLASS (6)
+#define MAT5_COMPLEX_FLAG   (0x0800)
+
+/* Function: ReadMat5Tag ======================================================
+ * Abstract:
+ *	Read the tag of a level 5 MAT-file data element. For small data
+ *      elements (data packed into the tag) *smallData is set to 1 and the
+ *      4 data bytes are left in the file.
+ *
+ * Returns:
+ *	1 on success, 0 on read failure.
+ */
+static int ReadMat5Tag(FILE *fp, uint32_T *type, uint32_T *nbytes, int *smallData)
+{
+    uint32_T tag[2];
+
+    if (fread(tag, sizeof(uint32_T), 1, fp) != 1) return 0;
+    if ((tag[0] >> 16) != 0) {
+        *type      = tag[0] & 0xFFFF;
+        *nbytes    = tag[0] >> 16;
+        *smallData = 1;
+        return 1;
+    }
+    if (fread(tag+1, sizeof(uint32_T), 1, fp) != 1) return 0;
+    *type      = tag[0];
+    *nbytes    = tag[1];
+    *smallData = 0;
+    return 1;
+
+} /* end ReadMat5Tag */
+
+
+/* Function: LocateFromFileStreamData =========================================
+ * Abstract:
+ *	Check that the first variable in a From File MAT-file is stored as an
+ *      uncompressed, real, 2-D double matrix in a native-endian level 5
+ *      MAT-file, and locate its data.
+ *
+ * Returns:
+ *	1 if the data can be streamed (*nrows, *ncols, *dataOffset are set),
+ *      0 otherwise (compressed or HDF5-based MAT-files, integer storage,
+ *      byte-swapped files, ...).
+ */
+static int LocateFromFileStreamData(FILE *fp, int *nrows, int *ncols, size_t *dataOffset)
+{
+    unsigned char  header[MAT5_HEADER_BYTES];
+    unsigned short version, endian;
+    uint32_T       type, nbytes, flags[2];
+    int32_T        dims[2];
+    int            smallData;
+    long           pos;
+
+    if (fread(header, 1, MAT5_HEADER_BYTES, fp) != MAT5_HEADER_BYTES) return 0;
+    (void)memcpy(&version, header+124, sizeof(version));
+    (void)memcpy(&endian,  header+126, sizeof(endian));
+    if (version != MAT5_VERSION || endian != MAT5_ENDIAN_NATIVE) return 0;
+
+    /* matrix element */
+    if (!ReadMat5Tag(fp, &type, &nbytes, &smallData) ||
+        smallData || type != MAT5_miMATRIX) return 0;
+
+    /* array flags: class and complexity */
+    if (!ReadMat5Tag(fp, &type, &nbytes, &smallData) ||
+        smallData || type != MAT5_miUINT32 || nbytes != 8) return 0;
+    if (fread(flags, sizeof(uint32_T), 2, fp) != 2) return 0;
+    if ((flags[0] & 0xFF) != MAT5_mxDOUBLE_CLASS ||
+        (flags[0] & MAT5_COMPLEX_FLAG) != 0) return 0;
+
+    /* dimensions: 2-D only */
+    if (!ReadMat5Tag(fp, &type, &nbytes, &smallData) ||
+        smallData || type != MAT5_miINT32 || nbytes != 8) return 0;
+    if (fread(dims, sizeof(int32_T), 2, fp) != 2) return 0;
+
+    /* array name, padded to 8 bytes */
+    if (!ReadMat5Tag(fp, &type, &nbytes, &smallData) || type != MAT5_miINT8) return 0;
+    if (smallData) {
+        if (fseek(fp, 4, SEEK_CUR) != 0) return 0;
+    } else if (nbytes > 0) {
+        if (fseek(fp, (long)((nbytes + 7) & ~7u), SEEK_CUR) != 0) return 0;
+    }
+
+    /* real part: must be stored as doubles, not as a smaller integer type */
+    if (!ReadMat5Tag(fp, &type, &nbytes, &smallData) ||
+        smallData || type != MAT5_miDOUBLE ||
+        (size_t)nbytes != (size_t)dims[0] * (size_t)dims[1] * sizeof(double)) return 0;
+
+    /* The data follows the header and the first tags, well within a long */
+    pos = ftell(fp);
+    if (pos < 0) return 0;
+
+    *nrows      = (int)dims[0];
+    *ncols      = (int)dims[1];
+    *dataOffset = (size_t)pos;
+    return 1;
+
+} /* end LocateFromFileStreamData */
+
+
+/* Function: SeekFromFileStream ===============================================
+ * Abstract:
+ *	Seek to a byte offset of a From File MAT-file, using 64-bit offsets.
+ */
+static int SeekFromFileStream(FILE *fp, size_t offset)
+{
+#if defined(_WIN32)
+    return _fseeki64(fp, (__int64)offset, SEEK_SET);
+#else
+    return fseeko(fp, (off_t)offset, SEEK_SET);
+#endif
+
+} /* end SeekFromFileStream */
+
+
 /*==================*
  * Visible routines *
  *==================*/
@@ -1338,22 +1556,9 @@ const char *rt_RapidReadFromFileBlockMatFile(const char *origFileName,
      * Remap the "original" MAT-filename if told to do by user via a *
      * -f command line switch.                                        *
      ******************************************************************/
-    {
-        int_T i;
-
-        frFInfo->origFileName  = origFileName;
-        frFInfo->originalWidth = originalWidth;
-        frFInfo->newFileName   = origFileName; /* assume */
-
-        for (i=0; i<gblNumFrFiles; i++) {
-            if (gblFrFNamepair[i].newName != NULL && \
-                strcmp(origFileName, gblFrFNamepair[i].oldName)==0) {
-                frFInfo->newFileName = gblFrFNamepair[i].newName; /* remap */
-                gblFrFNamepair[i].remapped = 1;
-                break;
-            }
-        }
-    }
+    frFInfo->origFileName  = origFileName;
+    frFInfo->originalWidth = originalWidth;
+    frFInfo->newFileName   = RemapFromFileName(origFileName);
 
     if ((pmat=matOpen(matFile=frFInfo->newFileName,"r")) == NULL) {
         (void)sprintf(errmsg,"could not open MAT-file '%s' containing "
@@ -1443,6 +1648,688 @@ EXIT_POINT:
 } /* end rt_RapidReadFromFileBlockMatFile */
 
 
+#ifdef RT_RAPID_USE_MMAP
+/* Function: AdviseFromFileStream =============================================
+ * Abstract:
+ *	Move the look-ahead window of a memory-mapped From File stream to start
+ *      at firstPoint: release the pages of earlier time points and ask the
+ *      system to page in the window.
+ */
+static void AdviseFromFileStream(FrFStream *frFStream, int firstPoint)
+{
+    char   *base     = (char *)frFStream->mapBase;
+    size_t pageMask  = (size_t)sysconf(_SC_PAGESIZE) - 1;
+    size_t ptBytes   = (size_t)frFStream->originalWidth * sizeof(double);
+    size_t dataEnd   = frFStream->dataOffset + (size_t)frFStream->nptsPerSignal * ptBytes;
+    size_t begin     = (frFStream->dataOffset + (size_t)firstPoint * ptBytes) & ~pageMask;
+    size_t end       = frFStream->dataOffset +
+        (size_t)(firstPoint + frFStream->windowLength) * ptBytes;
+
+    if (end > dataEnd) end = dataEnd;
+
+# ifdef MADV_DONTNEED
+    if (begin > frFStream->releasedBytes) {
+        (void)madvise(base + frFStream->releasedBytes,
+                      begin - frFStream->releasedBytes, MADV_DONTNEED);
+    }
+# endif
+    /* Moving backwards pages the data in again: release it on the way forward */
+    frFStream->releasedBytes = begin;
+
+# ifdef MADV_WILLNEED
+    if (end > begin) {
+        (void)madvise(base + begin, end - begin, MADV_WILLNEED);
+    }
+# endif
+
+} /* end AdviseFromFileStream */
+#endif
+
+
+/* Function: rt_RapidFromFileStreamGetPoints ==================================
+ * Abstract:
+ *      Return numPoints consecutive columns of the TU matrix of a From File
+ *      stream, starting at column firstPoint. Each column holds the time
+ *      and then the originalWidth-1 signal values of one time point, as
+ *      stored in the MAT-file (no transpose).
+ *
+ *      Memory-mapped streams return a pointer into the mapping and keep a
+ *      window of windowCapacity time points paged in. Buffered streams read
+ *      windowCapacity time points at a time, so numPoints must not exceed
+ *      windowCapacity. The returned data stays valid until the next call.
+ *
+ * Returns:
+ *	pointer to the data, or NULL if the points are out of range or cannot
+ *      be read.
+ */
+const double *rt_RapidFromFileStreamGetPoints(FrFStream *frFStream,
+                                              int firstPoint,
+                                              int numPoints)
+{
+    size_t ptBytes;
+
+    if (!frFStream->isStreamable || firstPoint < 0 || numPoints < 0 ||
+        firstPoint + numPoints > frFStream->nptsPerSignal) {
+        return NULL;
+    }
+
+    ptBytes = (size_t)frFStream->originalWidth * sizeof(double);
+
+    /* Is the request inside the current window? */
+    if (firstPoint < frFStream->windowStart ||
+        firstPoint + numPoints > frFStream->windowStart + frFStream->windowLength) {
+
+        int len = frFStream->nptsPerSignal - firstPoint;
+        if (len > frFStream->windowCapacity) len = frFStream->windowCapacity;
+
+#ifdef RT_RAPID_USE_MMAP
+        if (frFStream->mapBase != NULL) {
+            if (numPoints > len) len = numPoints;
+            frFStream->windowLength = len;
+            AdviseFromFileStream(frFStream, firstPoint);
+            frFStream->windowStart = firstPoint;
+        } else
+#endif
+        {
+            if (numPoints > frFStream->windowCapacity ||
+                SeekFromFileStream((FILE *)frFStream->fp, frFStream->dataOffset +
+                                   (size_t)firstPoint * ptBytes) != 0 ||
+                fread(frFStream->window, ptBytes, (size_t)len,
+                      (FILE *)frFStream->fp) != (size_t)len) {
+                frFStream->windowLength = 0;
+                return NULL;
+            }
+            frFStream->windowStart  = firstPoint;
+            frFStream->windowLength = len;
+        }
+    }
+
+#ifdef RT_RAPID_USE_MMAP
+    if (frFStream->mapBase != NULL) {
+        return (const double *)((const char *)frFStream->mapBase +
+                                frFStream->dataOffset) +
+            (size_t)firstPoint * frFStream->originalWidth;
+    }
+#endif
+    return frFStream->window +
+        (size_t)(firstPoint - frFStream->windowStart) * frFStream->originalWidth;
+
+} /* end rt_RapidFromFileStreamGetPoints */
+
+
+/* Function: rt_RapidCloseFromFileStream ======================================
+ * Abstract:
+ *      Release the mapping, file and look-ahead buffer of a From File stream.
+ */
+void rt_RapidCloseFromFileStream(FrFStream *frFStream)
+{
+#ifdef RT_RAPID_USE_MMAP
+    if (frFStream->mapBase != NULL) {
+        (void)munmap(frFStream->mapBase, frFStream->mapLength);
+        frFStream->mapBase = NULL;
+    }
+#endif
+    if (frFStream->fp != NULL) {
+        (void)fclose((FILE *)frFStream->fp);
+        frFStream->fp = NULL;
+    }
+    if (frFStream->window != NULL) {
+        free(frFStream->window);
+        frFStream->window = NULL;
+    }
+    frFStream->isStreamable = 0;
+
+} /* end rt_RapidCloseFromFileStream */
+
+
+/* Function: rt_RapidOpenFromFileStream =======================================
+ * Abstract:
+ *      Streaming alternative to rt_RapidReadFromFileBlockMatFile. Instead of
+ *      loading and transposing the whole TU matrix, the matrix is read in
+ *      place from the MAT-file, windowPoints time points at a time (see
+ *      rt_RapidFromFileStreamGetPoints). The file is memory-mapped where
+ *      available (define RT_RAPID_NO_MMAP to disable) and read through a
+ *      look-ahead buffer otherwise, so the memory used does not grow with
+ *      the length of the recording.
+ *
+ *      Only uncompressed level 5 MAT-files (saved with -v6) holding a real
+ *      double TU matrix can be streamed. For other MAT-files,
+ *      frFStream->isStreamable is 0 and the caller falls back to
+ *      rt_RapidReadFromFileBlockMatFile.
+ *
+ *      originalWidth    = number of rows of the TU matrix
+ *      windowPoints     = number of time points in the look-ahead window,
+ *                         or 0 for RT_FRF_STREAM_WINDOW
+ *
+ * Returns:
+ *	NULL    : success (check frFStream->isStreamable)
+ *      non-NULL: error message
+ */
+const char *rt_RapidOpenFromFileStream(const char *origFileName,
+                                       int originalWidth,
+                                       int windowPoints,
+                                       FrFStream *frFStream)
+{
+    static char  errmsg[1024];
+    FILE         *fp = NULL;
+    const char   *matFile;
+    const double *tu;
+    int          nrows, ncols, first, num, i;
+    double       lastTime = 0.0;
+
+    errmsg[0] = '\0'; /* assume success */
+
+    (void)memset(frFStream, 0, sizeof(FrFStream));
+    frFStream->origFileName   = origFileName;
+    frFStream->originalWidth  = originalWidth;
+    frFStream->newFileName    = RemapFromFileName(origFileName);
+    frFStream->windowCapacity = (windowPoints > 0) ? windowPoints : RT_FRF_STREAM_WINDOW;
+
+    if ((fp=fopen(matFile=frFStream->newFileName,"rb")) == NULL) {
+        (void)sprintf(errmsg,"could not open MAT-file '%s' containing "
+                      "From File Block data", matFile);
+        goto EXIT_POINT;
+    }
+
+    if (!LocateFromFileStreamData(fp, &nrows, &ncols, &frFStream->dataOffset)) {
+        goto EXIT_POINT; /* not streamable: no error */
+    }
+
+    if ( nrows<2 ) {
+        (void)sprintf(errmsg,"\"From File\" matrix variable from MAT-file "
+                      "'%s' must contain at least 2 rows", matFile);
+        goto EXIT_POINT;
+    }
+    if (originalWidth != nrows) {
+        /* Note, origWidth is determined by fromfile.tlc */
+        (void)sprintf(errmsg,"\"From File\" number of rows in MAT-file "
+                      "'%s' must match original number of rows", matFile);
+        goto EXIT_POINT;
+    }
+    frFStream->nptsPerSignal = ncols;
+
+#ifdef RT_RAPID_USE_MMAP
+    {
+        struct stat st;
+        int         fd = open(matFile, O_RDONLY);
+
+        if (fd >= 0) {
+            if (fstat(fd, &st) == 0 &&
+                (size_t)st.st_size >= frFStream->dataOffset +
+                (size_t)nrows * (size_t)ncols * sizeof(double)) {
+                void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                if (base != MAP_FAILED) {
+                    frFStream->mapBase   = base;
+                    frFStream->mapLength = (size_t)st.st_size;
+                }
+            }
+            (void)close(fd);
+        }
+    }
+#endif
+
+    if (frFStream->mapBase == NULL) {
+        frFStream->window = (double *)malloc((size_t)frFStream->windowCapacity *
+                                             (size_t)nrows * sizeof(double));
+        if (frFStream->window == NULL) {
+            (void)sprintf(errmsg,"memory allocation error "
+                          "(rt_RapidOpenFromFileStream %s)", matFile);
+            goto EXIT_POINT;
+        }
+        frFStream->fp = fp;
+        fp = NULL;
+    }
+    frFStream->isStreamable = 1;
+
+    /*
+     * Verify that the time vector is monotonically increasing, one window
+     * at a time.
+     */
+    for (first = 0; first < ncols; first += num) {
+        num = ncols - first;
+        if (num > frFStream->windowCapacity) num = frFStream->windowCapacity;
+
+        if ((tu = rt_RapidFromFileStreamGetPoints(frFStream, first, num)) == NULL) {
+            (void)sprintf(errmsg,"could not read From File Block data "
+                          "from MAT-file '%s'", matFile);
+            goto EXIT_POINT;
+        }
+        for (i = 0; i < num; i++) {
+            if (first+i > 0 && tu[i*nrows] < lastTime) {
+                (void)sprintf(errmsg,"Time in \"From File\" MAT-file "
+                              "'%s' must be monotonically increasing",
+                              matFile);
+                goto EXIT_POINT;
+            }
+            lastTime = tu[i*nrows];
+        }
+    }
+
+    /* Start over at the first window */
+    if (rt_RapidFromFileStreamGetPoints(frFStream, 0, 1) == NULL) {
+        (void)sprintf(errmsg,"could not read From File Block data "
+                      "from MAT-file '%s'", matFile);
+    }
+
+EXIT_POINT:
+
+    if (fp != NULL) {
+        (void)fclose(fp);
+    }
+
+    if (errmsg[0] != '\0') {
+        rt_RapidCloseFromFileStream(frFStream);
+    }
+
+    return (errmsg[0] != '\0'? errmsg: NULL);
+
+} /* end rt_RapidOpenFromFileStream */
+
+
+#ifdef RT_RAPID_USE_THREADS
+/* Background reader of a streaming root inport */
+typedef struct {
+    pthread_t       thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    int_T           fillRequested; /* fill the window not in use    */
+    int_T           fillDone;      /* that window is ready for use  */
+    int_T           shutdown;
+} InportStreamReader;
+#endif
+
+
+/* Function: InportStreamElementSize ==========================================
+ * Abstract:
+ *	Size of one element of a built-in data type, or 0 if the data type
+ *      cannot be streamed.
+ */
+static size_t InportStreamElementSize(int dType)
+{
+    switch (dType) {
+      case SS_DOUBLE:  return sizeof(real_T);
+      case SS_SINGLE:  return sizeof(real32_T);
+      case SS_INT8:    return sizeof(int8_T);
+      case SS_UINT8:   return sizeof(uint8_T);
+      case SS_INT16:   return sizeof(int16_T);
+      case SS_UINT16:  return sizeof(uint16_T);
+      case SS_INT32:   return sizeof(int32_T);
+      case SS_UINT32:  return sizeof(uint32_T);
+      case SS_BOOLEAN: return sizeof(boolean_T);
+      default:         return 0;
+    }
+
+} /* end InportStreamElementSize */
+
+
+/* Function: FillInportStreamWindow ===========================================
+ * Abstract:
+ *	Read the next time points of a streaming inport into window w. The
+ *      window starts with the last time point of the other window, so that
+ *      the simulation can interpolate across the window boundary. Only
+ *      reads the other window, which may be in use by the simulation.
+ */
+static void FillInportStreamWindow(rtInportStream *inportStream, int_T w)
+{
+    int_T  other   = 1 - w;
+    size_t ptBytes = inportStream->elSize * (size_t)inportStream->width;
+    int_T  n       = 0;
+    int_T  want, got, i;
+
+    if (inportStream->windowLength[other] > 0) {
+        int_T last = inportStream->windowLength[other] - 1;
+        inportStream->time[w][0] = inportStream->time[other][last];
+        (void)memcpy(inportStream->data[w],
+                     inportStream->data[other] + (size_t)last*ptBytes, ptBytes);
+        n = 1;
+    }
+
+    want = inportStream->windowCapacity - n;
+    if (inportStream->numPoints >= 0 &&
+        want > inportStream->numPoints - inportStream->pointsRead) {
+        want = inportStream->numPoints - inportStream->pointsRead;
+    }
+    got = (want > 0) ?
+        (int_T)fread(inportStream->staging, inportStream->recordSize,
+                     (size_t)want, (FILE *)inportStream->fp) : 0;
+
+    for (i = 0; i < got; i++) {
+        const char *record = inportStream->staging +
+            (size_t)i*inportStream->recordSize;
+        (void)memcpy(&inportStream->time[w][n+i], record, sizeof(real_T));
+        (void)memcpy(inportStream->data[w] + (size_t)(n+i)*ptBytes,
+                     record + sizeof(real_T), ptBytes);
+    }
+    inportStream->pointsRead     += got;
+    inportStream->windowLength[w] = n + got;
+    inportStream->isLastWindow[w] = (got < want) ||
+        (inportStream->numPoints >= 0 &&
+         inportStream->pointsRead >= inportStream->numPoints);
+
+} /* end FillInportStreamWindow */
+
+
+#ifdef RT_RAPID_USE_THREADS
+/* Function: InportStreamReaderMain ===========================================
+ * Abstract:
+ *	Background reader: fill the window not in use whenever the
+ *      simulation moves on to the other window.
+ */
+static void *InportStreamReaderMain(void *arg)
+{
+    rtInportStream      *inportStream = (rtInportStream *)arg;
+    InportStreamReader  *reader       = (InportStreamReader *)inportStream->reader;
+
+    (void)pthread_mutex_lock(&reader->mutex);
+    for (;;) {
+        while (!reader->fillRequested && !reader->shutdown) {
+            (void)pthread_cond_wait(&reader->cond, &reader->mutex);
+        }
+        if (reader->shutdown) break;
+        reader->fillRequested = 0;
+        (void)pthread_mutex_unlock(&reader->mutex);
+
+        FillInportStreamWindow(inportStream, 1 - inportStream->current);
+
+        (void)pthread_mutex_lock(&reader->mutex);
+        reader->fillDone = 1;
+        (void)pthread_cond_broadcast(&reader->cond);
+    }
+    (void)pthread_mutex_unlock(&reader->mutex);
+    return NULL;
+
+} /* end InportStreamReaderMain */
+#endif
+
+
+/* Function: AdvanceInportStream ==============================================
+ * Abstract:
+ *	Move the simulation on to the other window of a streaming inport, and
+ *      start reading the window after it. Without a background reader the
+ *      other window is read here.
+ */
+static void AdvanceInportStream(rtInportStream *inportStream)
+{
+#ifdef RT_RAPID_USE_THREADS
+    InportStreamReader *reader = (InportStreamReader *)inportStream->reader;
+
+    if (reader != NULL) {
+        (void)pthread_mutex_lock(&reader->mutex);
+        while (!reader->fillDone) {
+            (void)pthread_cond_wait(&reader->cond, &reader->mutex);
+        }
+        reader->fillDone     = 0;
+        inportStream->current = 1 - inportStream->current;
+        if (!inportStream->isLastWindow[inportStream->current]) {
+            reader->fillRequested = 1;
+            (void)pthread_cond_broadcast(&reader->cond);
+        }
+        (void)pthread_mutex_unlock(&reader->mutex);
+    } else
+#endif
+    {
+        FillInportStreamWindow(inportStream, 1 - inportStream->current);
+        inportStream->current = 1 - inportStream->current;
+    }
+    inportStream->windowIndex++;
+    inportStream->currTimeIdx = 0;
+
+} /* end AdvanceInportStream */
+
+
+/* Function: rt_RapidOpenInportStream =========================================
+ * Abstract:
+ *      Streaming alternative to loading a root inport with
+ *      rt_RapidReadInportsMatFile, for recordings that do not fit in memory.
+ *      The inport values are read windowPoints time points at a time into
+ *      one of two windows, while the simulation interpolates in the other
+ *      one (see rt_RapidInportStreamOutput). Where threads are available
+ *      (define RT_RAPID_NO_THREADS to disable) the next window is read on a
+ *      background thread, so the simulation only waits for the disk if it
+ *      gets through a window faster than the next one can be read.
+ *
+ *      fileName is either
+ *        - an uncompressed level 5 MAT-file (saved with -v6) whose first
+ *          variable is a real double TU matrix with width+1 rows: the time
+ *          and the values of one time point per column, as read by From
+ *          File blocks. dType must be SS_DOUBLE.
+ *        - a raw binary file of consecutive time points in native byte
+ *          order, each a real_T time followed by width values of data type
+ *          dType. The stream ends at the end of the file.
+ *
+ *      dType            = built-in data type of the inport (real only)
+ *      width            = number of elements of the inport
+ *      windowPoints     = number of time points in a window, or 0 for
+ *                         RT_INPORT_STREAM_WINDOW
+ *
+ * Returns:
+ *	NULL    : success
+ *      non-NULL: error message
+ */
+const char *rt_RapidOpenInportStream(const char *fileName,
+                                     int dType,
+                                     int_T width,
+                                     int windowPoints,
+                                     rtInportStream *inportStream)
+{
+    static char errmsg[1024];
+    FILE        *fp = NULL;
+    char        magic[6];
+    int         nrows, ncols;
+    size_t      dataOffset = 0;
+    size_t      ptBytes;
+    int_T       w;
+
+    errmsg[0] = '\0'; /* assume success */
+
+    (void)memset(inportStream, 0, sizeof(rtInportStream));
+    inportStream->fileName  = fileName;
+    inportStream->dType     = dType;
+    inportStream->width     = width;
+    inportStream->numPoints = -1;
+
+    inportStream->elSize    = InportStreamElementSize(dType);
+    inportStream->interpFcn = rt_GetInterpolateDatatypeFcn(dType);
+    if (inportStream->elSize == 0 || width <= 0) {
+        (void)sprintf(errmsg, "Inport data file %s: only real inports of a "
+                      "built-in data type can be streamed", fileName);
+        goto EXIT_POINT;
+    }
+    ptBytes                  = inportStream->elSize * (size_t)width;
+    inportStream->recordSize = sizeof(real_T) + ptBytes;
+
+    if ((fp = fopen(fileName, "rb")) == NULL) {
+        (void)sprintf(errmsg, "Could not open inport data file %s", fileName);
+        goto EXIT_POINT;
+    }
+    inportStream->fp = fp;
+
+    /* Level 5 MAT-files start with a text header, raw files with a time */
+    if (fread(magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+        memcmp(magic, "MATLAB", sizeof(magic)) == 0) {
+        rewind(fp);
+        if (!LocateFromFileStreamData(fp, &nrows, &ncols, &dataOffset) ||
+            dType != SS_DOUBLE || nrows != width + 1) {
+            (void)sprintf(errmsg, "Inport data file %s must hold a real double "
+                          "matrix with %d rows in an uncompressed (-v6) "
+                          "MAT-file to be streamed", fileName, (int)width + 1);
+            goto EXIT_POINT;
+        }
+        inportStream->numPoints = ncols;
+    }
+    if (SeekFromFileStream(fp, dataOffset) != 0) {
+        (void)sprintf(errmsg, "Could not read inport data file %s", fileName);
+        goto EXIT_POINT;
+    }
+
+    if (windowPoints <= 0) windowPoints = RT_INPORT_STREAM_WINDOW;
+    if (windowPoints < 2)  windowPoints = 2;
+    inportStream->windowCapacity = windowPoints;
+
+    inportStream->staging = (char *)malloc((size_t)windowPoints *
+                                           inportStream->recordSize);
+    if (inportStream->staging == NULL) {
+        (void)sprintf(errmsg, "Memory allocation error");
+        goto EXIT_POINT;
+    }
+    for (w = 0; w < 2; w++) {
+        inportStream->time[w] = (real_T *)malloc((size_t)windowPoints *
+                                                 sizeof(real_T));
+        inportStream->data[w] = (char *)malloc((size_t)windowPoints * ptBytes);
+        if (inportStream->time[w] == NULL || inportStream->data[w] == NULL) {
+            (void)sprintf(errmsg, "Memory allocation error");
+            goto EXIT_POINT;
+        }
+    }
+
+    /* The first window is needed right away */
+    FillInportStreamWindow(inportStream, 0);
+
+#ifdef RT_RAPID_USE_THREADS
+    if (!inportStream->isLastWindow[0]) {
+        InportStreamReader *reader =
+            (InportStreamReader *)calloc(1, sizeof(InportStreamReader));
+
+        if (reader != NULL) {
+            (void)pthread_mutex_init(&reader->mutex, NULL);
+            (void)pthread_cond_init(&reader->cond, NULL);
+            reader->fillRequested = 1;
+            inportStream->reader  = reader;
+            if (pthread_create(&reader->thread, NULL,
+                               InportStreamReaderMain, inportStream) != 0) {
+                /* Read the windows in rt_RapidInportStreamOutput instead */
+                (void)pthread_cond_destroy(&reader->cond);
+                (void)pthread_mutex_destroy(&reader->mutex);
+                free(reader);
+                inportStream->reader = NULL;
+            }
+        }
+    }
+#endif
+
+EXIT_POINT:
+
+    if (errmsg[0] != '\0') {
+        rt_RapidCloseInportStream(inportStream);
+        return errmsg;
+    }
+    return NULL;
+
+} /* end rt_RapidOpenInportStream */
+
+
+/* Function: rt_RapidInportStreamOutput =======================================
+ * Abstract:
+ *      Compute the value of a streaming inport at time t into y, like
+ *      rt_getTimeIdx and rt_Interpolate_Datatype do for an inport loaded
+ *      into a TU table: linear interpolation (and extrapolation past the
+ *      ends) if interp is true, the last time point not after t otherwise,
+ *      and 0 outside the data when interp is false.
+ *
+ *      Time must not decrease by more than one window, since the previous
+ *      window is reused for reading once the simulation moves past it.
+ */
+void rt_RapidInportStreamOutput(rtInportStream *inportStream,
+                                real_T t,
+                                boolean_T interp,
+                                void *y)
+{
+    size_t ptBytes = inportStream->elSize * (size_t)inportStream->width;
+    int_T  w       = inportStream->current;
+    int_T  n, idx;
+    char   *data;
+
+    /* Move on once t reaches the last time point, the first of the next window */
+    while (!inportStream->isLastWindow[w] &&
+           t >= inportStream->time[w][inportStream->windowLength[w]-1]) {
+        AdvanceInportStream(inportStream);
+        w = inportStream->current;
+    }
+
+    /*
+     * A last window holding only the last time point of the previous one
+     * cannot extrapolate; the previous window is intact, since nothing is
+     * read after the last window.
+     */
+    if (inportStream->isLastWindow[w] && inportStream->windowLength[w] == 1 &&
+        inportStream->windowIndex > 0) {
+        w = 1 - w;
+    }
+
+    n = inportStream->windowLength[w];
+    if (n == 0) {
+        (void)memset(y, 0, ptBytes);
+        return;
+    }
+
+    idx = rt_getTimeIdx(inportStream->time[w], t, n,
+                        inportStream->currTimeIdx, interp, false);
+    if (idx == -7) {
+        if (inportStream->windowIndex > 0 && t < inportStream->time[w][0]) {
+            /* Before the window, but after the start of the data */
+            idx = 0;
+        } else {
+            (void)memset(y, 0, ptBytes);
+            return;
+        }
+    }
+    inportStream->currTimeIdx = idx;
+
+    data = inportStream->data[w] + (size_t)idx*ptBytes;
+    if (interp && n > 1) {
+        inportStream->interpFcn(data, data + ptBytes, inportStream->elSize,
+                                y, t,
+                                inportStream->time[w][idx],
+                                inportStream->time[w][idx+1],
+                                inportStream->width);
+    } else {
+        (void)memcpy(y, data, ptBytes);
+    }
+
+} /* end rt_RapidInportStreamOutput */
+
+
+/* Function: rt_RapidCloseInportStream ========================================
+ * Abstract:
+ *      Stop the background reader and release the file and windows of a
+ *      streaming inport.
+ */
+void rt_RapidCloseInportStream(rtInportStream *inportStream)
+{
+    int_T w;
+
+#ifdef RT_RAPID_USE_THREADS
+    InportStreamReader *reader = (InportStreamReader *)inportStream->reader;
+
+    if (reader != NULL) {
+        (void)pthread_mutex_lock(&reader->mutex);
+        reader->shutdown = 1;
+        (void)pthread_cond_broadcast(&reader->cond);
+        (void)pthread_mutex_unlock(&reader->mutex);
+        (void)pthread_join(reader->thread, NULL);
+        (void)pthread_cond_destroy(&reader->cond);
+        (void)pthread_mutex_destroy(&reader->mutex);
+        free(reader);
+        inportStream->reader = NULL;
+    }
+#endif
+    if (inportStream->fp != NULL) {
+        (void)fclose((FILE *)inportStream->fp);
+        inportStream->fp = NULL;
+    }
+    for (w = 0; w < 2; w++) {
+        free(inportStream->time[w]);
+        free(inportStream->data[w]);
+        inportStream->time[w]         = NULL;
+        inportStream->data[w]         = NULL;
+        inportStream->windowLength[w] = 0;
+    }
+    free(inportStream->staging);
+    inportStream->staging = NULL;
+
+} /* end rt_RapidCloseInportStream */
+
+
 /* Function: rt_RapidReadInportsMatFile ============================================
  *
  * Abstract:
@@ -1467,6 +2354,8 @@ const char *rt_RapidReadInportsMatFile(const char* inportFileName, int* matFileF
     bool          externalInputIsInDatasetFormat = false;
    
     errmsg[0] = '\0'; /* assume success */
+
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_INPORT_LOAD);
     
     /* no root inports return */
     if (gblNumRootInportBlks == 0){
@@ -1524,6 +2413,8 @@ const char *rt_RapidReadInportsMatFile(const char* inportFileName, int* matFileF
 
 EXIT_POINT:
 
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_INPORT_LOAD);
+
     if (errmsg[0] != '\0') {
         gblInportFileName = NULL;
         return errmsg;
@@ -1533,10 +2424,213 @@ EXIT_POINT:
 } /* end rt_RapidReadInportsMatFile */
 
 
+/*
+ * Interpolation kernels, one per built-in data type. Each kernel computes the
+ * interpolation weights once and then loops over the whole signal. The
+ * elements of one time point are stride bytes apart in x1 and x2 (the size of
+ * an element for contiguous data, such as a streamed inport, or the size of a
+ * column for a TU table, which stores each element's time points
+ * contiguously); yout is contiguous. The contiguous loop is kept separate so
+ * that the compiler can unroll and vectorize it.
+ */
+
+#define INTERP_FLOAT_ELEMENT(T, y, u1, u2)                              \
+    (y) = (T) Interpolate((u1), (u2), f1, f2)
+
+#define INTERP_INT_ELEMENT(T, y, u1, u2, maxVal, minVal)                \
+    out = Interpolate((u1), (u2), f1, f2);                              \
+    if (out >= (maxVal)) {                                              \
+        (y) = (maxVal);                                                 \
+    } else if (out <= (minVal)) {                                       \
+        (y) = (minVal);                                                 \
+    } else {                                                            \
+        (y) = (T)InterpRound(out);                                      \
+    }
+
+#define DEFINE_INTERP_FLOAT_KERNEL(name, T)                             \
+static void name(const void *x1, const void *x2, size_t stride,         \
+                 void *yout, real_T t, real_T t1, real_T t2,            \
+                 int_T width)                                           \
+{                                                                       \
+    T       *y  = (T *)yout;                                            \
+    real_T  f1  = (t2 - t) / (t2 - t1);                                 \
+    real_T  f2  = 1.0 - f1;                                             \
+    int_T   i;                                                          \
+    if (stride == sizeof(T)) {                                          \
+        const T *u1 = (const T *)x1;                                    \
+        const T *u2 = (const T *)x2;                                    \
+        for (i = 0; i < width; i++) {                                   \
+            INTERP_FLOAT_ELEMENT(T, y[i], u1[i], u2[i]);                \
+        }                                                               \
+    } else {                                                            \
+        const char *p1 = (const char *)x1;                              \
+        const char *p2 = (const char *)x2;                              \
+        for (i = 0; i < width; i++, p1 += stride, p2 += stride) {       \
+            INTERP_FLOAT_ELEMENT(T, y[i], *(const T *)p1,               \
+                                 *(const T *)p2);                       \
+        }                                                               \
+    }                                                                   \
+}
+
+#define DEFINE_INTERP_INT_KERNEL(name, T, maxVal, minVal)               \
+static void name(const void *x1, const void *x2, size_t stride,         \
+                 void *yout, real_T t, real_T t1, real_T t2,            \
+                 int_T width)                                           \
+{                                                                       \
+    T       *y  = (T *)yout;                                            \
+    real_T  f1  = (t2 - t) / (t2 - t1);                                 \
+    real_T  f2  = 1.0 - f1;                                             \
+    real_T  out;                                                        \
+    int_T   i;                                                          \
+    if (stride == sizeof(T)) {                                          \
+        const T *u1 = (const T *)x1;                                    \
+        const T *u2 = (const T *)x2;                                    \
+        for (i = 0; i < width; i++) {                                   \
+            INTERP_INT_ELEMENT(T, y[i], u1[i], u2[i], maxVal, minVal);  \
+        }                                                               \
+    } else {                                                            \
+        const char *p1 = (const char *)x1;                              \
+        const char *p2 = (const char *)x2;                              \
+        for (i = 0; i < width; i++, p1 += stride, p2 += stride) {       \
+            INTERP_INT_ELEMENT(T, y[i], *(const T *)p1,                 \
+                               *(const T *)p2, maxVal, minVal);         \
+        }                                                               \
+    }                                                                   \
+}
+
+DEFINE_INTERP_FLOAT_KERNEL(rt_InterpolateKernel_real_T,   real_T)
+DEFINE_INTERP_FLOAT_KERNEL(rt_InterpolateKernel_real32_T, real32_T)
+DEFINE_INTERP_INT_KERNEL(rt_InterpolateKernel_int8_T,   int8_T,   MAX_int8_T,   MIN_int8_T)
+DEFINE_INTERP_INT_KERNEL(rt_InterpolateKernel_uint8_T,  uint8_T,  MAX_uint8_T,  MIN_uint8_T)
+DEFINE_INTERP_INT_KERNEL(rt_InterpolateKernel_int16_T,  int16_T,  MAX_int16_T,  MIN_int16_T)
+DEFINE_INTERP_INT_KERNEL(rt_InterpolateKernel_uint16_T, uint16_T, MAX_uint16_T, MIN_uint16_T)
+DEFINE_INTERP_INT_KERNEL(rt_InterpolateKernel_int32_T,  int32_T,  MAX_int32_T,  MIN_int32_T)
+DEFINE_INTERP_INT_KERNEL(rt_InterpolateKernel_uint32_T, uint32_T, MAX_uint32_T, MIN_uint32_T)
+
+#undef DEFINE_INTERP_FLOAT_KERNEL
+#undef DEFINE_INTERP_INT_KERNEL
+#undef INTERP_FLOAT_ELEMENT
+#undef INTERP_INT_ELEMENT
+
+/*
+ * For Boolean interpolation amounts to choosing the point that is closest in
+ * time, which is the same choice for every element of the signal.
+ */
+static void rt_InterpolateKernel_boolean_T(const void *x1, const void *x2,
+                                           size_t stride, void *yout,
+                                           real_T t, real_T t1, real_T t2,
+                                           int_T width)
+{
+    const char *src = (const char *)((fabs(t-t1) < fabs(t-t2)) ? x1 : x2);
+    boolean_T  *y   = (boolean_T *)yout;
+    int_T      i;
+
+    if (stride == sizeof(boolean_T)) {
+        (void)memcpy(yout, src, width*sizeof(boolean_T));
+    } else {
+        for (i = 0; i < width; i++, src += stride) {
+            y[i] = *(const boolean_T *)src;
+        }
+    }
+}
+
+
+/* Function:  rt_GetInterpolateDatatypeFcn ==========================
+ * Abstract:
+ *      Returns the interpolation kernel for the specified built-in data
+ *      type, or NULL if the data type cannot be interpolated. Fixed-point
+ *      signals use the kernel of their storage container type, see
+ *      rt_GetInterpolateStorageDTypeId. Call once per signal when the
+ *      signal is loaded and keep the kernel with the signal.
+ */
+rt_InterpolateDatatypeFcn rt_GetInterpolateDatatypeFcn(int outputDType)
+{
+    switch(outputDType){
+      case SS_DOUBLE:  return rt_InterpolateKernel_real_T;
+      case SS_SINGLE:  return rt_InterpolateKernel_real32_T;
+      case SS_INT8:    return rt_InterpolateKernel_int8_T;
+      case SS_UINT8:   return rt_InterpolateKernel_uint8_T;
+      case SS_INT16:   return rt_InterpolateKernel_int16_T;
+      case SS_UINT16:  return rt_InterpolateKernel_uint16_T;
+      case SS_INT32:   return rt_InterpolateKernel_int32_T;
+      case SS_UINT32:  return rt_InterpolateKernel_uint32_T;
+      case SS_BOOLEAN: return rt_InterpolateKernel_boolean_T;
+      default:         return NULL;
+    }
+} /* end rt_GetInterpolateDatatypeFcn */
+
+
+/* Function:  rt_GetInterpolateStorageDTypeId =======================
+ * Abstract:
+ *      Returns the built-in data type whose kernel interpolates a signal of
+ *      data type dTypeID loaded from a MAT-file variable of class
+ *      storageClass. Built-in data types map to themselves. Fixed-point
+ *      (and other non built-in) signals are loaded as their stored
+ *      integers, so they map to the integer type of that class. Returns -1
+ *      if there is no such type.
+ */
+int rt_GetInterpolateStorageDTypeId(int dTypeID, mxClassID storageClass)
+{
+    if (dTypeID >= 0 && dTypeID < SS_NUM_BUILT_IN_DTYPE) {
+        return dTypeID;
+    }
+
+    switch (storageClass) {
+      case mxINT8_CLASS:   return SS_INT8;
+      case mxUINT8_CLASS:  return SS_UINT8;
+      case mxINT16_CLASS:  return SS_INT16;
+      case mxUINT16_CLASS: return SS_UINT16;
+      case mxINT32_CLASS:  return SS_INT32;
+      case mxUINT32_CLASS: return SS_UINT32;
+      default:             return -1;
+    }
+} /* end rt_GetInterpolateStorageDTypeId */
+
+
+/* Function:  rt_RapidInterpolateInportTUtable =======================
+ * Abstract:
+ *      Interpolates all elements of an inport loaded into a TU table between
+ *      time points timeIdx and timeIdx+1, using the kernel selected when the
+ *      inport was loaded. yr and yi receive the real and (for complex
+ *      inports) imaginary parts. Returns false, without writing the outputs,
+ *      if the inport has no kernel; the caller then interpolates element by
+ *      element with rt_Interpolate_Datatype.
+ */
+boolean_T rt_RapidInterpolateInportTUtable(const rtInportTUtable *inportTUtable,
+                                           int_T width,
+                                           int_T timeIdx,
+                                           real_T t,
+                                           void *yr,
+                                           void *yi)
+{
+    size_t offset = (size_t)timeIdx * inportTUtable->elSize;
+    size_t stride = (size_t)inportTUtable->nTimePoints * inportTUtable->elSize;
+    real_T t1     = inportTUtable->time[timeIdx];
+    real_T t2     = inportTUtable->time[timeIdx+1];
+    const char *ur = (const char *)inportTUtable->ur + offset;
+
+    if (inportTUtable->interpFcn == NULL) {
+        return false;
+    }
+
+    inportTUtable->interpFcn(ur, ur + inportTUtable->elSize, stride,
+                             yr, t, t1, t2, width);
+    if (inportTUtable->complex && yi != NULL) {
+        const char *ui = (const char *)inportTUtable->ui + offset;
+        inportTUtable->interpFcn(ui, ui + inportTUtable->elSize, stride,
+                                 yi, t, t1, t2, width);
+    }
+    return true;
+
+} /* end rt_RapidInterpolateInportTUtable */
+
+
 /* Function:  Interpolate_Datatype================================
  * Abstract:
  *      Performs Lagrange interpolation on a pair of data values of
- *      specified data type.
+ *      specified data type, with the kernel of that data type (see
+ *      rt_GetInterpolateDatatypeFcn). Callers that interpolate a whole
+ *      signal should select the kernel once and call it for all elements.
  *
  */
 
@@ -1544,110 +2638,11 @@ void rt_Interpolate_Datatype(void   *x1, void   *x2, void   *yout,
     				    real_T t,   real_T t1,  real_T t2,
                                     int    outputDType)
 {
-    real_T  out;
-    real_T  f1 = (t2 - t) / (t2 - t1);
-    real_T  f2 = 1.0 - f1;
-
-    switch(outputDType){
+    rt_InterpolateDatatypeFcn interpFcn = rt_GetInterpolateDatatypeFcn(outputDType);
 
-      case SS_DOUBLE:
-  	  out = Interpolate(*(real_T *)x1, *(real_T *)x2, f1, f2);
-          *(real_T *) yout = out;
-          break;
-
-      case SS_SINGLE:
-          out = Interpolate(*(real32_T *)x1, *(real32_T *)x2, f1, f2);
-          *(real32_T *) yout = (real32_T) out;
-          break;
-
-      case SS_INT8:
-          out = Interpolate(*(int8_T *)x1,*(int8_T *)x2, f1, f2);
-
-          if (out >= MAX_int8_T) {
-	      *(int8_T *)yout = MAX_int8_T;
-	  } else if (out <= MIN_int8_T) {
-	      *(int8_T *)yout = MIN_int8_T;
-	  } else {
-	      *(int8_T *)yout = (int8_T)InterpRound(out);
-	  }
-          break;
-
-      case SS_UINT8:
-
-          out = Interpolate(*(uint8_T *)x1,*(uint8_T *)x2, f1, f2);
-
-	  if (out >= MAX_uint8_T) {
-	      *(uint8_T *)yout = MAX_uint8_T;
-	  } else if (out <= MIN_uint8_T) {
-	      *(uint8_T *)yout = MIN_uint8_T;
-	  } else {
-	      *(uint8_T *)yout = (uint8_T)InterpRound(out);
-	  }
-
-          break;
-
-      case SS_INT16:
-          out = Interpolate(*(int16_T *)x1,*(int16_T *)x2, f1, f2);
-
-          if (out >= MAX_int16_T) {
-	      *(int16_T *)yout = MAX_int16_T;
-	  } else if (out <= MIN_int16_T) {
-	      *(int16_T *)yout = MIN_int16_T;
-	  } else {
-	      *(int16_T *)yout = (int16_T)InterpRound(out);
-	  }
-          break;
-
-      case SS_UINT16:
-          out = Interpolate(*(uint16_T *)x1,*(uint16_T *)x2, f1, f2);
-
-	  if (out >= MAX_uint16_T) {
-	      *(uint16_T *)yout = MAX_uint16_T;
-	  } else if (out <= MIN_uint16_T) {
-	      *(uint16_T *)yout = MIN_uint16_T;
-	  } else {
-	      *(uint16_T *)yout = (uint16_T)InterpRound(out);
-	  }
-
-          break;
-
-      case SS_INT32:
-          out = Interpolate(*(int32_T *)x1,*(int32_T *)x2, f1, f2);
-
-          if (out >= MAX_int32_T) {
-	      *(int32_T *)yout = MAX_int32_T;
-	  } else if (out <= MIN_int32_T) {
-	      *(int32_T *)yout = MIN_int32_T;
-	  } else {
-	      *(int32_T *)yout = (int32_T)InterpRound(out);
-	  }
-
-          break;
-
-      case SS_UINT32:
-          out = Interpolate(*(uint32_T *)x1,*(uint32_T *)x2, f1, f2);
-
-	  if (out >= MAX_uint32_T) {
-	      *(uint32_T *)yout = MAX_uint32_T;
-	  } else if (out <= MIN_uint32_T) {
-	      *(uint32_T *)yout = MIN_uint32_T;
-	  } else {
-	      *(uint32_T *)yout = (uint32_T)InterpRound(out);
-	  }
-
-          break;
-
-      case SS_BOOLEAN:
-          /*
-           * For Boolean interpolation amounts to choosing the point that
-           * is closest in time.
-           */
-          *(boolean_T *) yout = (fabs(t-t1) < fabs(t-t2)) ? (*(boolean_T *)x1) :
-                                                            (*(boolean_T *)x2);
-          break;
-
-      default:  
-          break;
+    if (interpFcn != NULL) {
+        /* One element: the stride is never applied */
+        interpFcn(x1, x2, 0, yout, t, t1, t2, 1);
     }
 }    /* end rt_Interpolate_Datatype */
 
@@ -1665,6 +2660,80 @@ int_T rt_isTimeHit(real_T t, real_T timePoint) {
         return false;
 }
 
+/* Function:  rt_searchTimeIdx ==============================
+ * Abstract:
+ *      Given a monotonically increasing time array with
+ *      timePtr[lo] <= t < timePtr[hi], narrow the bracket down to
+ *      hi == lo+1 by binary search, and return lo.
+ */
+static int_T rt_searchTimeIdx(const real_T *timePtr, real_T t, int_T lo, int_T hi)
+{
+    int_T mid;
+
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo)/2;
+        if (t >= timePtr[mid]) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Function:  rt_findTimeIdx ================================
+ * Abstract:
+ *      Given a monotonically increasing time array with
+ *      timePtr[0] <= t < timePtr[numTimePoints-1], return the last
+ *      index currTimeIdx with timePtr[currTimeIdx] <= t.
+ *
+ *      The previous index is checked first, as is the next time
+ *      interval, so that stepping through the time array costs O(1).
+ *      Otherwise the search starts at the index t would have in a
+ *      uniformly sampled time array (exact for uniform sampling) and
+ *      gallops towards t, so that a jump of d points costs O(log d).
+ */
+static int_T rt_findTimeIdx(const real_T *timePtr, real_T t, 
+                            int_T numTimePoints, int_T preTimeIdx)
+{
+    int_T lastIdx = numTimePoints - 1;
+    int_T currTimeIdx, lo, hi, step;
+
+    currTimeIdx = (preTimeIdx < 0) ? 0 : 
+        ((preTimeIdx > lastIdx - 1) ? lastIdx - 1 : preTimeIdx);
+
+    if (t >= timePtr[currTimeIdx]) {
+        if (t < timePtr[currTimeIdx + 1]) return currTimeIdx;
+        if (currTimeIdx + 2 <= lastIdx && t < timePtr[currTimeIdx + 2]) {
+            return currTimeIdx + 1;
+        }
+    }
+
+    /* Start at the uniform sampling estimate */
+    currTimeIdx = (int_T)((t - timePtr[0]) / (timePtr[lastIdx] - timePtr[0]) * lastIdx);
+    if (currTimeIdx < 0) currTimeIdx = 0;
+    if (currTimeIdx > lastIdx - 1) currTimeIdx = lastIdx - 1;
+
+    if (t >= timePtr[currTimeIdx]) {
+        /* Gallop forward; t < timePtr[lastIdx] stops the search */
+        lo = currTimeIdx;
+        hi = currTimeIdx + 1;
+        for (step = 1; t >= timePtr[hi]; step *= 2) {
+            lo = hi;
+            hi = (lastIdx - hi > step) ? hi + step : lastIdx;
+        }
+    } else {
+        /* Gallop backward; timePtr[0] <= t stops the search */
+        hi = currTimeIdx;
+        lo = currTimeIdx - 1;
+        for (step = 1; t < timePtr[lo]; step *= 2) {
+            hi = lo;
+            lo = (lo > step) ? lo - step : 0;
+        }
+    }
+    return rt_searchTimeIdx(timePtr, t, lo, hi);
+}
+
 /* Function:  rt_getTimeIdx ================================
  * Abstract:
  *      Given a time array and time, get time index so
@@ -1684,15 +2753,38 @@ int_T rt_getTimeIdx(real_T *timePtr, real_T t, int_T numTimePoints,
     int_T currTimeIdx= preTimeIdx;
 
     if(timeHitOnly) {
+        /* Find the first time point at or after currTimeIdx that is not
+         * more than eps before t. It is the first time hit if there is
+         * one, since later time points are further away from t.
+         */
+        real_T eps = rapid_eps(t);
+        int_T  lo, hi, step;
+
         if(currTimeIdx == -7) currTimeIdx= 0;
-        while(currTimeIdx < numTimePoints) {
-            if(rt_isTimeHit(t, timePtr[currTimeIdx])) {
-                    return currTimeIdx;
+        if(currTimeIdx < 0 || currTimeIdx >= numTimePoints) return -7;
+
+        if ((t - timePtr[currTimeIdx]) > eps) {
+            /* Gallop forward from the previous index */
+            lo = currTimeIdx;
+            hi = currTimeIdx + 1;
+            for (step = 1; hi < numTimePoints && (t - timePtr[hi]) > eps; step *= 2) {
+                lo = hi;
+                hi = (numTimePoints - hi > step) ? hi + step : numTimePoints;
             }
-            currTimeIdx++;
+            /* (t - timePtr[lo]) > eps, and hi is numTimePoints or not */
+            while (hi - lo > 1) {
+                int_T mid = lo + (hi - lo)/2;
+                if ((t - timePtr[mid]) > eps) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (hi == numTimePoints) return -7;
+            currTimeIdx = hi;
         }
 
-        return -7;
+        return rt_isTimeHit(t, timePtr[currTimeIdx]) ? currTimeIdx : -7;
 
     }
     
@@ -1737,17 +2829,9 @@ int_T rt_getTimeIdx(real_T *timePtr, real_T t, int_T numTimePoints,
          * timestep.
          */
         if(currTimeIdx == -7) currTimeIdx= 0;
-        if (t < timePtr[currTimeIdx]) {
-            /* dead code? */
-            while (t < timePtr[currTimeIdx]) {
-                currTimeIdx--;
-            }
-        } else {
-            /* Keep incrementing the current time index while current time t
-               is greater than or equal to the next time point. */
-            while (t >= timePtr[currTimeIdx + 1]) {
-                currTimeIdx++;
-            }
+        /* Last time point not after t (a NaN t keeps the previous index) */
+        if (t == t) {
+            currTimeIdx = rt_findTimeIdx(timePtr, t, numTimePoints, currTimeIdx);
         }
     }
     return currTimeIdx;
@@ -1853,6 +2937,272 @@ const char *rt_RapidCheckRemappings(void)
 
 } /* end rt_RapidCheckRemappings */
 
+
+/* Function: rt_RapidRunParamSweep ============================================
+ * Abstract:
+ *      Run one simulation for each parameter set firstCellIndex, ...,
+ *      firstCellIndex+numCells-1 of the parameter MAT-file (-p switch).
+ *
+ *      Call this once the model is initialized. The parameter MAT-file is
+ *      read and parsed once, in the calling process, for all runs. Each run
+ *      is a forked worker that shares the initialized model and the parsed
+ *      parameter sets copy-on-write, sets gblParamCellIndex, installs its
+ *      parameter set in rtP with rt_RapidUpdateParamsFromSweep and then
+ *      calls runFcn to simulate to completion. The worker exit status is
+ *      the return value of runFcn, or 1 if the SimStruct has an error
+ *      status. Up to maxWorkers runs are active at a time; if maxWorkers is
+ *      not positive, one worker per online processor is used. Only the
+ *      workers started here are waited for, so other child processes of the
+ *      caller are left alone.
+ *
+ *      The parent process does not simulate and its model state is left
+ *      unchanged. runFcn is responsible for giving each run its own output
+ *      files, e.g., from the parameter cell index.
+ *
+ * Returns:
+ *	NULL     - all runs succeeded
+ *	non-NULL - error message
+ */
+const char *rt_RapidRunParamSweep(SimStruct           *S,
+                                  int_T               firstCellIndex,
+                                  int_T               numCells,
+                                  int_T               maxWorkers,
+                                  rt_RapidSweepRunFcn runFcn)
+{
+#ifdef RT_RAPID_USE_FORK
+    static char errmsg[1024];
+    const char  *result     = NULL;
+    int_T       nextCell    = 0;
+    int_T       numActive   = 0;
+    int_T       numFailed   = 0;
+    int_T       forkFailed  = 0;
+    pid_t       *workerPids = NULL;  /* active workers, oldest first */
+    int_T       i;
+
+    if (gblParamFilename == NULL) {
+        result = "a parameter sweep requires a parameter MAT-file (-p switch)";
+        goto EXIT_POINT;
+    }
+
+    if (maxWorkers <= 0) {
+        long nProcs = sysconf(_SC_NPROCESSORS_ONLN);
+        maxWorkers = (nProcs > 0) ? (int_T)nProcs : 1;
+    }
+    if (maxWorkers > numCells && numCells > 0) {
+        maxWorkers = numCells;
+    }
+
+    workerPids = (pid_t *)calloc(maxWorkers, sizeof(pid_t));
+    if (workerPids == NULL) {
+        result = "memory allocation error";
+        goto EXIT_POINT;
+    }
+
+    /* Parse the parameter MAT-file once; the workers only install their set */
+    result = rt_RapidReadParamSweepMatFile(S, firstCellIndex, numCells);
+    if (result != NULL) {
+        goto EXIT_POINT;
+    }
+
+    while (nextCell < numCells || numActive > 0) {
+        if (nextCell < numCells && numActive < maxWorkers && !forkFailed) {
+            pid_t pid;
+
+            /* Do not let the workers repeat the parent's buffered output */
+            (void)fflush(NULL);
+
+            pid = fork();
+            if (pid == 0) {
+                int exitStatus;
+
+                gblParamCellIndex = firstCellIndex + nextCell;
+                rt_RapidUpdateParamsFromSweep(S, gblParamCellIndex);
+                if (ssGetErrorStatus(S) != NULL) {
+                    (void)fprintf(stderr, "Parameter set %d: %s\n",
+                                  (int)gblParamCellIndex, ssGetErrorStatus(S));
+                    (void)fflush(NULL);
+                    _exit(1);
+                }
+
+                exitStatus = runFcn(S, gblParamCellIndex);
+                if (exitStatus == 0 && ssGetErrorStatus(S) != NULL) {
+                    exitStatus = 1;
+                }
+                (void)fflush(NULL);
+                _exit(exitStatus);
+            } else if (pid < 0) {
+                /* Let the active workers finish, then report the failure */
+                forkFailed = 1;
+                numFailed += numCells - nextCell;
+                nextCell = numCells;
+            } else {
+                workerPids[numActive++] = pid;
+                nextCell++;
+            }
+        } else {
+            int   status = 0;
+            pid_t pid    = 0;
+            int_T k;
+
+            /* Reap a finished worker if there is one, else wait for the oldest */
+            for (k = 0; k < numActive; k++) {
+                pid = waitpid(workerPids[k], &status, WNOHANG);
+                if (pid != 0) break;
+            }
+            if (k == numActive) {
+                k   = 0;
+                pid = waitpid(workerPids[0], &status, 0);
+                if (pid < 0 && errno == EINTR) continue;
+            }
+
+            /* Remove the worker, keeping the others oldest first */
+            numActive--;
+            for (i = k; i < numActive; i++) {
+                workerPids[i] = workerPids[i+1];
+            }
+            if (pid < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                numFailed++;
+            }
+        }
+    }
+
+    if (numFailed > 0) {
+        (void)sprintf(errmsg, "%d of %d parameter sweep runs failed%s",
+                      (int)numFailed, (int)numCells,
+                      forkFailed ? " (unable to create worker process)" : "");
+        result = errmsg;
+    }
+
+  EXIT_POINT:
+    rt_RapidFreeParamSweep();
+    free(workerPids);
+    return(result);
+#else
+    (void)S;
+    (void)firstCellIndex;
+    (void)numCells;
+    (void)maxWorkers;
+    (void)runFcn;
+    return("parameter sweeps are not supported on this platform");
+#endif
+} /* end rt_RapidRunParamSweep */
+
+
+/*
+ * Accumulated wall-clock time of each startup phase. A phase may be entered
+ * several times, e.g., once per S-function, and only the outermost
+ * Begin/End pair of nested calls is timed.
+ */
+static struct {
+    real_T seconds;
+    real_T start;
+    int_T  count;
+    int_T  depth;
+} gblStartupProfile[RT_RAPID_NUM_STARTUP_PHASES];
+
+static const char *gblStartupPhaseNames[RT_RAPID_NUM_STARTUP_PHASES] = {
+    "mexLoad",
+    "paramLoad",
+    "inportLoad",
+    "modelInit"
+};
+
+static const char *gblStartupPhaseDescriptions[RT_RAPID_NUM_STARTUP_PHASES] = {
+    "S-function MEX loading",
+    "Parameter load",
+    "Inport load",
+    "Model initialization"
+};
+
+/* Function: rt_RapidStartupClock =============================================
+ * Abstract:
+ *      Wall-clock time in seconds from an arbitrary origin. clock() is
+ *      wall-clock time with the Windows C runtime.
+ */
+static real_T rt_RapidStartupClock(void)
+{
+#ifdef RT_RAPID_USE_MONOTONIC_CLOCK
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+        return((real_T)ts.tv_sec + 1.0e-9*(real_T)ts.tv_nsec);
+    }
+#endif
+    return((real_T)clock()/(real_T)CLOCKS_PER_SEC);
+} /* end rt_RapidStartupClock */
+
+
+/* Function: rt_RapidStartupPhaseBegin ========================================
+ * Abstract:
+ *      Start timing one pass through a startup phase.
+ */
+void rt_RapidStartupPhaseBegin(rt_RapidStartupPhase phase)
+{
+    if (gblStartupProfile[phase].depth++ == 0) {
+        gblStartupProfile[phase].start = rt_RapidStartupClock();
+    }
+} /* end rt_RapidStartupPhaseBegin */
+
+
+/* Function: rt_RapidStartupPhaseEnd ==========================================
+ * Abstract:
+ *      Stop timing a startup phase started by rt_RapidStartupPhaseBegin.
+ */
+void rt_RapidStartupPhaseEnd(rt_RapidStartupPhase phase)
+{
+    if (gblStartupProfile[phase].depth > 0 &&
+        --gblStartupProfile[phase].depth == 0) {
+        gblStartupProfile[phase].seconds +=
+            rt_RapidStartupClock() - gblStartupProfile[phase].start;
+        gblStartupProfile[phase].count++;
+    }
+} /* end rt_RapidStartupPhaseEnd */
+
+
+/* Function: rt_RapidWriteStartupProfile ======================================
+ * Abstract:
+ *      Report the time spent in each startup phase. If fileName is NULL the
+ *      profile is printed, otherwise it is written to fileName as JSON:
+ *
+ *        {"phases": [{"name": "mexLoad", "seconds": 1.25, "count": 212},
+ *                    ...]}
+ *
+ *      Phases overlap where they nest, e.g., S-functions are loaded during
+ *      model initialization, so the times need not add up.
+ *
+ * Returns:
+ *	NULL     - success
+ *	non-NULL - error message
+ */
+const char *rt_RapidWriteStartupProfile(const char *fileName)
+{
+    FILE *fp;
+    int_T i;
+
+    if (fileName == NULL) {
+        printf("\n ** Startup profile **\n");
+        for (i = 0; i < RT_RAPID_NUM_STARTUP_PHASES; i++) {
+            printf("    %-24s %10.6f s  (%d)\n", gblStartupPhaseDescriptions[i],
+                   gblStartupProfile[i].seconds, gblStartupProfile[i].count);
+        }
+        return(NULL);
+    }
+
+    if ((fp = fopen(fileName, "w")) == NULL) {
+        return("unable to open startup profile file");
+    }
+    fprintf(fp, "{\"phases\": [");
+    for (i = 0; i < RT_RAPID_NUM_STARTUP_PHASES; i++) {
+        fprintf(fp, "%s\n  {\"name\": \"%s\", \"seconds\": %.9g, \"count\": %d}",
+                (i == 0) ? "" : ",", gblStartupPhaseNames[i],
+                gblStartupProfile[i].seconds, gblStartupProfile[i].count);
+    }
+    fprintf(fp, "\n]}\n");
+    if (fclose(fp) != 0) {
+        return("unable to write startup profile file");
+    }
+    return(NULL);
+} /* end rt_RapidWriteStartupProfile */
+
 /* Function: rt_GetISigstreamManager ============================================
  *
  * Abstract:
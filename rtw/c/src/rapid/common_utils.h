@@ -76,6 +76,70 @@ extern "C" {
 } FrFInfo;
 
 
+    /* Default look-ahead window of a From File stream, in time points */
+#ifndef RT_FRF_STREAM_WINDOW
+# define RT_FRF_STREAM_WINDOW 4096
+#endif
+
+    /* Streaming From File Info (one per from file block) */
+    typedef struct {
+    const char  *origFileName;
+    const char  *newFileName;
+    int         originalWidth;  /* rows of the TU matrix, including time  */
+    int         nptsPerSignal;  /* columns of the TU matrix               */
+    int         isStreamable;   /* 0: use rt_RapidReadFromFileBlockMatFile */
+    size_t      dataOffset;     /* byte offset of the TU data in the file */
+    void        *mapBase;       /* memory-mapped MAT-file, or NULL        */
+    size_t      mapLength;
+    size_t      releasedBytes;  /* mapped pages before this were released */
+    void        *fp;            /* FILE for buffered reads                */
+    double      *window;        /* look-ahead buffer for buffered reads   */
+    int         windowStart;    /* first time point in the window         */
+    int         windowLength;   /* number of time points in the window    */
+    int         windowCapacity; /* maximum time points in the window      */
+} FrFStream;
+
+
+    /*
+     * Interpolation kernel for a whole signal of one built-in data type: the
+     * width elements of two time points, stride bytes apart in x1 and x2,
+     * into contiguous yout. Select it once per signal with
+     * rt_GetInterpolateDatatypeFcn.
+     */
+    typedef void (*rt_InterpolateDatatypeFcn)(const void *x1, const void *x2,
+                                              size_t stride, void *yout,
+                                              real_T t, real_T t1, real_T t2,
+                                              int_T width);
+
+    /* Default window of a streaming root inport, in time points */
+#ifndef RT_INPORT_STREAM_WINDOW
+# define RT_INPORT_STREAM_WINDOW 65536
+#endif
+
+    /* Streaming root inport (one per streamed root inport) */
+    typedef struct {
+    const char  *fileName;
+    int         dType;          /* built-in data type of the inport       */
+    rt_InterpolateDatatypeFcn interpFcn; /* kernel of dType            */
+    int_T       width;          /* elements per time point                */
+    size_t      elSize;         /* bytes per element                      */
+    size_t      recordSize;     /* bytes per time point in the file       */
+    int_T       numPoints;      /* time points in the file, -1 if unknown */
+    int_T       pointsRead;     /* time points read from the file so far  */
+    void        *fp;            /* FILE positioned at the next time point */
+    char        *staging;       /* records read from the file             */
+    real_T      *time[2];       /* double-buffered windows: time points   */
+    char        *data[2];       /* and values                             */
+    int_T       windowLength[2];
+    int_T       isLastWindow[2];
+    int_T       windowCapacity; /* maximum time points in a window        */
+    int_T       current;        /* window used by the simulation          */
+    int_T       windowIndex;    /* windows used before the current one    */
+    int_T       currTimeIdx;    /* for interpolation                      */
+    void        *reader;        /* background reader, or NULL             */
+} rtInportStream;
+
+
     /* From Workspace Info (one per from workspace block) */
     typedef struct {
     const char *origWorkspaceVarName;
@@ -99,10 +163,27 @@ extern "C" {
     int     currTimeIdx;       /* for interpolation */
     bool    isPeriodicFcnCall; /* Should the TU table be interpreted as a
                                 * periodic function call specification */
+    size_t  elSize;            /* bytes per element of ur and ui      */
+    rt_InterpolateDatatypeFcn interpFcn; /* kernel, or NULL if none   */
 } rtInportTUtable;
 
 #define NUM_DATA_TYPES (9)
 
+    /* Startup phases timed by rt_RapidStartupPhaseBegin/End */
+    typedef enum {
+    RT_RAPID_STARTUP_MEX_LOAD = 0,  /* loading S-function MEX files */
+    RT_RAPID_STARTUP_PARAM_LOAD,    /* reading the -p parameter MAT-file */
+    RT_RAPID_STARTUP_INPORT_LOAD,   /* reading the -i inport MAT-file */
+    RT_RAPID_STARTUP_MODEL_INIT,    /* model registration, start and init */
+    RT_RAPID_NUM_STARTUP_PHASES
+} rt_RapidStartupPhase;
+
+    /*
+     * Runs one simulation of a parameter sweep in a worker process, see
+     * rt_RapidRunParamSweep. Returns the exit status of the worker.
+     */
+    typedef int_T (*rt_RapidSweepRunFcn)(SimStruct *S, int_T paramCellIndex);
+
 
 
     /* consult Foundation Libraries before using mxIsIntVectorWrapper G978320 */
@@ -112,6 +193,30 @@ extern "C" {
                                                         int originalWidth,
                                                         FrFInfo *frFInfo);
 
+    extern const char *rt_RapidOpenFromFileStream(const char *origFileName,
+                                                  int originalWidth,
+                                                  int windowPoints,
+                                                  FrFStream *frFStream);
+
+    extern const double *rt_RapidFromFileStreamGetPoints(FrFStream *frFStream,
+                                                         int firstPoint,
+                                                         int numPoints);
+
+    extern void rt_RapidCloseFromFileStream(FrFStream *frFStream);
+
+    extern const char *rt_RapidOpenInportStream(const char *fileName,
+                                                int dType,
+                                                int_T width,
+                                                int windowPoints,
+                                                rtInportStream *inportStream);
+
+    extern void rt_RapidInportStreamOutput(rtInportStream *inportStream,
+                                           real_T t,
+                                           boolean_T interp,
+                                           void *y);
+
+    extern void rt_RapidCloseInportStream(rtInportStream *inportStream);
+
     extern void *rt_GetISigstreamManager(void);
 
     extern void *rt_GetOSigstreamManager(void);
@@ -130,6 +235,17 @@ extern "C" {
                                         real_T t,   real_T t1,  real_T t2,
                                         int    outputDType);
 
+    extern rt_InterpolateDatatypeFcn rt_GetInterpolateDatatypeFcn(int outputDType);
+
+    extern int rt_GetInterpolateStorageDTypeId(int dTypeID, mxClassID storageClass);
+
+    extern boolean_T rt_RapidInterpolateInportTUtable(const rtInportTUtable *inportTUtable,
+                                                      int_T width,
+                                                      int_T timeIdx,
+                                                      real_T t,
+                                                      void *yr,
+                                                      void *yi);
+
     extern int_T rt_getTimeIdx(real_T *timePtr, real_T t, int_T numTimePoints, 
                                int_T preTimeIdx, boolean_T interp, boolean_T timeHitOnly);
 
@@ -137,6 +253,18 @@ extern "C" {
 
     extern const char *rt_RapidCheckRemappings(void);
 
+    extern const char *rt_RapidRunParamSweep(SimStruct           *S,
+                                             int_T               firstCellIndex,
+                                             int_T               numCells,
+                                             int_T               maxWorkers,
+                                             rt_RapidSweepRunFcn runFcn);
+
+    extern void rt_RapidStartupPhaseBegin(rt_RapidStartupPhase phase);
+
+    extern void rt_RapidStartupPhaseEnd(rt_RapidStartupPhase phase);
+
+    extern const char *rt_RapidWriteStartupProfile(const char *fileName);
+
     extern const char *rt_GetMatSigstreamLoggingFileName(void);
 
     extern const char *rt_GetMatSigLogSelectorFileName(void);
@@ -36,6 +36,7 @@
 
 #include "sfcn_loader_c_api.h"
 #include "raccel_sfcn_utils.h"
+#include "common_utils.h"
 #include "dt_info.h"
 #include "sl_datatype_access.h"
 
@@ -1130,6 +1131,8 @@ raccelInitializeForMexSFcns()
 {
     const char* errStr = NULL;
 
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_MEX_LOAD);
+
     sfcnLoader_initialize_for_rapid_accelerator(
         &gblErrorStatus,
         gblSFcnInfoFileName,
@@ -1140,6 +1143,8 @@ raccelInitializeForMexSFcns()
         &registerDataTypeFcns
         );
 
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_MEX_LOAD);
+
     if (gblErrorStatus != NULL)
     {
         return;
@@ -1158,13 +1163,20 @@ void raccelLoadSFcnMexFile(
     size_t childIdx
     )
 {
-    
+    /*
+     * The S-function is loaded and registered here, before the model
+     * registers its sizes, so loading cannot be deferred to its first
+     * method call. Time it for the startup profile instead.
+     */
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_MEX_LOAD);
+
     sfcnLoader_callSFcn(
         sFcnName,
         blockSID,
         simstruct
         );
-    
+
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_MEX_LOAD);
 }
 
 
@@ -474,6 +474,122 @@ rt_CopyStructFromStructArray(
 }
 
 
+/*
+ * Hash index over the field names of a struct mxArray. mxGetField looks a
+ * field up by comparing its name with every field of the struct, so resolving
+ * all C-API elements of a struct with mxGetField is quadratic in its number of
+ * fields. The index is built once per struct (or struct array) and resolves
+ * each element name to its field number in constant time.
+ */
+typedef struct {
+    const mxArray *structMat;
+    size_t        nBuckets;   /* power of two, at least twice the fields */
+    int           *buckets;   /* field number + 1, or 0 if empty         */
+} FieldIndex;
+
+static uint32_T rt_HashFieldName(const char *name)
+{
+    /* FNV-1a */
+    uint32_T hash = 2166136261U;
+    while (*name != '\0') {
+        hash ^= (uint32_T)(unsigned char)*name++;
+        hash *= 16777619U;
+    }
+    return(hash);
+}
+
+/* Function: rt_BuildFieldIndex ================================================
+ * Abstract:
+ *  Build the field name index of structMat, which may be NULL.
+ */
+static const char *
+rt_BuildFieldIndex(
+    const mxArray *structMat,
+    FieldIndex *fieldIndex)
+{
+    int numFields = 0;
+    int fieldNum;
+
+    fieldIndex->structMat = structMat;
+    fieldIndex->nBuckets  = 0;
+    fieldIndex->buckets   = NULL;
+
+    if (structMat == NULL || !mxIsStruct(structMat))
+        return(NULL);
+
+    numFields = mxGetNumberOfFields(structMat);
+    if (numFields == 0)
+        return(NULL);
+
+    fieldIndex->nBuckets = 4;
+    while (fieldIndex->nBuckets < 2*(size_t)numFields)
+        fieldIndex->nBuckets <<= 1;
+
+    fieldIndex->buckets = (int *) calloc(fieldIndex->nBuckets, sizeof(int));
+    if (fieldIndex->buckets == NULL)
+    {
+        fieldIndex->nBuckets = 0;
+        return("Memory allocation error");
+    }
+
+    for (fieldNum = 0; fieldNum < numFields; fieldNum++)
+    {
+        size_t bucket =
+            rt_HashFieldName(mxGetFieldNameByNumber(structMat, fieldNum)) &
+            (fieldIndex->nBuckets-1);
+        while (fieldIndex->buckets[bucket] != 0)
+            bucket = (bucket+1) & (fieldIndex->nBuckets-1);
+        fieldIndex->buckets[bucket] = fieldNum+1;
+    }
+    return(NULL);
+}
+
+/* Function: rt_LookupFieldIndex ===============================================
+ * Abstract:
+ *  Return the field number of the named field, or -1 if there is none.
+ */
+static int
+rt_LookupFieldIndex(
+    const FieldIndex *fieldIndex,
+    const char *fieldName)
+{
+    size_t bucket;
+
+    if (fieldIndex->nBuckets == 0)
+        return(-1);
+
+    bucket = rt_HashFieldName(fieldName) & (fieldIndex->nBuckets-1);
+    while (fieldIndex->buckets[bucket] != 0)
+    {
+        int fieldNum = fieldIndex->buckets[bucket]-1;
+        if (strcmp(mxGetFieldNameByNumber(fieldIndex->structMat, fieldNum),
+                   fieldName) == 0)
+            return(fieldNum);
+        bucket = (bucket+1) & (fieldIndex->nBuckets-1);
+    }
+    return(-1);
+}
+
+
+/* Function: rt_GetStructLeafInfoFromElement ===================================
+ * Abstract:
+ *  Recursive function to traverse the fields of element valueMatElementIdx of
+ *  the struct (array) valueMat, and to create a ParamInfo structure for each
+ *  leaf. Elements of struct arrays are visited in place, without copying them
+ *  to a 1x1 struct, and fields are resolved through a FieldIndex.
+ */
+static void
+rt_GetStructLeafInfoFromElement(
+    uint16_T dTypeMapIdx,
+    uint16_T fixPtIdx,
+    void *baseAddr,
+    mxArray *valueMat,
+    size_t valueMatElementIdx,
+    boolean_T modelParam,
+    PrmStructData *paramStructure,
+    size_t *paramInfoIndex,
+    const char** result);
+
 /* Function: rt_GetStructLeafInfo ================================================
  * Abstract:
  *  Recursive function to traverse the fields of a single struct parameter with
@@ -490,6 +606,30 @@ rt_GetStructLeafInfo(
     PrmStructData *paramStructure,
     size_t *paramInfoIndex,
     const char** result)
+{
+    rt_GetStructLeafInfoFromElement(
+        dTypeMapIdx,
+        fixPtIdx,
+        baseAddr,
+        valueMat,
+        0,
+        modelParam,
+        paramStructure,
+        paramInfoIndex,
+        result);
+} /* end rt_GetStructLeafInfo */
+
+static void
+rt_GetStructLeafInfoFromElement(
+    uint16_T dTypeMapIdx,
+    uint16_T fixPtIdx,
+    void *baseAddr,
+    mxArray *valueMat,
+    size_t valueMatElementIdx,
+    boolean_T modelParam,
+    PrmStructData *paramStructure,
+    size_t *paramInfoIndex,
+    const char** result)
 {
     rtwCAPI_ModelMappingInfo  *mmi =
         rt_modelMapInfoPtr;
@@ -557,6 +697,12 @@ rt_GetStructLeafInfo(
         rtwCAPI_DimensionMap const *dimMap =
             rtwCAPI_GetDimensionMap(mmi);
 
+        FieldIndex fieldIndex;
+
+        *(result) = rt_BuildFieldIndex(valueMat, &fieldIndex);
+        if (*(result) != NULL)
+            return;
+
         {
             int loopIdx;
             for (loopIdx=0;
@@ -588,11 +734,16 @@ rt_GetStructLeafInfo(
                         elemMap,
                         dTypeMapElemMapIdx+loopIdx);
                 
-                mxArray *subMat =
-                    mxGetField(
-                        valueMat,
-                        0,
+                int fieldNum =
+                    rt_LookupFieldIndex(
+                        &fieldIndex,
                         fieldName);
+
+                mxArray *subMat = (fieldNum < 0) ? NULL :
+                    mxGetFieldByNumber(
+                        valueMat,
+                        valueMatElementIdx,
+                        fieldNum);
                 
                 uint8_T elNumDims =
                     rtwCAPI_GetNumDims(
@@ -627,11 +778,12 @@ rt_GetStructLeafInfo(
                     elNumElems == 0)
                 {
                     /* this field is either not a struct, or is a 1x1 struct array */
-                    rt_GetStructLeafInfo(
+                    rt_GetStructLeafInfoFromElement(
                         elDTypeMapIdx, 
                         elFixPtIdx,
                         (unsigned char *) baseAddr+elOffset,
                         subMat,
+                        0,
                         modelParam,
                         paramStructure,
                         paramInfoIndex,
@@ -644,24 +796,17 @@ rt_GetStructLeafInfo(
                     size_t arrayIdx;
                     for (arrayIdx=0; arrayIdx < numArrayElements; ++arrayIdx)
                     {
-                        mxArray* subMatElement =
-                            NULL;
-                        
                         uint16_T elStructSize  =
                             rtwCAPI_GetDataTypeSize(
                                 dTypeMap,
                                 elDTypeMapIdx);
                         
-                        rt_CopyStructFromStructArray(
-                            subMat,
-                            &subMatElement,
-                            arrayIdx);
-                        
-                        rt_GetStructLeafInfo(
+                        rt_GetStructLeafInfoFromElement(
                             elDTypeMapIdx, 
                             elFixPtIdx, 
                             (unsigned char *)localBaseAddr+elOffset,
-                            subMatElement,
+                            subMat,
+                            arrayIdx,
                             modelParam,
                             paramStructure,
                             paramInfoIndex,
@@ -672,8 +817,10 @@ rt_GetStructLeafInfo(
                 }
             }
         }
+
+        free(fieldIndex.buckets);
     }
-} /* end rt_GetStructLeafInfo */
+} /* end rt_GetStructLeafInfoFromElement */
 
 
 
@@ -780,18 +927,12 @@ rt_GetInfoFromOneStructParam(
                      loopIdx < numArrayElements;
                      loopIdx++)
                 {
-                    mxArray* valueMatElement = NULL;
-                
-                    rt_CopyStructFromStructArray(
-                        valueMat,
-                        &valueMatElement, 
-                        loopIdx);
-
-                    rt_GetStructLeafInfo(
+                    rt_GetStructLeafInfoFromElement(
                         dTypeMapIdx, 
                         fixPtIdx,
                         localBaseAddr,
-                        valueMatElement,
+                        valueMat,
+                        loopIdx,
                         modelParam,
                         paramStructure,
                         paramInfoIndex,
@@ -884,61 +1025,28 @@ rt_PrepareToCreateParamInfosForStructParam(
 
 
 
-/* Function: rt_ReadParamStructMatFile=======================================
+/* Function: ReadParamStructCell =============================================
  * Abstract:
- *  Reads a matfile containing a new parameter structure.  It also reads the
- *  model checksum and compares this with the RTW generated code's checksum
- *  before inserting the new parameter structure.
+ *  Fill paramStructure from parameter set cellParamIndex of the parameter
+ *  variable pa read from the parameter MAT-file, comparing the model
+ *  checksum with the RTW generated code's checksum. The parameter data is
+ *  "stolen" from pa. On error the caller frees paramStructure.
  *
  * Returns:
  *	NULL    : success
  *	non-NULL: error string
  */
-const char *
-rt_ReadParamStructMatFile(
-    PrmStructData **prmStructOut,
+static const char *
+ReadParamStructCell(
+    const mxArray *pa,
     const SimStruct * S,
-    int cellParamIndex)
+    int cellParamIndex,
+    PrmStructData *paramStructure)
 {
     size_t nTrans = 0;
-    MATFile *pmat = NULL;
-    mxArray *pa = NULL;
     const mxArray *paParamStructs = NULL;
-    PrmStructData *paramStructure = NULL;
     const char *result = NULL; /* assume success */
 
-    paramStructure = &gblPrmStruct;
-
-    /**************************************************************************
-     * Open parameter MAT-file, read checksum, swap rtP data for type Double *
-     **************************************************************************/
-
-    if ((pmat=matOpen(gblParamFilename,"r")) == NULL)
-    {
-        result = "could not find MAT-file containing new parameter data";
-        goto EXIT_POINT;
-    }
-
-    /*
-     * Read the param variable. The variable name must be passed in
-     * from the generated code.
-     */
-    if ((pa=matGetNextVariable(pmat,NULL)) == NULL )
-    {
-        result = "error reading RTP from MAT-file "
-            "(matGetNextVariable)";
-        goto EXIT_POINT;
-    }
-
-    /* Should be 1x1 structure */
-    if (!mxIsStruct(pa) ||
-        mxGetM(pa) != 1 ||
-        mxGetN(pa) != 1 )
-    {
-        result = "RTP must be a 1x1 structure";
-        goto EXIT_POINT;
-    }
-
     /* look for modelChecksum field */
     {
         const double  *newChecksum;
@@ -1158,6 +1266,72 @@ rt_ReadParamStructMatFile(
         }
     } 
 
+EXIT_POINT:
+    return(result);
+} /* end ReadParamStructCell */
+
+
+/* Function: ReadParamStructCells ============================================
+ * Abstract:
+ *  Reads parameter sets firstCellIndex, ..., firstCellIndex+numCells-1 of the
+ *  parameter MAT-file into paramStructures, opening and reading the file
+ *  once. On error all of paramStructures are freed.
+ *
+ * Returns:
+ *	NULL    : success
+ *	non-NULL: error string
+ */
+static const char *
+ReadParamStructCells(
+    const SimStruct * S,
+    int firstCellIndex,
+    int numCells,
+    PrmStructData *paramStructures)
+{
+    MATFile *pmat = NULL;
+    mxArray *pa = NULL;
+    const char *result = NULL; /* assume success */
+    int i;
+
+    /**************************************************************************
+     * Open parameter MAT-file, read checksum, swap rtP data for type Double *
+     **************************************************************************/
+
+    if ((pmat=matOpen(gblParamFilename,"r")) == NULL)
+    {
+        result = "could not find MAT-file containing new parameter data";
+        goto EXIT_POINT;
+    }
+
+    /*
+     * Read the param variable. The variable name must be passed in
+     * from the generated code.
+     */
+    if ((pa=matGetNextVariable(pmat,NULL)) == NULL )
+    {
+        result = "error reading RTP from MAT-file "
+            "(matGetNextVariable)";
+        goto EXIT_POINT;
+    }
+
+    /* Should be 1x1 structure */
+    if (!mxIsStruct(pa) ||
+        mxGetM(pa) != 1 ||
+        mxGetN(pa) != 1 )
+    {
+        result = "RTP must be a 1x1 structure";
+        goto EXIT_POINT;
+    }
+
+    for (i=0; i<numCells && result == NULL; i++)
+    {
+        result = ReadParamStructCell(
+            pa,
+            S,
+            firstCellIndex+i,
+            &paramStructures[i]);
+    }
+
 EXIT_POINT:
     mxDestroyArray(pa);
 
@@ -1168,11 +1342,42 @@ EXIT_POINT:
 
     if (result != NULL)
     {
-        rt_FreeParamStructs(paramStructure);
-        paramStructure = NULL;
+        for (i=0; i<numCells; i++)
+        {
+            rt_FreeParamStructs(&paramStructures[i]);
+        }
     }
     
-    *prmStructOut = paramStructure;
+    return(result);
+} /* end ReadParamStructCells */
+
+
+/* Function: rt_ReadParamStructMatFile=======================================
+ * Abstract:
+ *  Reads a matfile containing a new parameter structure.  It also reads the
+ *  model checksum and compares this with the RTW generated code's checksum
+ *  before inserting the new parameter structure.
+ *
+ * Returns:
+ *	NULL    : success
+ *	non-NULL: error string
+ */
+const char *
+rt_ReadParamStructMatFile(
+    PrmStructData **prmStructOut,
+    const SimStruct * S,
+    int cellParamIndex)
+{
+    PrmStructData *paramStructure = &gblPrmStruct;
+    const char *result = NULL;
+
+    result = ReadParamStructCells(
+        S,
+        cellParamIndex,
+        1,
+        paramStructure);
+    
+    *prmStructOut = (result == NULL) ? paramStructure : NULL;
     return(result);
 } /* end rt_ReadParamStructMatFile */
 
@@ -1340,6 +1545,8 @@ rt_RapidReadMatFileAndUpdateParams(const SimStruct *S)
     if (gblParamFilename == NULL)
         goto EXIT_POINT;
 
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_PARAM_LOAD);
+
     /* checksum comparison is performed in rt_ReadParamStructMatFile */
     result = rt_ReadParamStructMatFile(
         &paramStructure,
@@ -1363,6 +1570,8 @@ rt_RapidReadMatFileAndUpdateParams(const SimStruct *S)
         rt_FreeParamStructs(paramStructure);
     }
 
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_PARAM_LOAD);
+
     if (result)
     {
         ssSetErrorStatus(S, result);
@@ -1373,6 +1582,124 @@ rt_RapidReadMatFileAndUpdateParams(const SimStruct *S)
 } /* rt_RapidReadMatFileAndUpdateParams */
 
 
+/* Parameter sets of a parameter sweep, see rt_RapidReadParamSweepMatFile */
+static PrmStructData *gblPrmSweep = NULL;
+static int_T gblPrmSweepFirstCell = 0;
+static int_T gblPrmSweepNumCells = 0;
+
+
+/* Function: rt_RapidReadParamSweepMatFile ====================================
+ * Abstract:
+ *  Read parameter sets firstCellIndex, ..., firstCellIndex+numCells-1 of the
+ *  parameter MAT-file, opening and parsing the file once for all of them.
+ *  rt_RapidUpdateParamsFromSweep then installs one of the sets in rtP, e.g.,
+ *  in a worker process of rt_RapidRunParamSweep, and
+ *  rt_RapidFreeParamSweep releases them.
+ *
+ * Returns:
+ *	NULL    : success
+ *	non-NULL: error string
+ */
+const char *
+rt_RapidReadParamSweepMatFile(
+    const SimStruct *S,
+    int_T firstCellIndex,
+    int_T numCells)
+{
+    const char* result = NULL;
+
+    rt_RapidFreeParamSweep();
+    if (gblParamFilename == NULL || numCells <= 0)
+        goto EXIT_POINT;
+
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_PARAM_LOAD);
+
+    gblPrmSweep =
+        (PrmStructData *) calloc(numCells, sizeof(PrmStructData));
+    if (gblPrmSweep == NULL)
+    {
+        result = "Memory allocation error";
+        goto EXIT_POINT;
+    }
+    gblPrmSweepFirstCell = firstCellIndex;
+    gblPrmSweepNumCells = numCells;
+
+    /* checksum comparison is performed in ReadParamStructCell */
+    result = ReadParamStructCells(
+        S,
+        firstCellIndex,
+        numCells,
+        gblPrmSweep);
+
+  EXIT_POINT:
+    if (result != NULL)
+    {
+        rt_RapidFreeParamSweep();
+    }
+
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_PARAM_LOAD);
+
+    return(result);
+
+} /* rt_RapidReadParamSweepMatFile */
+
+
+/* Function: rt_RapidUpdateParamsFromSweep ====================================
+ * Abstract:
+ *  Install parameter set cellIndex, read by rt_RapidReadParamSweepMatFile,
+ *  in rtP. Sets the error status of S on failure.
+ */
+void
+rt_RapidUpdateParamsFromSweep(const SimStruct *S, int_T cellIndex)
+{
+    const char* result = NULL;
+
+    if (gblPrmSweep == NULL ||
+        cellIndex < gblPrmSweepFirstCell ||
+        cellIndex >= gblPrmSweepFirstCell + gblPrmSweepNumCells)
+    {
+        result = "Invalid index into parameter cell array";
+        goto EXIT_POINT;
+    }
+
+    result = ReplaceRtP(
+        S,
+        &gblPrmSweep[cellIndex - gblPrmSweepFirstCell]);
+
+  EXIT_POINT:
+    if (result)
+    {
+        ssSetErrorStatus(S, result);
+    }
+    
+    return;
+
+} /* rt_RapidUpdateParamsFromSweep */
+
+
+/* Function: rt_RapidFreeParamSweep ===========================================
+ * Abstract:
+ *  Release the parameter sets read by rt_RapidReadParamSweepMatFile.
+ */
+void
+rt_RapidFreeParamSweep(void)
+{
+    if (gblPrmSweep != NULL)
+    {
+        int_T i;
+        for (i=0; i<gblPrmSweepNumCells; i++)
+        {
+            rt_FreeParamStructs(&gblPrmSweep[i]);
+        }
+        free(gblPrmSweep);
+        gblPrmSweep = NULL;
+    }
+    gblPrmSweepFirstCell = 0;
+    gblPrmSweepNumCells = 0;
+
+} /* rt_RapidFreeParamSweep */
+
+
 void rt_ssGetBlockPath(SimStruct* S, int_T sysIdx, int_T blkIdx, char_T **path) {
     (void)(S);
     if (!gblBlockPathDB)
@@ -95,6 +95,14 @@
 
     extern void rt_RapidReadMatFileAndUpdateParams(const SimStruct *S);
 
+    extern const char *rt_RapidReadParamSweepMatFile(const SimStruct *S,
+                                                     int_T firstCellIndex,
+                                                     int_T numCells);
+
+    extern void rt_RapidUpdateParamsFromSweep(const SimStruct *S, int_T cellIndex);
+
+    extern void rt_RapidFreeParamSweep(void);
+
     extern void rt_ssGetBlockPath(SimStruct* S, int_T sysIdx, int_T blkIdx, char_T **path);
     extern void rt_ssSet_slErrMsg(SimStruct*, void *);
     extern void rt_ssReportDiagnosticAsWarning(SimStruct*, void *);
@@ -78,55 +78,25 @@ void rt_FreeParamStructs(PrmStructData *paramStructure)
     }
 } /* end rt_FreeParamStructs */
 
-/* Function: rt_ReadParamStructMatFile=======================================
+/* Function: ReadParamStructCell =============================================
  * Abstract:
- *  Reads a matfile containing a new parameter structure.  It also reads the
- *  model checksum and compares this with the RTW generated code's checksum
- *  before inserting the new parameter structure.
+ *  Fill paramStructure from parameter set cellParamIndex of the parameter
+ *  variable pa read from the parameter MAT-file. The parameter data is
+ *  "stolen" from pa. On error the caller frees paramStructure.
  *
  * Returns:
  *	NULL    : success
  *	non-NULL: error string
  */
-const char *rt_ReadParamStructMatFile(PrmStructData **prmStructOut,
-                                         int           cellParamIndex)
+static const char *ReadParamStructCell(const mxArray *pa,
+                                       int           cellParamIndex,
+                                       PrmStructData *paramStructure)
 {
     size_t nTrans;
     size_t i;
-    MATFile       *pmat              = NULL;
-    mxArray       *pa                = NULL;
     const mxArray *paParamStructs    = NULL;
-    PrmStructData *paramStructure    = NULL;
     const char    *result            = NULL; /* assume success */
 
-    paramStructure = &gblPrmStruct;
-
-    /**************************************************************************
-     * Open parameter MAT-file, read checksum, swap rtP data for type Double *
-     **************************************************************************/
-
-    if ((pmat=matOpen(gblParamFilename,"r")) == NULL) {
-        result = "could not find MAT-file containing new parameter data";
-        goto EXIT_POINT;
-    }
-
-    /*
-     * Read the param variable. The variable name must be passed in
-     * from the generated code.
-     */
-    if ((pa=matGetNextVariable(pmat,NULL)) == NULL ) {
-        result = "error reading new parameter data from MAT-file "
-            "(matGetNextVariable)";
-        goto EXIT_POINT;
-    }
-
-    /* Should be 1x1 structure */
-    if (!mxIsStruct(pa) ||
-        mxGetM(pa) != 1 || mxGetN(pa) != 1 ) {
-        result = "parameter variables must be a 1x1 structure";
-        goto EXIT_POINT;
-    }
-
     /* look for modelChecksum field */
     {
         const double  *newChecksum;
@@ -296,6 +266,60 @@ const char *rt_ReadParamStructMatFile(PrmStructData **prmStructOut,
         paramStructure->numParams += dtprmInfo->nEls;
     }
 
+EXIT_POINT:
+    return(result);
+} /* end ReadParamStructCell */
+
+
+/* Function: ReadParamStructCells ============================================
+ * Abstract:
+ *  Reads parameter sets firstCellIndex, ..., firstCellIndex+numCells-1 of the
+ *  parameter MAT-file into paramStructures, opening and reading the file
+ *  once. On error all of paramStructures are freed.
+ *
+ * Returns:
+ *	NULL    : success
+ *	non-NULL: error string
+ */
+static const char *ReadParamStructCells(int           firstCellIndex,
+                                        int           numCells,
+                                        PrmStructData *paramStructures)
+{
+    MATFile       *pmat              = NULL;
+    mxArray       *pa                = NULL;
+    const char    *result            = NULL; /* assume success */
+    int           i;
+
+    /**************************************************************************
+     * Open parameter MAT-file, read checksum, swap rtP data for type Double *
+     **************************************************************************/
+
+    if ((pmat=matOpen(gblParamFilename,"r")) == NULL) {
+        result = "could not find MAT-file containing new parameter data";
+        goto EXIT_POINT;
+    }
+
+    /*
+     * Read the param variable. The variable name must be passed in
+     * from the generated code.
+     */
+    if ((pa=matGetNextVariable(pmat,NULL)) == NULL ) {
+        result = "error reading new parameter data from MAT-file "
+            "(matGetNextVariable)";
+        goto EXIT_POINT;
+    }
+
+    /* Should be 1x1 structure */
+    if (!mxIsStruct(pa) ||
+        mxGetM(pa) != 1 || mxGetN(pa) != 1 ) {
+        result = "parameter variables must be a 1x1 structure";
+        goto EXIT_POINT;
+    }
+
+    for (i=0; i<numCells && result == NULL; i++) {
+        result = ReadParamStructCell(pa, firstCellIndex+i, &paramStructures[i]);
+    }
+
 EXIT_POINT:
     mxDestroyArray(pa);
 
@@ -304,10 +328,32 @@ EXIT_POINT:
     }
 
     if (result != NULL) {
-        rt_FreeParamStructs(paramStructure);
-        paramStructure = NULL;
+        for (i=0; i<numCells; i++) {
+            rt_FreeParamStructs(&paramStructures[i]);
+        }
     }
-    *prmStructOut = paramStructure;
+    return(result);
+} /* end ReadParamStructCells */
+
+
+/* Function: rt_ReadParamStructMatFile=======================================
+ * Abstract:
+ *  Reads a matfile containing a new parameter structure.  It also reads the
+ *  model checksum and compares this with the RTW generated code's checksum
+ *  before inserting the new parameter structure.
+ *
+ * Returns:
+ *	NULL    : success
+ *	non-NULL: error string
+ */
+const char *rt_ReadParamStructMatFile(PrmStructData **prmStructOut,
+                                         int           cellParamIndex)
+{
+    PrmStructData *paramStructure    = &gblPrmStruct;
+    const char    *result;
+
+    result = ReadParamStructCells(cellParamIndex, 1, paramStructure);
+    *prmStructOut = (result == NULL) ? paramStructure : NULL;
     return(result);
 } /* end rt_ReadParamStructMatFile */
 
@@ -405,6 +451,8 @@ void rt_RapidReadMatFileAndUpdateParams(const SimStruct *S)
 
     if (gblParamFilename == NULL) goto EXIT_POINT;
 
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_PARAM_LOAD);
+
     result = rt_ReadParamStructMatFile(&paramStructure, gblParamCellIndex);
     if (result != NULL) goto EXIT_POINT;
 
@@ -426,12 +474,119 @@ void rt_RapidReadMatFileAndUpdateParams(const SimStruct *S)
     if (paramStructure != NULL) {
         rt_FreeParamStructs(paramStructure);
     }
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_PARAM_LOAD);
     if (result) ssSetErrorStatus(S, result);
     return;
 
 } /* rt_RapidReadMatFileAndUpdateParams */
 
 
+/* Parameter sets of a parameter sweep, see rt_RapidReadParamSweepMatFile */
+static PrmStructData *gblPrmSweep          = NULL;
+static int_T         gblPrmSweepFirstCell = 0;
+static int_T         gblPrmSweepNumCells  = 0;
+
+
+/* Function: rt_RapidReadParamSweepMatFile ====================================
+ * Abstract:
+ *  Read parameter sets firstCellIndex, ..., firstCellIndex+numCells-1 of the
+ *  parameter MAT-file, opening and parsing the file once for all of them.
+ *  rt_RapidUpdateParamsFromSweep then installs one of the sets in rtP, e.g.,
+ *  in a worker process of rt_RapidRunParamSweep, and
+ *  rt_RapidFreeParamSweep releases them.
+ *
+ * Returns:
+ *	NULL    : success
+ *	non-NULL: error string
+ */
+const char *rt_RapidReadParamSweepMatFile(const SimStruct *S,
+                                          int_T           firstCellIndex,
+                                          int_T           numCells)
+{
+    const char *result = NULL;
+
+    rt_RapidFreeParamSweep();
+    if (gblParamFilename == NULL || numCells <= 0) goto EXIT_POINT;
+
+    rt_RapidStartupPhaseBegin(RT_RAPID_STARTUP_PARAM_LOAD);
+
+    gblPrmSweep = (PrmStructData *)calloc(numCells, sizeof(PrmStructData));
+    if (gblPrmSweep == NULL) {
+        result = "Memory allocation error";
+        goto EXIT_POINT;
+    }
+    gblPrmSweepFirstCell = firstCellIndex;
+    gblPrmSweepNumCells  = numCells;
+
+    result = ReadParamStructCells(firstCellIndex, numCells, gblPrmSweep);
+    if (result != NULL) goto EXIT_POINT;
+
+    /* be sure checksums all match; all sets come from the same variable */
+    if (gblPrmSweep[0].checksum[0] != ssGetChecksum0(S) ||
+        gblPrmSweep[0].checksum[1] != ssGetChecksum1(S) ||
+        gblPrmSweep[0].checksum[2] != ssGetChecksum2(S) ||
+        gblPrmSweep[0].checksum[3] != ssGetChecksum3(S) ) {
+        result = "model checksum mismatch - incorrect parameter data "
+            "specified";
+        goto EXIT_POINT;
+    }
+
+  EXIT_POINT:
+    if (result != NULL) {
+        rt_RapidFreeParamSweep();
+    }
+    rt_RapidStartupPhaseEnd(RT_RAPID_STARTUP_PARAM_LOAD);
+    return(result);
+
+} /* rt_RapidReadParamSweepMatFile */
+
+
+/* Function: rt_RapidUpdateParamsFromSweep ====================================
+ * Abstract:
+ *  Install parameter set cellIndex, read by rt_RapidReadParamSweepMatFile,
+ *  in rtP. Sets the error status of S on failure.
+ */
+void rt_RapidUpdateParamsFromSweep(const SimStruct *S, int_T cellIndex)
+{
+    const char *result = NULL;
+
+    if (gblPrmSweep == NULL ||
+        cellIndex < gblPrmSweepFirstCell ||
+        cellIndex >= gblPrmSweepFirstCell + gblPrmSweepNumCells) {
+        result = "Invalid index into parameter cell array";
+        goto EXIT_POINT;
+    }
+
+    result = ReplaceRtP(S, &gblPrmSweep[cellIndex - gblPrmSweepFirstCell]);
+
+  EXIT_POINT:
+    if (result) ssSetErrorStatus(S, result);
+    return;
+
+} /* rt_RapidUpdateParamsFromSweep */
+
+
+/* Function: rt_RapidFreeParamSweep ===========================================
+ * Abstract:
+ *  Release the parameter sets read by rt_RapidReadParamSweepMatFile.
+ */
+void rt_RapidFreeParamSweep(void)
+{
+    int_T i;
+
+    if (gblPrmSweep != NULL) {
+        for (i=0; i<gblPrmSweepNumCells; i++) {
+            rt_FreeParamStructs(&gblPrmSweep[i]);
+        }
+        free(gblPrmSweep);
+        gblPrmSweep = NULL;
+    }
+    gblPrmSweepFirstCell = 0;
+    gblPrmSweepNumCells  = 0;
+
+} /* rt_RapidFreeParamSweep */
+
+
 
 
 /* EOF rsim_utils.c */
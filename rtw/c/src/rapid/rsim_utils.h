@@ -51,6 +51,14 @@ typedef struct {
 
 extern void rt_RapidReadMatFileAndUpdateParams(const SimStruct *S);
 
+extern const char *rt_RapidReadParamSweepMatFile(const SimStruct *S,
+                                                 int_T           firstCellIndex,
+                                                 int_T           numCells);
+
+extern void rt_RapidUpdateParamsFromSweep(const SimStruct *S, int_T cellIndex);
+
+extern void rt_RapidFreeParamSweep(void);
+
  
 
 
@@ -33,6 +33,7 @@
 #include "rt_mxclassid.h"
 #endif
 #include "rtw_matlogging.h"
+#include "rt_snapshot.h"
 
 #ifndef TMW_NAME_LENGTH_MAX
 #define TMW_NAME_LENGTH_MAX 64
@@ -3850,6 +3851,86 @@ void rt_UpdateStructLogVar(StructLogVar *var, const real_T *t, const void *data)
 } /* end rt_UpdateStructLogVar */
 
 
+/* Function: rt_SnapshotLogVar ================================================
+ * Abstract:
+ *      Add the write cursors (rowIdx through numHits) and the buffers of one
+ *      log variable to a snapshot.
+ */
+static const char_T *rt_SnapshotLogVar(LogVar *var, rtSnapshot *snap)
+{
+    const char_T *errStr;
+    size_t       nBytes = (size_t)var->data.nRows * var->data.nCols *
+                          var->data.elSize;
+
+    errStr = rt_SnapshotAddRegion(snap, var->data.name, &var->rowIdx,
+                                  offsetof(LogVar, numHits) + sizeof(int_T) -
+                                  offsetof(LogVar, rowIdx));
+    if (errStr == NULL) {
+        errStr = rt_SnapshotAddRegion(snap, var->data.name, var->data.re,
+                                      nBytes);
+    }
+    if (errStr == NULL && var->data.complex) {
+        errStr = rt_SnapshotAddRegion(snap, var->data.name, var->data.im,
+                                      nBytes);
+    }
+    if (errStr == NULL && var->valDims != NULL &&
+        var->valDims->dimsData != NULL) {
+        errStr = rt_SnapshotAddRegion(snap, var->valDims->name,
+                                      var->valDims->dimsData,
+                                      (size_t)var->valDims->nRows *
+                                      var->valDims->nCols * sizeof(real_T));
+    }
+    return(errStr);
+
+} /* end rt_SnapshotLogVar */
+
+
+/* Function: rt_SnapshotDataLogging ============================================
+ * Abstract:
+ *      Add the state of data logging to a model snapshot (see rt_snapshot.h),
+ *      so that a restored model appends to the data logged before the
+ *      snapshot instead of overwriting it. For each log variable this is the
+ *      write cursor (row index, wrap count and decimation count) and the
+ *      buffer contents up to its current size.
+ *
+ *      The regions point to the current buffers. A buffer that may be
+ *      reallocated (okayToRealloc) moves as it grows, so add the regions
+ *      again right before saving. A snapshot saved after such a buffer grew
+ *      cannot be loaded, since a new process starts with the initial size.
+ *
+ * Returns:
+ *      NULL     - success
+ *      non-NULL - error string
+ */
+const char_T *rt_SnapshotDataLogging(RTWLogInfo *li, struct rtSnapshot_Tag *snap)
+{
+    LogInfo      *logInfo = (LogInfo*) rtliGetLogInfo(li);
+    const char_T *errStr  = NULL;
+    LogVar       *var;
+    StructLogVar *svar;
+
+    if (logInfo == NULL) return(NULL); /* logging was not started */
+
+    for (var = logInfo->logVarsList; var != NULL && errStr == NULL;
+         var = var->next) {
+        errStr = rt_SnapshotLogVar(var, snap);
+    }
+
+    for (svar = logInfo->structLogVarsList; svar != NULL && errStr == NULL;
+         svar = svar->next) {
+        if (svar->logTime) {
+            errStr = rt_SnapshotLogVar((LogVar *)svar->time, snap);
+        }
+        for (var = svar->signals.values; var != NULL && errStr == NULL;
+             var = var->next) {
+            errStr = rt_SnapshotLogVar(var, snap);
+        }
+    }
+    return(errStr);
+
+} /* end rt_SnapshotDataLogging */
+
+
 #ifdef __cplusplus
 }
 #endif
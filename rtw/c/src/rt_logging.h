@@ -265,6 +265,10 @@ extern void rt_UpdateStructLogVar(StructLogVar *var, const real_T *t, const void
 extern const char_T *rt_UpdateTXYLogVars(RTWLogInfo *li, time_T *tPtr);
 extern const char_T *rt_UpdateTXXFYLogVars(RTWLogInfo *li, time_T *tPtr, boolean_T updateTXY);
 
+struct rtSnapshot_Tag; /* see rt_snapshot.h */
+extern const char_T *rt_SnapshotDataLogging(RTWLogInfo            *li,
+                                            struct rtSnapshot_Tag *snap);
+
 extern void rt_StopDataLoggingImpl(const char_T *file, RTWLogInfo *li, boolean_T isRaccel);
 
 extern void rt_StopDataLogging(const char_T *file, RTWLogInfo *li);
@@ -280,6 +284,7 @@ extern void rt_StopDataLogging(const char_T *file, RTWLogInfo *li);
 #define rt_StartDataLogging(li, finalTime, stepSize, errStatus) NULL /* do nothing */
 #define rt_UpdateTXYLogVars(li, tPtr) NULL /* do nothing */
 #define rt_StopDataLogging(file, li); /* do nothing */
+#define rt_SnapshotDataLogging(li, snap) NULL /* do nothing */
 
 #endif /*!defined(MAT_FILE) || (defined(MAT_FILE) && MAT_FILE == 1)*/
 
@@ -22,6 +22,7 @@
 # include "simstruc.h"
 #endif
 #include "rt_sim.h"
+#include "rt_snapshot.h"
 
 /*==========*
  * Struct's *
@@ -260,6 +261,54 @@ void rt_SimDestroyTimingEngine(void *rtmTimingData)
 
 #endif /* RT_MALLOC */
 
+/* Function: rt_SimSnapshotTimingEngine ========================================
+ * Abstract:
+ *      Add the timing engine counters to a model snapshot (see
+ *      rt_snapshot.h). Task periods and offsets do not change after
+ *      rt_SimInitTimingEngine and are not part of the snapshot. With
+ *      USE_RTMODEL the counters live in the RT_MODEL and nothing is added.
+ *
+ * Returns:
+ *      NULL     - success
+ *      non-NULL - error string
+ */
+const char *rt_SimSnapshotTimingEngine(int_T                 rtmNumSampTimes,
+                                       void                  *rtmTimingData,
+                                       struct rtSnapshot_Tag *snap)
+{
+#ifdef USE_RTMODEL
+
+    UNUSED_PARAMETER(rtmNumSampTimes);
+    UNUSED_PARAMETER(rtmTimingData);
+    UNUSED_PARAMETER(snap);
+    return(NULL);
+
+#else /* must be !USE_RTMODEL */
+
+    const char *errStr;
+#ifdef RT_MALLOC
+    TimingData *td;
+    td = (TimingData *)rtmTimingData;
+#else
+    TimingData *td;
+    UNUSED_PARAMETER(rtmTimingData);
+    td = &td_struct;
+    rtmNumSampTimes = NUMST;
+#endif
+
+    errStr = rt_SnapshotAddRegion(snap, "TimingEngine.clockTick",
+                                  td->clockTick,
+                                  rtmNumSampTimes*sizeof(real_T));
+    if (errStr == NULL) {
+        errStr = rt_SnapshotAddRegion(snap, "TimingEngine.taskTick",
+                                      td->taskTick,
+                                      rtmNumSampTimes*sizeof(int_T));
+    }
+    return(errStr);
+
+#endif /* !USE_RTMODEL */
+} /* end rt_SimSnapshotTimingEngine */
+
 #if !defined(MULTITASKING)
 
 /*###########################################################################*/
@@ -549,6 +598,33 @@ const char *rt_InitTimingEngine(SimStruct *S)
     return(retVal);
 }
 
+const char *rt_SnapshotTimingEngine(SimStruct *S, struct rtSnapshot_Tag *snap)
+{
+    int_T      numst  = ssGetNumSampleTimes(S);
+    const char *errStr = rt_SimSnapshotTimingEngine(numst,
+                                                    ssGetTimingData(S),
+                                                    snap);
+
+    /* Task times and sample hits carry over to the next step */
+    if (errStr == NULL) {
+        errStr = rt_SnapshotAddRegion(snap, "SimStruct.t", ssGetTPtr(S),
+                                      numst*sizeof(time_T));
+    }
+    if (errStr == NULL) {
+        errStr = rt_SnapshotAddRegion(snap, "SimStruct.sampleHits",
+                                      ssGetSampleHitPtr(S),
+                                      numst*sizeof(int_T));
+    }
+# if defined(MULTITASKING)
+    if (errStr == NULL) {
+        errStr = rt_SnapshotAddRegion(snap, "SimStruct.perTaskSampleHits",
+                                      ssGetPerTaskSampleHitsPtr(S),
+                                      numst*numst*sizeof(int_T));
+    }
+# endif
+    return(errStr);
+}
+
 # if !defined(MULTITASKING)
 void rt_UpdateDiscreteTaskSampleHits(SimStruct *S)
 {
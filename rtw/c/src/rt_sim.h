@@ -36,6 +36,11 @@ extern const char *rt_SimInitTimingEngine(int_T       rtmNumSampTimes,
 extern void rt_SimDestroyTimingEngine(void *rtmTimingData);
 #endif
 
+struct rtSnapshot_Tag; /* see rt_snapshot.h */
+extern const char *rt_SimSnapshotTimingEngine(int_T                 rtmNumSampTimes,
+                                              void                  *rtmTimingData,
+                                              struct rtSnapshot_Tag *snap);
+
 #if !defined(MULTITASKING)
   extern void  rt_SimUpdateDiscreteTaskSampleHits(int_T  rtmNumSampTimes,
                                                   void   *rtmTimingData,
@@ -64,6 +69,8 @@ extern void rt_SimDestroyTimingEngine(void *rtmTimingData);
  */
 #ifndef USE_RTMODEL
   extern const char *rt_InitTimingEngine(SimStruct *S);
+  extern const char *rt_SnapshotTimingEngine(SimStruct *S,
+                                             struct rtSnapshot_Tag *snap);
 # ifdef RT_MALLOC
     extern void   rt_DestroyTimingEngine(SimStruct *S);
 # endif
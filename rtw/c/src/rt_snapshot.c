@@ -0,0 +1,267 @@
+/* Copyright 2019 The MathWorks, Inc. */
+
+/*
+ * File: rt_snapshot.c
+ *
+ * Abstract:
+ *   Save and restore the state of a model, see rt_snapshot.h.
+ *
+ *   File layout (native byte order):
+ *
+ *     char      magic[8]        "RTSNAP01"
+ *     uint32_T  byteOrder       0x01020304
+ *     uint32_T  numRegions
+ *     numRegions times:
+ *       uint32_T  nameLength
+ *       char      name[nameLength]
+ *       uint32_T  nBytes (low 32 bits)
+ *       uint32_T  nBytes (high 32 bits)
+ *       uint8_T   data[nBytes]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rt_snapshot.h"
+
+#define SNAPSHOT_MAGIC      "RTSNAP01"
+#define SNAPSHOT_MAGIC_LEN  8
+#define SNAPSHOT_BYTE_ORDER 0x01020304U
+
+static const char_T rtSnapshotOpenError[]  = "unable to open snapshot file";
+static const char_T rtSnapshotWriteError[] = "unable to write snapshot file";
+static const char_T rtSnapshotReadError[]  = "snapshot file is truncated or "
+                                             "is not a snapshot file";
+static const char_T rtSnapshotMismatch[]   = "snapshot file was not written by "
+                                             "this model";
+static const char_T rtMemAllocError[]      = "Memory allocation error";
+
+/*==================*
+ * Local functions  *
+ *==================*/
+
+static int_T rt_SnapshotWriteUint32(FILE *fp, uint32_T value)
+{
+    return(fwrite(&value, sizeof(uint32_T), 1, fp) == 1);
+}
+
+static int_T rt_SnapshotReadUint32(FILE *fp, uint32_T *value)
+{
+    return(fread(value, sizeof(uint32_T), 1, fp) == 1);
+}
+
+/* Split a size into two 32 bit halves without shifting a 32 bit size_t by 32 */
+static uint32_T rt_SnapshotSizeHigh(size_t nBytes)
+{
+    return((uint32_T)((nBytes >> 16) >> 16));
+}
+
+/*===================*
+ * Visible functions *
+ *===================*/
+
+/* Function: rt_SnapshotInit ===================================================
+ * Abstract:
+ *      Start an empty list of snapshot regions.
+ */
+void rt_SnapshotInit(rtSnapshot *snap)
+{
+    snap->numRegions = 0;
+} /* end rt_SnapshotInit */
+
+
+/* Function: rt_SnapshotAddRegion ==============================================
+ * Abstract:
+ *      Add a memory region to the snapshot. The name identifies the region
+ *      in the snapshot file and must stay valid as long as the snapshot is
+ *      used. Empty regions are ignored.
+ *
+ * Returns:
+ *      NULL     - success
+ *      non-NULL - error string
+ */
+const char_T *rt_SnapshotAddRegion(rtSnapshot   *snap,
+                                   const char_T *name,
+                                   void         *data,
+                                   size_t       nBytes)
+{
+    rtSnapshotRegion *region;
+
+    if (nBytes == 0) {
+        return(NULL);
+    }
+    if (snap->numRegions >= RT_SNAPSHOT_MAX_REGIONS) {
+        return("too many snapshot regions, increase RT_SNAPSHOT_MAX_REGIONS");
+    }
+
+    region         = &snap->regions[snap->numRegions++];
+    region->name   = name;
+    region->data   = data;
+    region->nBytes = nBytes;
+    return(NULL);
+} /* end rt_SnapshotAddRegion */
+
+
+/* Function: rt_SnapshotSave ===================================================
+ * Abstract:
+ *      Write the current contents of all snapshot regions to fileName.
+ *
+ * Returns:
+ *      NULL     - success
+ *      non-NULL - error string
+ */
+const char_T *rt_SnapshotSave(const rtSnapshot *snap,
+                              const char_T     *fileName)
+{
+    const char_T *errStr = NULL;
+    FILE         *fp;
+    int_T        i;
+
+    if ((fp = fopen(fileName, "wb")) == NULL) {
+        return(rtSnapshotOpenError);
+    }
+
+    if (fwrite(SNAPSHOT_MAGIC, 1, SNAPSHOT_MAGIC_LEN, fp) != SNAPSHOT_MAGIC_LEN ||
+        !rt_SnapshotWriteUint32(fp, SNAPSHOT_BYTE_ORDER) ||
+        !rt_SnapshotWriteUint32(fp, (uint32_T)snap->numRegions)) {
+        errStr = rtSnapshotWriteError;
+        goto EXIT_POINT;
+    }
+
+    for (i = 0; i < snap->numRegions; i++) {
+        const rtSnapshotRegion *region  = &snap->regions[i];
+        size_t                 nameLen = strlen(region->name);
+
+        if (!rt_SnapshotWriteUint32(fp, (uint32_T)nameLen) ||
+            fwrite(region->name, 1, nameLen, fp) != nameLen ||
+            !rt_SnapshotWriteUint32(fp, (uint32_T)region->nBytes) ||
+            !rt_SnapshotWriteUint32(fp, rt_SnapshotSizeHigh(region->nBytes)) ||
+            fwrite(region->data, 1, region->nBytes, fp) != region->nBytes) {
+            errStr = rtSnapshotWriteError;
+            goto EXIT_POINT;
+        }
+    }
+
+  EXIT_POINT:
+    if (fclose(fp) != 0 && errStr == NULL) {
+        errStr = rtSnapshotWriteError;
+    }
+    return(errStr);
+} /* end rt_SnapshotSave */
+
+
+/* Function: rt_SnapshotLoad ===================================================
+ * Abstract:
+ *      Restore all snapshot regions from fileName. The whole file is read
+ *      and checked against the registered regions before any region is
+ *      written, so the model is left unchanged if loading fails.
+ *
+ * Returns:
+ *      NULL     - success
+ *      non-NULL - error string
+ */
+const char_T *rt_SnapshotLoad(const rtSnapshot *snap,
+                              const char_T     *fileName)
+{
+    const char_T *errStr  = NULL;
+    FILE         *fp;
+    char_T       magic[SNAPSHOT_MAGIC_LEN];
+    char_T       *name    = NULL;
+    uint8_T      *staging = NULL;
+    size_t       total    = 0;
+    size_t       offset;
+    uint32_T     value;
+    int_T        i;
+
+    if ((fp = fopen(fileName, "rb")) == NULL) {
+        return(rtSnapshotOpenError);
+    }
+
+    for (i = 0; i < snap->numRegions; i++) {
+        total += snap->regions[i].nBytes;
+    }
+    if (total > 0 && (staging = (uint8_T *)malloc(total)) == NULL) {
+        errStr = rtMemAllocError;
+        goto EXIT_POINT;
+    }
+
+    if (fread(magic, 1, SNAPSHOT_MAGIC_LEN, fp) != SNAPSHOT_MAGIC_LEN ||
+        memcmp(magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_LEN) != 0 ||
+        !rt_SnapshotReadUint32(fp, &value) || value != SNAPSHOT_BYTE_ORDER) {
+        errStr = rtSnapshotReadError;
+        goto EXIT_POINT;
+    }
+    if (!rt_SnapshotReadUint32(fp, &value)) {
+        errStr = rtSnapshotReadError;
+        goto EXIT_POINT;
+    }
+    if (value != (uint32_T)snap->numRegions) {
+        errStr = rtSnapshotMismatch;
+        goto EXIT_POINT;
+    }
+
+    for (i = 0, offset = 0; i < snap->numRegions; i++) {
+        const rtSnapshotRegion *region  = &snap->regions[i];
+        size_t                 nameLen = strlen(region->name);
+        uint32_T               nBytesLow, nBytesHigh;
+
+        if (!rt_SnapshotReadUint32(fp, &value)) {
+            errStr = rtSnapshotReadError;
+            goto EXIT_POINT;
+        }
+        if (value != (uint32_T)nameLen) {
+            errStr = rtSnapshotMismatch;
+            goto EXIT_POINT;
+        }
+
+        if ((name = (char_T *)malloc(nameLen+1)) == NULL) {
+            errStr = rtMemAllocError;
+            goto EXIT_POINT;
+        }
+        if (fread(name, 1, nameLen, fp) != nameLen ||
+            !rt_SnapshotReadUint32(fp, &nBytesLow) ||
+            !rt_SnapshotReadUint32(fp, &nBytesHigh)) {
+            errStr = rtSnapshotReadError;
+            goto EXIT_POINT;
+        }
+        if (memcmp(name, region->name, nameLen) != 0 ||
+            nBytesLow  != (uint32_T)region->nBytes ||
+            nBytesHigh != rt_SnapshotSizeHigh(region->nBytes)) {
+            errStr = rtSnapshotMismatch;
+            goto EXIT_POINT;
+        }
+        free(name);
+        name = NULL;
+
+        if (fread(staging+offset, 1, region->nBytes, fp) != region->nBytes) {
+            errStr = rtSnapshotReadError;
+            goto EXIT_POINT;
+        }
+        offset += region->nBytes;
+    }
+
+    /* Trailing data means the file belongs to a different model */
+    if (fgetc(fp) != EOF) {
+        errStr = rtSnapshotMismatch;
+        goto EXIT_POINT;
+    }
+
+    for (i = 0, offset = 0; i < snap->numRegions; i++) {
+        (void)memcpy(snap->regions[i].data, staging+offset,
+                     snap->regions[i].nBytes);
+        offset += snap->regions[i].nBytes;
+    }
+
+  EXIT_POINT:
+    if (name != NULL) {
+        free(name);
+    }
+    if (staging != NULL) {
+        free(staging);
+    }
+    (void)fclose(fp);
+    return(errStr);
+} /* end rt_SnapshotLoad */
+
+/* [EOF] rt_snapshot.c */
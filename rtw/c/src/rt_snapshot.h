@@ -0,0 +1,67 @@
+/* Copyright 2019 The MathWorks, Inc. */
+
+/*
+ * File: rt_snapshot.h
+ *
+ * Abstract:
+ *   Save the state of a running model to a binary file and restore it, so
+ *   that a simulation can resume from a checkpoint instead of from model
+ *   initialization.
+ *
+ *   A snapshot is a list of named memory regions. The main registers the
+ *   regions that carry state from one step to the next, e.g., continuous
+ *   states, DWork, zero-crossing signals, the timing engine counters
+ *   (rt_SimSnapshotTimingEngine) and the solver history
+ *   (rt_ODESnapshotIntegrationData). Regions are saved and restored byte for
+ *   byte, so a restored model continues bit-exactly. Regions must not hold
+ *   pointers, since the addresses of a new process may differ.
+ *
+ *   A snapshot file can only be loaded into the executable that wrote it:
+ *   the region names, order and sizes must all match.
+ */
+
+#ifndef rt_snapshot_h
+#define rt_snapshot_h
+
+#include <stddef.h>                     /* size_t */
+#include "tmwtypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RT_SNAPSHOT_MAX_REGIONS
+#define RT_SNAPSHOT_MAX_REGIONS 64
+#endif
+
+typedef struct rtSnapshotRegion_Tag {
+    const char_T *name;
+    void         *data;
+    size_t       nBytes;
+} rtSnapshotRegion;
+
+typedef struct rtSnapshot_Tag {
+    int_T            numRegions;
+    rtSnapshotRegion regions[RT_SNAPSHOT_MAX_REGIONS];
+} rtSnapshot;
+
+extern void rt_SnapshotInit(rtSnapshot *snap);
+
+extern const char_T *rt_SnapshotAddRegion(rtSnapshot   *snap,
+                                          const char_T *name,
+                                          void         *data,
+                                          size_t       nBytes);
+
+extern const char_T *rt_SnapshotSave(const rtSnapshot *snap,
+                                     const char_T     *fileName);
+
+extern const char_T *rt_SnapshotLoad(const rtSnapshot *snap,
+                                     const char_T     *fileName);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* rt_snapshot_h */
+
+/* [EOF] rt_snapshot.h */
@@ -0,0 +1,245 @@
+/* Copyright 2019 The MathWorks, Inc. */
+
+/*
+ * File: rt_workerpool.c
+ *
+ * Abstract:
+ *   Persistent worker pool shared by the matrix library and Akima
+ *   interpolation, see rt_workerpool.h.
+ *
+ *   The caller of rt_WorkerPoolRun posts the start semaphore of one worker
+ *   per chunk, processes the last chunk itself and then waits on the done
+ *   semaphore once per worker.
+ */
+
+#include "rt_workerpool.h"
+
+#ifdef RT_WORKERPOOL_MT
+
+#include <pthread.h>
+#include <semaphore.h>
+
+typedef struct rtWorker_Tag {
+    pthread_t thread;
+    sem_t     startSema;
+    int_T     chunkIdx;
+} rtWorker;
+
+typedef struct rtWorkerPool_Tag {
+    int_T            numUsers;     /* libraries attached to the pool */
+    int_T            numThreads;   /* including the calling thread */
+    boolean_T        shutdown;
+    sem_t            doneSema;
+
+    /* current job */
+    rt_WorkerPoolFcn fcn;
+    void             *args;
+    int_T            numChunks;
+
+    rtWorker         workers[RT_WORKERPOOL_MAX_THREADS-1];
+} rtWorkerPool;
+
+static rtWorkerPool gWorkerPool;
+
+/* Serializes rt_WorkerPoolInit and rt_WorkerPoolTerminate */
+static pthread_mutex_t gWorkerPoolLifeMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Held for the duration of a split call */
+static pthread_mutex_t gWorkerPoolBusyMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void *WorkerPoolTask(void *arg)
+{
+    rtWorker     *worker = (rtWorker *)arg;
+    rtWorkerPool *pool   = &gWorkerPool;
+
+    for (;;) {
+        (void)sem_wait(&worker->startSema);
+        if (pool->shutdown) break;
+        pool->fcn(pool->args, worker->chunkIdx, pool->numChunks);
+        (void)sem_post(&pool->doneSema);
+    }
+    return NULL;
+}
+
+/* Function: WorkerPoolStart ===================================================
+ * Abstract:
+ *      Create numThreads-1 worker threads. Returns the number of threads in
+ *      use, including the caller; 1 if no worker could be created.
+ */
+static int_T WorkerPoolStart(rtWorkerPool *pool, int_T numThreads)
+{
+    int_T i;
+
+    pool->shutdown = false;
+    (void)sem_init(&pool->doneSema, 0, 0);
+
+    for (i = 0; i < numThreads-1; i++) {
+        rtWorker *worker = &pool->workers[i];
+        (void)sem_init(&worker->startSema, 0, 0);
+        if (pthread_create(&worker->thread, NULL,
+                           WorkerPoolTask, worker) != 0) {
+            (void)sem_destroy(&worker->startSema);
+            break;
+        }
+    }
+    pool->numThreads = i+1;
+
+    /* No worker could be created: nothing will post or wait on doneSema */
+    if (pool->numThreads <= 1) {
+        (void)sem_destroy(&pool->doneSema);
+    }
+    return pool->numThreads;
+}
+
+/* Function: WorkerPoolStop ====================================================
+ * Abstract:
+ *      Stop and join the worker threads, waiting for a split call in
+ *      progress to finish first.
+ */
+static void WorkerPoolStop(rtWorkerPool *pool)
+{
+    int_T i;
+
+    (void)pthread_mutex_lock(&gWorkerPoolBusyMutex);
+    pool->shutdown = true;
+    for (i = 0; i < pool->numThreads-1; i++) {
+        (void)sem_post(&pool->workers[i].startSema);
+    }
+    for (i = 0; i < pool->numThreads-1; i++) {
+        (void)pthread_join(pool->workers[i].thread, NULL);
+        (void)sem_destroy(&pool->workers[i].startSema);
+    }
+    pool->numThreads = 1;
+    (void)pthread_mutex_unlock(&gWorkerPoolBusyMutex);
+
+    (void)sem_destroy(&pool->doneSema);
+}
+
+/* Function: rt_WorkerPoolInit =================================================
+ * Abstract:
+ *      Attach a library to the pool. numThreads is the total number of
+ *      threads the library wants to take part in a split call, including the
+ *      caller. The threads are created by the first attach with
+ *      numThreads > 1; later attaches share them. Returns the number of
+ *      threads in the pool (1 when it runs serially).
+ */
+int_T rt_WorkerPoolInit(int_T numThreads)
+{
+    rtWorkerPool *pool = &gWorkerPool;
+    int_T        result;
+
+    if (numThreads > RT_WORKERPOOL_MAX_THREADS) {
+        numThreads = RT_WORKERPOOL_MAX_THREADS;
+    }
+
+    (void)pthread_mutex_lock(&gWorkerPoolLifeMutex);
+    pool->numUsers++;
+    if (pool->numThreads <= 1 && numThreads > 1) {
+        (void)WorkerPoolStart(pool, numThreads);
+    }
+    result = (pool->numThreads > 1) ? pool->numThreads : 1;
+    (void)pthread_mutex_unlock(&gWorkerPoolLifeMutex);
+
+    return result;
+}
+
+/* Function: rt_WorkerPoolTerminate ============================================
+ * Abstract:
+ *      Detach a library from the pool. The last detach stops the worker
+ *      threads; subsequent calls run serially.
+ */
+void rt_WorkerPoolTerminate(void)
+{
+    rtWorkerPool *pool = &gWorkerPool;
+
+    (void)pthread_mutex_lock(&gWorkerPoolLifeMutex);
+    if (pool->numUsers > 0 && --pool->numUsers == 0 && pool->numThreads > 1) {
+        WorkerPoolStop(pool);
+    }
+    (void)pthread_mutex_unlock(&gWorkerPoolLifeMutex);
+}
+
+int_T rt_WorkerPoolGetNumThreads(void)
+{
+    return (gWorkerPool.numThreads > 1) ? gWorkerPool.numThreads : 1;
+}
+
+/* Function: rt_WorkerPoolRun ==================================================
+ * Abstract:
+ *      Run fcn on min(numChunks, pool size) chunks and wait for all of them.
+ *      The calling thread takes the last chunk. Returns false, without
+ *      calling fcn, when the pool has no workers or is in use by another
+ *      call; the caller then runs serially.
+ */
+boolean_T rt_WorkerPoolRun(rt_WorkerPoolFcn fcn,
+                           void             *args,
+                           int_T            numChunks)
+{
+    rtWorkerPool *pool = &gWorkerPool;
+    int_T        i;
+
+    if (pool->numThreads <= 1 || numChunks < 2) {
+        return false;
+    }
+
+    /* Pool is in use (nested or concurrent call): run serially */
+    if (pthread_mutex_trylock(&gWorkerPoolBusyMutex) != 0) {
+        return false;
+    }
+    if (pool->numThreads <= 1) {
+        (void)pthread_mutex_unlock(&gWorkerPoolBusyMutex);
+        return false;
+    }
+
+    if (numChunks > pool->numThreads) {
+        numChunks = pool->numThreads;
+    }
+    pool->fcn       = fcn;
+    pool->args      = args;
+    pool->numChunks = numChunks;
+
+    for (i = 0; i < numChunks-1; i++) {
+        pool->workers[i].chunkIdx = i;
+        (void)sem_post(&pool->workers[i].startSema);
+    }
+
+    fcn(args, numChunks-1, numChunks);
+
+    for (i = 0; i < numChunks-1; i++) {
+        (void)sem_wait(&pool->doneSema);
+    }
+
+    (void)pthread_mutex_unlock(&gWorkerPoolBusyMutex);
+    return true;
+}
+
+#else /* RT_WORKERPOOL_MT */
+
+int_T rt_WorkerPoolInit(int_T numThreads)
+{
+    (void)numThreads;
+    return 1;
+}
+
+void rt_WorkerPoolTerminate(void)
+{
+}
+
+int_T rt_WorkerPoolGetNumThreads(void)
+{
+    return 1;
+}
+
+boolean_T rt_WorkerPoolRun(rt_WorkerPoolFcn fcn,
+                           void             *args,
+                           int_T            numChunks)
+{
+    (void)fcn;
+    (void)args;
+    (void)numChunks;
+    return false;
+}
+
+#endif /* RT_WORKERPOOL_MT */
+
+/* [EOF] rt_workerpool.c */
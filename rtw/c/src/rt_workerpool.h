@@ -0,0 +1,63 @@
+/* Copyright 2019 The MathWorks, Inc. */
+
+/*
+ * File: rt_workerpool.h
+ *
+ * Abstract:
+ *   Persistent worker pool shared by the multithreaded matrix library
+ *   (rt_matrixlib_mt.c) and Akima interpolation (akimaThreadPool.c), so
+ *   that both split their work across one set of threads.
+ *
+ *   Each library attaches to the pool with rt_WorkerPoolInit and detaches
+ *   with rt_WorkerPoolTerminate. The threads are created by the first
+ *   attach that asks for more than one thread and joined by the last
+ *   detach; the pool does not grow afterwards. A call is only split when
+ *   no other split call is in progress, otherwise rt_WorkerPoolRun returns
+ *   false and the caller runs serially. Calls made from a worker therefore
+ *   always run serially.
+ *
+ *   The threads are only available when RT_MATRIXLIB_MT or MFL_INTERP_MT
+ *   is defined (POSIX threads). Otherwise rt_WorkerPoolInit returns 1 and
+ *   rt_WorkerPoolRun always returns false.
+ */
+
+#ifndef rt_workerpool_h
+#define rt_workerpool_h
+
+#include "rtwtypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(RT_MATRIXLIB_MT) || defined(MFL_INTERP_MT)
+#define RT_WORKERPOOL_MT
+#endif
+
+/* Upper bound on the pool size (including the calling thread) */
+#ifndef RT_WORKERPOOL_MAX_THREADS
+#define RT_WORKERPOOL_MAX_THREADS (64)
+#endif
+
+/* Processes chunk chunkIdx (0 <= chunkIdx < numChunks) of a split call */
+typedef void (*rt_WorkerPoolFcn)(void  *args,
+                                 int_T chunkIdx,
+                                 int_T numChunks);
+
+extern int_T rt_WorkerPoolInit(int_T numThreads);
+
+extern void rt_WorkerPoolTerminate(void);
+
+extern int_T rt_WorkerPoolGetNumThreads(void);
+
+extern boolean_T rt_WorkerPoolRun(rt_WorkerPoolFcn fcn,
+                                  void             *args,
+                                  int_T            numChunks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* rt_workerpool_h */
+
+/* [EOF] rt_workerpool.h */